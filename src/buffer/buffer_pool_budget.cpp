@@ -0,0 +1,76 @@
+#include "buffer/buffer_pool_budget.h"
+
+#include <algorithm>
+
+// weight of the latest round in the moving average of a pool's load
+static const double LOAD_DECAY = 0.5;
+
+// a pool is only resized if its target moves by more than this fraction of the budget
+static const size_t RESIZE_THRESHOLD_FRACTION = 32;
+
+BufferPoolBudget::BufferPoolBudget(size_t total_frames, std::chrono::milliseconds interval)
+    : total_frames_(total_frames), interval_(interval), last_rebalance_(std::chrono::steady_clock::now()) {}
+
+size_t BufferPoolBudget::GetInitialFrames(size_t min_frames) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  return std::max(min_frames, total_frames_ / (pools_.size() + 1));
+}
+
+void BufferPoolBudget::Register(BufferPoolManager *bpm, size_t min_frames) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  size_t accesses = bpm->GetHitCount() + bpm->GetMissCount();
+  pools_.push_back({bpm, min_frames, accesses, 0});
+  RebalanceLocked();
+}
+
+void BufferPoolBudget::Unregister(BufferPoolManager *bpm) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  pools_.erase(std::remove_if(pools_.begin(), pools_.end(), [&](const Pool &pool) { return pool.bpm_ == bpm; }),
+               pools_.end());
+  RebalanceLocked();
+}
+
+bool BufferPoolBudget::Rebalance(bool force) {
+  std::scoped_lock<std::mutex> lock(latch_);
+  if (!force && std::chrono::steady_clock::now() - last_rebalance_ < interval_) return false;
+  RebalanceLocked();
+  return true;
+}
+
+void BufferPoolBudget::RebalanceLocked() {
+  last_rebalance_ = std::chrono::steady_clock::now();
+  if (pools_.empty()) return;
+  // 每个pool先拿到最小值，剩下的按最近的访问量分
+  size_t reserved = 0;
+  double total_load = 0;
+  for (auto &pool : pools_) {
+    size_t accesses = pool.bpm_->GetHitCount() + pool.bpm_->GetMissCount();
+    pool.load_ = LOAD_DECAY * (accesses - pool.last_accesses_) + (1 - LOAD_DECAY) * pool.load_;
+    pool.last_accesses_ = accesses;
+    reserved += pool.min_frames_;
+    total_load += pool.load_;
+  }
+  size_t spare = total_frames_ > reserved ? total_frames_ - reserved : 0;
+  std::vector<size_t> targets;
+  for (auto &pool : pools_) {
+    double share = total_load > 0 ? pool.load_ / total_load : 1.0 / pools_.size();
+    size_t target = pool.min_frames_ + static_cast<size_t>(spare * share);
+    targets.push_back(target);
+  }
+  // 先缩小再扩大，扩大时只用还没分出去的frame，任何时候都不超过预算
+  size_t threshold = total_frames_ / RESIZE_THRESHOLD_FRACTION;
+  size_t used = 0;
+  for (size_t i = 0; i < pools_.size(); i++) {
+    size_t pool_size = pools_[i].bpm_->GetPoolSize();
+    if (targets[i] + threshold < pool_size) pool_size = pools_[i].bpm_->Resize(targets[i]);
+    used += pool_size;
+  }
+  for (size_t i = 0; i < pools_.size() && used < total_frames_; i++) {
+    size_t pool_size = pools_[i].bpm_->GetPoolSize();
+    if (targets[i] <= pool_size + threshold) continue;
+    size_t grant = std::min(targets[i], pool_size + total_frames_ - used);
+    // pool只按初始大小创建，分到更多frame时再放开上限
+    if (grant > pools_[i].bpm_->GetMaxPoolSize()) pools_[i].bpm_->SetMaxPoolSize(grant);
+    used += pools_[i].bpm_->Resize(grant) - pool_size;
+  }
+}
@@ -1,154 +1,137 @@
 #include "buffer/buffer_pool_manager.h"
 
+#include <fstream>
+
 #include "glog/logging.h"
-#include "page/bitmap_page.h"
 
-static const char EMPTY_PAGE_DATA[PAGE_SIZE] = {0};
+// read-ahead requests beyond this many are dropped, the scan has outrun the helper anyway
+static const size_t MAX_PENDING_READ_AHEADS = 16;
 
-BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager)
-    : pool_size_(pool_size), disk_manager_(disk_manager) {
-  pages_ = new Page[pool_size_];
-  replacer_ = new LRUReplacer(pool_size_);
-  for (size_t i = 0; i < pool_size_; i++) {
-    free_list_.emplace_back(i);
-  }
-}
+// first word of a warm start file
+static const uint32_t WARM_START_MAGIC = 0x4d51574d;
+
+BufferPoolManager::BufferPoolManager(DiskManager *disk_manager) : disk_manager_(disk_manager) {}
 
 BufferPoolManager::~BufferPoolManager() {
-  for (auto page : page_table_) {
-    FlushPage(page.first);
+  // 子类析构时应该已经停掉了，这里只是兜底
+  StopReadAhead();
+  StopBackgroundWriter();
+}
+
+void BufferPoolManager::StartBackgroundWriter(size_t clean_target, std::chrono::milliseconds interval) {
+  StopBackgroundWriter();
+  bg_writer_stop_ = false;
+  bg_writer_ = std::thread(&BufferPoolManager::BackgroundWriterLoop, this, clean_target, interval);
+}
+
+void BufferPoolManager::StopBackgroundWriter() {
+  if (!bg_writer_.joinable()) return;
+  {
+    std::scoped_lock<std::mutex> lock(bg_writer_latch_);
+    bg_writer_stop_ = true;
   }
-  delete[] pages_;
-  delete replacer_;
+  bg_writer_cv_.notify_all();
+  bg_writer_.join();
 }
 
-/**
- * TODO: Student Implement
- */
-Page *BufferPoolManager::FetchPage(page_id_t page_id) {
-  // 1.     Search the page table for the requested page (P).
-  // 1.1    If P exists, pin it and return it immediately.
-  // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
-  //        Note that pages are always found from the free list first.
-  // 2.     If R is dirty, write it back to the disk.
-  // 3.     Delete R from the page table and insert P.
-  // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
-  if(this->page_table_.find(page_id)!=page_table_.end()){
-    frame_id_t P=page_table_[page_id];
-    this->replacer_->Pin(P);//从replacer中删除
-    pages_[P].pin_count_++;
-    return pages_+P;
+void BufferPoolManager::BackgroundWriterLoop(size_t clean_target, std::chrono::milliseconds interval) {
+  std::unique_lock<std::mutex> lock(bg_writer_latch_);
+  while (!bg_writer_stop_) {
+    lock.unlock();
+    BackgroundWriterStep(clean_target);
+    lock.lock();
+    bg_writer_cv_.wait_for(lock, interval, [&] { return bg_writer_stop_; });
   }
-  else{
-    frame_id_t R;
-    if(this->free_list_.size()>0){//先从free_list里面找
-      R=free_list_.front();
-      free_list_.pop_front();
-    }else if(this->replacer_->Victim(&R)){}
-    else return nullptr;
-    if(pages_[R].IsDirty()) //dirty的话写进磁盘
-      disk_manager_->WritePage(pages_[R].page_id_,pages_[R].GetData());
-    page_table_.erase(page_id);
-    page_table_.insert(pair<page_id_t ,frame_id_t>(page_id,R));
-//    pages_[R].ResetMemory();//没必要
-    pages_[R].page_id_=page_id;
-    pages_[R].pin_count_=1;
-    pages_[R].is_dirty_=false;
-    disk_manager_->ReadPage(page_id,pages_[R].GetData());
-    replacer_->Pin(R);//从replacer之中删除,好像没有必要
-    return pages_+R;
+}
+
+void BufferPoolManager::ReadAhead(page_id_t page_id, NextPageFn next_page, size_t count) {
+  std::scoped_lock<std::mutex> lock(read_ahead_latch_);
+  if (read_ahead_stop_ || read_ahead_queue_.size() >= MAX_PENDING_READ_AHEADS) return;
+  if (!read_ahead_thread_.joinable()) {
+    read_ahead_thread_ = std::thread(&BufferPoolManager::ReadAheadLoop, this);
   }
+  read_ahead_queue_.push_back({page_id, next_page, count});
+  read_ahead_cv_.notify_one();
 }
 
-/**
- * TODO: Student Implement
- */
-Page *BufferPoolManager::NewPage(page_id_t &page_id) {
-  // 0.   Make sure you call AllocatePage!
-  // 1.   If all the pages in the buffer pool are pinned, return nullptr.
-  // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
-  // 3.   Update P's metadata, zero out memory and add P to the page table.
-  // 4.   Set the page ID output parameter. Return a pointer to P.
-  frame_id_t P;
-  if(free_list_.size()>0){
-    page_id=AllocatePage();
-    if(page_id!=INVALID_PAGE_ID){
-      P=free_list_.front();
-      free_list_.pop_front();
-    }else return nullptr;//磁盘空间不足，申请失败
-  }else if(replacer_->Size()>0){
-    page_id=this->AllocatePage();
-    if(page_id!=INVALID_PAGE_ID)
-      replacer_->Victim(&P);
-    else return nullptr;//磁盘空间不足，申请失败
-  }else return nullptr;//buffer pool的全被Pinned，申请失败
-  if(pages_[P].is_dirty_) this->disk_manager_->WritePage(pages_[P].page_id_,pages_[P].GetData());
-  page_table_.erase(pages_[P].page_id_);//从表中删除
-  page_table_.insert(pair<page_id_t,frame_id_t>(page_id,P));
-  pages_[P].ResetMemory();
-  pages_[P].is_dirty_=false;
-  pages_[P].pin_count_=1;
-  pages_[P].page_id_=page_id;
-  replacer_->Pin(P);//从replacer之中删除,可能没有必要
-  return pages_+P;
+void BufferPoolManager::StopReadAhead() {
+  {
+    std::scoped_lock<std::mutex> lock(read_ahead_latch_);
+    read_ahead_stop_ = true;
+    read_ahead_queue_.clear();
+  }
+  read_ahead_cv_.notify_all();
+  if (read_ahead_thread_.joinable()) read_ahead_thread_.join();
 }
 
-/**
- * TODO: Student Implement
- */
-bool BufferPoolManager::DeletePage(page_id_t page_id) {
-  // 0.   Make sure you call DeallocatePage!
-  // 1.   Search the page table for the requested page (P).
-  // 1.   If P does not exist, return true.
-  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
-  // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
-  if (this->page_table_.find(page_id) == page_table_.end()) {
-    // 内存中没找到
-    this->DeallocatePage(page_id);
-    return true;
-  } else {
-    frame_id_t P = page_table_[page_id];
-    if (pages_[P].pin_count_ > 0)
-      return false;  // 有人在使用
-    else {
-//      this->DeletePage(page_id);  // 从磁盘中清除
-      this->DeallocatePage(page_id);
-      pages_[P].ResetMemory();    // 内存中清除
-      pages_->is_dirty_ = false;
-      this->replacer_->Pin(P);     // 从replacer中清除
-      page_table_.erase(page_id);  // 在table中清除
-      free_list_.push_back(P);     // 添加到free_list
-      return true;
+void BufferPoolManager::ReadAheadLoop() {
+  std::unique_lock<std::mutex> lock(read_ahead_latch_);
+  while (true) {
+    read_ahead_cv_.wait(lock, [&] { return read_ahead_stop_ || !read_ahead_queue_.empty(); });
+    if (read_ahead_stop_) return;
+    ReadAheadRequest request = read_ahead_queue_.front();
+    read_ahead_queue_.pop_front();
+    lock.unlock();
+    // 从当前页开始顺着链往后读，当前页一般已经在内存里
+    page_id_t page_id = request.page_id_;
+    Page *page = FetchPage(page_id);
+    for (size_t i = 0; page != nullptr && i < request.count_; i++) {
+      page->RLatch();
+      page_id_t next_page_id = request.next_page_(page);
+      page->RUnlatch();
+      UnpinPage(page_id, false);
+      page = nullptr;
+      if (next_page_id == INVALID_PAGE_ID) break;
+      page_id = next_page_id;
+      page = FetchPage(page_id, &read_ahead_ring_);
     }
+    if (page != nullptr) UnpinPage(page_id, false);
+    lock.lock();
   }
 }
 
-/**
- * TODO: Student Implement
- */
-bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
-  if(this->page_table_.find(page_id)==page_table_.end()) return false;//内存中没有这个page
-  frame_id_t P=page_table_[page_id];
-  pages_[P].is_dirty_|=is_dirty;
-  if((--pages_[P].pin_count_)==0) replacer_->Unpin(P);
-  return true;
+size_t BufferPoolManager::EnableWarmStart(const std::string &file_name) {
+  warm_start_file_ = file_name;
+  return LoadResidentPages(file_name);
 }
 
-/**
- * TODO: Student Implement
- */
-bool BufferPoolManager::FlushPage(page_id_t page_id) {
-  if(page_table_.find(page_id)==page_table_.end()) return false;//内存中没有这页
-  frame_id_t P=page_table_[page_id];
-  if(pages_[P].is_dirty_) {
-    pages_[P].is_dirty_=false;//更新dirty
-    disk_manager_->WritePage(pages_[P].page_id_, pages_[P].GetData());
+bool BufferPoolManager::SaveResidentPages(const std::string &file_name) {
+  std::vector<page_id_t> page_ids = GetResidentPages();
+  std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    LOG(WARNING) << "Can not write warm start file " << file_name << std::endl;
+    return false;
+  }
+  uint32_t count = page_ids.size();
+  out.write(reinterpret_cast<const char *>(&WARM_START_MAGIC), sizeof(uint32_t));
+  out.write(reinterpret_cast<const char *>(&count), sizeof(uint32_t));
+  out.write(reinterpret_cast<const char *>(page_ids.data()), count * sizeof(page_id_t));
+  return out.good();
+}
+
+size_t BufferPoolManager::LoadResidentPages(const std::string &file_name) {
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in.is_open()) return 0;
+  uint32_t magic = 0;
+  uint32_t count = 0;
+  in.read(reinterpret_cast<char *>(&magic), sizeof(uint32_t));
+  in.read(reinterpret_cast<char *>(&count), sizeof(uint32_t));
+  if (!in.good() || magic != WARM_START_MAGIC) {
+    LOG(WARNING) << "Ignoring invalid warm start file " << file_name << std::endl;
+    return 0;
+  }
+  std::vector<page_id_t> page_ids(count);
+  in.read(reinterpret_cast<char *>(page_ids.data()), count * sizeof(page_id_t));
+  if (!in.good()) {
+    LOG(WARNING) << "Ignoring truncated warm start file " << file_name << std::endl;
+    return 0;
   }
-  return true;
+  return LoadPages(page_ids);
 }
 
-page_id_t BufferPoolManager::AllocatePage() {
-  int next_page_id = disk_manager_->AllocatePage();
+page_id_t BufferPoolManager::AllocatePage(page_id_t near_page_id) {
+  int next_page_id = near_page_id == INVALID_PAGE_ID ? disk_manager_->AllocatePage()
+                                                     : disk_manager_->AllocatePage(near_page_id);
   return next_page_id;
 }
 
@@ -158,16 +141,4 @@ void BufferPoolManager::DeallocatePage(__attribute__((unused)) page_id_t page_id
 
 bool BufferPoolManager::IsPageFree(page_id_t page_id) {
   return disk_manager_->IsPageFree(page_id);
-}
-
-// Only used for debug
-bool BufferPoolManager::CheckAllUnpinned() {
-  bool res = true;
-  for (size_t i = 0; i < pool_size_; i++) {
-    if (pages_[i].pin_count_ != 0) {
-      res = false;
-      LOG(ERROR) << "page " << pages_[i].page_id_ << " pin count:" << pages_[i].pin_count_ << endl;
-    }
-  }
-  return res;
 }
\ No newline at end of file
@@ -0,0 +1,620 @@
+#include "buffer/buffer_pool_manager_instance.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <unordered_set>
+
+#include "glog/logging.h"
+#include "page/bitmap_page.h"
+
+static const char EMPTY_PAGE_DATA[PAGE_SIZE] = {0};
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**
+ * Map a zeroed, page-aligned arena. Arenas of at least one huge page first try explicit huge pages, then fall back
+ * to normal pages with a transparent huge page hint. A resizable arena only reserves address space, memory is
+ * committed when a frame is first touched, and never uses explicit huge pages, which can not be released per frame.
+ * @param[in/out] size requested size, set to the mapped size
+ */
+static char *AllocateArena(size_t &size, bool resizable) {
+  void *arena = MAP_FAILED;
+#ifdef MAP_HUGETLB
+  if (size >= HUGE_PAGE_SIZE && !resizable) {
+    size_t huge_size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    arena = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (arena != MAP_FAILED) size = huge_size;
+  }
+#endif
+  if (arena == MAP_FAILED) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | (resizable ? MAP_NORESERVE : 0);
+    // mmap only aligns to the system page, map a bit more and trim it when database pages are larger
+    size_t system_page_size = sysconf(_SC_PAGESIZE);
+    size_t slack = PAGE_SIZE > system_page_size ? PAGE_SIZE - system_page_size : 0;
+    arena = mmap(nullptr, size + slack, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (arena == MAP_FAILED) throw std::bad_alloc();
+    if (slack > 0) {
+      auto begin = reinterpret_cast<uintptr_t>(arena);
+      uintptr_t aligned = (begin + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+      if (aligned > begin) munmap(arena, aligned - begin);
+      if (begin + slack > aligned) munmap(reinterpret_cast<char *>(aligned) + size, begin + slack - aligned);
+      arena = reinterpret_cast<void *>(aligned);
+    }
+#ifdef MADV_HUGEPAGE
+    if (size >= HUGE_PAGE_SIZE) madvise(arena, size, MADV_HUGEPAGE);
+#endif
+  }
+  return static_cast<char *>(arena);
+}
+
+BufferPoolManagerInstance::BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
+                                                     ReplacerType replacer_type, size_t max_pool_size)
+    : BufferPoolManager(disk_manager), pool_size_(pool_size), max_pool_size_(std::max(pool_size, max_pool_size)) {
+  ASSERT(pool_size_ > 0, "Buffer pool needs at least one frame.");
+  replacer_ = new PageClassReplacer(replacer_type, pool_size_);
+  AddFrames(pool_size_, max_pool_size_ > pool_size_);
+  for (size_t i = 0; i < pool_size_; i++) {
+    free_list_.emplace_back(i);
+  }
+}
+
+BufferPoolManagerInstance::~BufferPoolManagerInstance() {
+  // the helper threads call back into this instance, stop them before it goes away
+  StopReadAhead();
+  StopBackgroundWriter();
+  if (!warm_start_file_.empty()) SaveResidentPages(warm_start_file_);
+  WriteDirtyPages();
+  for (auto frame : frames_) {
+    delete frame;
+  }
+  for (auto &arena : arenas_) {
+    munmap(arena.first, arena.second);
+  }
+  delete replacer_;
+}
+
+void BufferPoolManagerInstance::AddFrames(size_t count, bool resizable) {
+  if (count == 0) return;
+  size_t size = count * PAGE_SIZE;
+  char *arena = AllocateArena(size, resizable);
+  arenas_.emplace_back(arena, size);
+  for (size_t i = 0; i < count; i++) {
+    frames_.push_back(new Page(arena + i * PAGE_SIZE));
+  }
+  replacer_->Grow(frames_.size());
+}
+
+/**
+ * TODO: Student Implement
+ */
+Page *BufferPoolManagerInstance::FetchPage(page_id_t page_id, BufferRing *ring) {
+  // 1.     Search the page table for the requested page (P).
+  // 1.1    If P exists, pin it and return it immediately.
+  // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
+  //        Note that pages are always found from the free list first.
+  // 2.     If R is dirty, write it back to the disk.
+  // 3.     Delete R from the page table and insert P.
+  // 4.     Update P's metadata, read in the page content from disk, and then return a pointer to P.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return FetchPageLocked(page_id, ring);
+}
+
+std::vector<Page *> BufferPoolManagerInstance::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<Page *> pages;
+  pages.reserve(page_ids.size());
+  std::vector<std::pair<page_id_t, char *>> reads;
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  for (auto page_id : page_ids) {
+    pages.push_back(FetchPageLocked(page_id, nullptr, &reads));
+  }
+  disk_manager_->ReadPageBatch(reads);
+  return pages;
+}
+
+Page *BufferPoolManagerInstance::FetchPageLocked(page_id_t page_id, BufferRing *ring,
+                                         std::vector<std::pair<page_id_t, char *>> *reads) {
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    frame_id_t P = it->second;
+    replacer_->Pin(P);  // 从replacer中删除
+    frames_[P]->pin_count_++;
+    hit_count_++;
+    return frames_[P];
+  }
+  frame_id_t R = ring == nullptr ? INVALID_FRAME_ID : TryToReuseRingFrame(ring);
+  if (R == INVALID_FRAME_ID) R = TryToFindFreePage();
+  if (R == INVALID_FRAME_ID) return nullptr;
+  miss_count_++;
+  if (ring != nullptr) ring->Push(page_id);
+  page_table_.emplace(page_id, R);
+  frames_[R]->page_id_ = page_id;
+  frames_[R]->pin_count_ = 1;
+  frames_[R]->is_dirty_ = false;
+  frames_[R]->page_class_ = PageClass::kHeap;
+  // 后台还没写完的话磁盘上是旧的，从内存里的副本读
+  if (!ReadUnwrittenCopy(page_id, frames_[R]) &&
+      (compressed_cache_ == nullptr || !compressed_cache_->Get(page_id, frames_[R]->GetData()))) {
+    if (reads != nullptr) {
+      reads->emplace_back(page_id, frames_[R]->GetData());  // 由调用者一起读
+    } else {
+      disk_manager_->ReadPage(page_id, frames_[R]->GetData());
+    }
+  }
+  replacer_->Pin(R);  // 记录这次访问
+  return frames_[R];
+}
+
+/**
+ * TODO: Student Implement
+ */
+Page *BufferPoolManagerInstance::NewPage(page_id_t &page_id, page_id_t near_page_id) {
+  // 0.   Make sure you call AllocatePage!
+  // 1.   If all the pages in the buffer pool are pinned, return nullptr.
+  // 2.   Pick a victim page P from either the free list or the replacer. Always pick from the free list first.
+  // 3.   Update P's metadata, zero out memory and add P to the page table.
+  // 4.   Set the page ID output parameter. Return a pointer to P.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  if (free_list_.empty() && replacer_->Size() == 0) return nullptr;  // buffer pool的全被Pinned，申请失败
+  page_id = AllocatePage(near_page_id);
+  if (page_id == INVALID_PAGE_ID) return nullptr;  // 磁盘空间不足，申请失败
+  return NewPageWithId(page_id);
+}
+
+Page *BufferPoolManagerInstance::NewPageWithId(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it != page_table_.end()) {
+    // 页释放之后预读线程还可能顺着旧的链把它读进来，这个旧frame要沿用，不然page table里留着的还是那份旧页
+    frame_id_t P = it->second;
+    frames_[P]->WLatch();  // 预读线程可能正拿着读锁读next page id
+    frames_[P]->ResetMemory();
+    frames_[P]->WUnlatch();
+    frames_[P]->is_dirty_ = false;
+    frames_[P]->pin_count_++;
+    frames_[P]->page_class_ = PageClass::kHeap;
+    replacer_->Pin(P);
+    return frames_[P];
+  }
+  frame_id_t P = TryToFindFreePage();
+  if (P == INVALID_FRAME_ID) return nullptr;
+  page_table_.emplace(page_id, P);
+  frames_[P]->ResetMemory();
+  frames_[P]->is_dirty_ = false;
+  frames_[P]->pin_count_ = 1;
+  frames_[P]->page_id_ = page_id;
+  frames_[P]->page_class_ = PageClass::kHeap;
+  replacer_->Pin(P);  // 记录这次访问
+  return frames_[P];
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::DeletePage(page_id_t page_id) {
+  // 0.   Make sure you call DeallocatePage!
+  // 1.   Search the page table for the requested page (P).
+  // 1.   If P does not exist, return true.
+  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+  // 3.   Otherwise, P can be deleted. Remove P from the page table, reset its metadata and return it to the free list.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  if (compressed_cache_ != nullptr) compressed_cache_->Erase(page_id);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) {
+    // 内存中没找到
+    DropUnwrittenCopies(page_id);
+    DeallocatePage(page_id);
+    return true;
+  }
+  frame_id_t P = it->second;
+  if (frames_[P]->pin_count_ > 0) return false;  // 有人在使用
+  DropUnwrittenCopies(page_id);
+  DeallocatePage(page_id);
+  frames_[P]->ResetMemory();  // 内存中清除
+  frames_[P]->is_dirty_ = false;
+  frames_[P]->page_id_ = INVALID_PAGE_ID;
+  replacer_->Remove(P);   // 从replacer中清除
+  page_table_.erase(it);  // 在table中清除
+  if (static_cast<size_t>(P) < pool_size_) free_list_.push_back(P);  // 添加到free_list
+  return true;
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) return false;  // 内存中没有这个page
+  frame_id_t P = it->second;
+  if (frames_[P]->pin_count_ <= 0) return false;
+  frames_[P]->is_dirty_ |= is_dirty;
+  if ((--frames_[P]->pin_count_) == 0) {
+    if (static_cast<size_t>(P) < pool_size_) {
+      replacer_->SetFrameClass(P, frames_[P]->GetPageClass());  // 调用者可能给这页打了新的标签
+      replacer_->Unpin(P);
+    } else {
+      RetireFrame(P);  // 缩小时还被pin住的frame，现在可以回收了
+    }
+  }
+  return true;
+}
+
+size_t BufferPoolManagerInstance::Resize(size_t pool_size) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  pool_size = std::max<size_t>(std::min(pool_size, max_pool_size_), 1);
+  if (pool_size > frames_.size()) AddFrames(pool_size - frames_.size(), true);  // 第一次长到这么大
+  size_t old_size = pool_size_;
+  pool_size_ = pool_size;
+  replacer_->SetCapacity(pool_size);
+  if (pool_size < old_size) {
+    free_list_.remove_if([&](frame_id_t frame_id) { return static_cast<size_t>(frame_id) >= pool_size; });
+    for (auto it = page_table_.begin(); it != page_table_.end();) {
+      frame_id_t frame_id = (it++)->second;  // RetireFrame会删掉当前项
+      if (static_cast<size_t>(frame_id) >= pool_size && frames_[frame_id]->pin_count_ == 0) RetireFrame(frame_id);
+    }
+  } else {
+    for (size_t i = old_size; i < pool_size; i++) {
+      // 还没回收的frame依然在page table里，unpin之后照常进入replacer
+      if (frames_[i]->page_id_ == INVALID_PAGE_ID) free_list_.push_back(i);
+    }
+  }
+  return pool_size_;
+}
+
+void BufferPoolManagerInstance::RetireFrame(frame_id_t frame_id) {
+  replacer_->Remove(frame_id);
+  EvictFrame(frame_id);
+  frames_[frame_id]->page_id_ = INVALID_PAGE_ID;
+  frames_[frame_id]->is_dirty_ = false;
+  madvise(frames_[frame_id]->GetData(), PAGE_SIZE, MADV_DONTNEED);  // 内存还给系统，再次使用时是全零页
+}
+
+/**
+ * TODO: Student Implement
+ */
+bool BufferPoolManagerInstance::FlushPage(page_id_t page_id) {
+  // 返回时这一页必须已经在磁盘上，后台的写要先完成；不拿着latch_等，拿到之后后台可能又开始写了
+  std::unique_lock<std::recursive_mutex> lock(latch_, std::defer_lock);
+  do {
+    if (lock.owns_lock()) lock.unlock();
+    WaitForFlush(page_id);
+    lock.lock();
+  } while (IsFlushing(page_id));
+  auto it = page_table_.find(page_id);
+  if (it == page_table_.end()) return WriteDeferredCopy(page_id);  // 内存中没有这页
+  frame_id_t P = it->second;
+  bool stale = TakeFailedFlush(page_id);
+  if (frames_[P]->is_dirty_ || stale) {
+    frames_[P]->is_dirty_ = false;  // 更新dirty
+    disk_manager_->WritePage(frames_[P]->page_id_, frames_[P]->GetData());
+  }
+  return true;
+}
+
+bool BufferPoolManagerInstance::FlushAllPages() {
+  bool written = WriteDirtyPages();
+  return disk_manager_->Sync() && written;
+}
+
+bool BufferPoolManagerInstance::WriteDirtyPages() {
+  std::unique_lock<std::recursive_mutex> lock(latch_, std::defer_lock);
+  do {
+    if (lock.owns_lock()) lock.unlock();
+    WaitForFlush(INVALID_PAGE_ID);
+    lock.lock();
+  } while (IsFlushing(INVALID_PAGE_ID));
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  CollectDirtyPages(&writes);
+  if (!disk_manager_->WritePageBatch(writes)) return false;  // 没写成功的页保持dirty，下次再写
+  MarkClean(writes);
+  return true;
+}
+
+void BufferPoolManagerInstance::CollectDirtyPages(std::vector<std::pair<page_id_t, const char *>> *writes) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  for (auto &page : page_table_) {
+    Page &frame = *frames_[page.second];
+    // 后台没写成功的也要重写，写失败时留着dirty下次再写
+    if (failed_flushes_.erase(page.first) > 0) frame.is_dirty_ = true;
+    if (!frame.is_dirty_) continue;
+    writes->emplace_back(page.first, frame.GetData());
+  }
+  for (auto it = deferred_writes_.begin(); it != deferred_writes_.end();) {
+    if (page_table_.count(it->first) > 0) {
+      it = deferred_writes_.erase(it);  // 帧里的版本更新
+    } else {
+      writes->emplace_back(it->first, it->second.get());
+      ++it;
+    }
+  }
+}
+
+void BufferPoolManagerInstance::MarkClean(const std::vector<std::pair<page_id_t, const char *>> &writes) {
+  for (auto &write : writes) {
+    auto it = page_table_.find(write.first);
+    if (it != page_table_.end() && frames_[it->second]->GetData() == write.second) {
+      frames_[it->second]->is_dirty_ = false;
+    }
+  }
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  for (auto &write : writes) {
+    auto it = deferred_writes_.find(write.first);
+    if (it != deferred_writes_.end() && it->second.get() == write.second) deferred_writes_.erase(it);
+  }
+}
+
+frame_id_t BufferPoolManagerInstance::TryToFindFreePage() {
+  frame_id_t R;
+  if (!free_list_.empty()) {  // 先从free_list里面找
+    R = free_list_.front();
+    free_list_.pop_front();
+    return R;
+  }
+  if (!replacer_->Victim(&R)) return INVALID_FRAME_ID;
+  EvictFrame(R);
+  // 写回之后是干净的，压缩后留在内存里
+  if (compressed_cache_ != nullptr) compressed_cache_->Put(frames_[R]->page_id_, frames_[R]->GetData());
+  return R;
+}
+
+frame_id_t BufferPoolManagerInstance::TryToReuseRingFrame(BufferRing *ring) {
+  auto it = page_table_.find(ring->Current());
+  if (it == page_table_.end()) return INVALID_FRAME_ID;  // 还没填满，或者已经被换出
+  frame_id_t R = it->second;
+  if (frames_[R]->pin_count_ > 0) return INVALID_FRAME_ID;  // 别人正在使用
+  replacer_->Remove(R);
+  EvictFrame(R);
+  return R;
+}
+
+void BufferPoolManagerInstance::EvictFrame(frame_id_t frame_id) {
+  Page &frame = *frames_[frame_id];
+  bool stale;
+  {
+    std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+    if (flushing_.count(frame.page_id_) > 0) {
+      // 后台正在写旧版本，这时写会被它覆盖；这一帧交给后台在它之后写，不在这里等
+      auto &copy = deferred_writes_[frame.page_id_];
+      if (copy == nullptr) copy.reset(new char[PAGE_SIZE]);
+      memcpy(copy.get(), frame.GetData(), PAGE_SIZE);
+      failed_flushes_.erase(frame.page_id_);
+      frame.is_dirty_ = false;
+      page_table_.erase(frame.page_id_);
+      return;
+    }
+    // 后台没写成功的话，这一帧就是唯一的最新版本；还没写的旧版本不用再写
+    stale = failed_flushes_.erase(frame.page_id_) > 0;
+    deferred_writes_.erase(frame.page_id_);
+  }
+  if (frame.IsDirty() || stale) {  // dirty的话写进磁盘
+    disk_manager_->WritePage(frame.page_id_, frame.GetData());
+    frame.is_dirty_ = false;
+    sync_write_count_++;
+  }
+  page_table_.erase(frame.page_id_);
+}
+
+bool BufferPoolManagerInstance::ReadUnwrittenCopy(page_id_t page_id, Page *frame) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  auto deferred = deferred_writes_.find(page_id);
+  if (deferred != deferred_writes_.end()) {
+    // 最新的版本还没轮到写，交回给这一帧，换出时再写
+    memcpy(frame->GetData(), deferred->second.get(), PAGE_SIZE);
+    frame->is_dirty_ = true;
+    deferred_writes_.erase(deferred);
+    return true;
+  }
+  auto flushing = flushing_.find(page_id);
+  if (flushing == flushing_.end()) return false;
+  // 不知道这次写能不能成功，这一帧也按dirty处理
+  memcpy(frame->GetData(), flushing->second, PAGE_SIZE);
+  frame->is_dirty_ = true;
+  return true;
+}
+
+bool BufferPoolManagerInstance::WriteDeferredCopy(page_id_t page_id) {
+  std::unique_ptr<char[]> copy;
+  {
+    std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+    auto it = deferred_writes_.find(page_id);
+    if (it == deferred_writes_.end()) return false;
+    copy = std::move(it->second);
+    deferred_writes_.erase(it);
+  }
+  disk_manager_->WritePage(page_id, copy.get());
+  return true;
+}
+
+void BufferPoolManagerInstance::DropUnwrittenCopies(page_id_t page_id) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  deferred_writes_.erase(page_id);
+  failed_flushes_.erase(page_id);
+}
+
+bool BufferPoolManagerInstance::TakeFailedFlush(page_id_t page_id) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  return failed_flushes_.erase(page_id) > 0;
+}
+
+bool BufferPoolManagerInstance::IsFlushing(page_id_t page_id) {
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  return page_id == INVALID_PAGE_ID ? !flushing_.empty() : flushing_.count(page_id) > 0;
+}
+
+void BufferPoolManagerInstance::WaitForFlush(page_id_t page_id) {
+  std::unique_lock<std::mutex> lock(flush_latch_);
+  flush_cv_.wait(lock, [&] {
+    return page_id == INVALID_PAGE_ID ? flushing_.empty() : flushing_.find(page_id) == flushing_.end();
+  });
+}
+
+std::vector<page_id_t> BufferPoolManagerInstance::GetResidentPages() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  std::vector<frame_id_t> frames;
+  replacer_->GetVictimCandidates(pool_size_, &frames);
+  std::vector<page_id_t> page_ids;
+  for (auto frame_id : frames) {
+    page_ids.push_back(frames_[frame_id]->page_id_);
+  }
+  // 被pin住的页正在使用，当作最热的
+  for (auto &entry : page_table_) {
+    if (frames_[entry.second]->pin_count_ > 0) page_ids.push_back(entry.first);
+  }
+  return page_ids;
+}
+
+size_t BufferPoolManagerInstance::LoadPages(const std::vector<page_id_t> &page_ids) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  // 跳过已经在内存里的、重复的和已经被释放的页，太多的话只保留最热的
+  std::vector<page_id_t> to_load;
+  std::unordered_set<page_id_t> seen;
+  for (auto it = page_ids.rbegin(); it != page_ids.rend() && to_load.size() < free_list_.size(); ++it) {
+    page_id_t page_id = *it;
+    if (page_id < 0 || !seen.insert(page_id).second || page_table_.count(page_id) > 0) continue;
+    if (disk_manager_->IsPageFree(page_id)) continue;
+    to_load.push_back(page_id);
+  }
+  std::reverse(to_load.begin(), to_load.end());
+  // 按page id顺序读，连续的页一次读入
+  std::vector<page_id_t> sorted(to_load);
+  std::sort(sorted.begin(), sorted.end());
+  // 对齐的缓冲区，direct I/O时可以直接读入
+  std::unique_ptr<char, decltype(&free)> buffer(
+      static_cast<char *>(aligned_alloc(PAGE_SIZE, WARM_START_BATCH_PAGES * PAGE_SIZE)), &free);
+  for (size_t begin = 0; begin < sorted.size();) {
+    size_t end = begin + 1;
+    while (end < sorted.size() && end - begin < WARM_START_BATCH_PAGES && sorted[end] == sorted[end - 1] + 1) {
+      end++;
+    }
+    disk_manager_->ReadPages(sorted[begin], end - begin, buffer.get());
+    for (size_t i = begin; i < end; i++) {
+      frame_id_t frame_id = free_list_.front();
+      free_list_.pop_front();
+      memcpy(frames_[frame_id]->GetData(), buffer.get() + (i - begin) * PAGE_SIZE, PAGE_SIZE);
+      frames_[frame_id]->page_id_ = sorted[i];
+      frames_[frame_id]->pin_count_ = 0;
+      frames_[frame_id]->is_dirty_ = false;
+      frames_[frame_id]->page_class_ = PageClass::kHeap;
+      page_table_.emplace(sorted[i], frame_id);
+      if (compressed_cache_ != nullptr) compressed_cache_->Erase(sorted[i]);
+    }
+    begin = end;
+  }
+  // 从冷到热放进replacer，恢复原来的替换顺序
+  for (auto page_id : to_load) {
+    replacer_->Unpin(page_table_[page_id]);
+  }
+  return to_load.size();
+}
+
+size_t BufferPoolManagerInstance::BackgroundWriterStep(size_t clean_target) {
+  std::vector<page_id_t> page_ids;
+  std::vector<char> data;
+  std::vector<std::unique_ptr<char[]>> deferred;  // 上一轮写的时候被换出的页，写完之前归这里
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+    for (auto it = deferred_writes_.begin(); it != deferred_writes_.end();) {
+      if (flushing_.count(it->first) > 0) {
+        ++it;
+      } else if (page_table_.count(it->first) > 0) {
+        it = deferred_writes_.erase(it);  // 这一页又读进来了，帧里的版本更新
+      } else {
+        writes.emplace_back(it->first, it->second.get());
+        deferred.push_back(std::move(it->second));
+        it = deferred_writes_.erase(it);
+      }
+    }
+    if (free_list_.size() < clean_target) {  // 空闲的frame不够
+      std::vector<frame_id_t> candidates;
+      replacer_->GetVictimCandidates(clean_target - free_list_.size(), &candidates);
+      for (auto frame_id : candidates) {
+        Page &page = *frames_[frame_id];
+        if (!page.is_dirty_ || flushing_.count(page.page_id_) > 0) continue;
+        // 复制一份再写，写的时候这个frame可以被换出或者再次修改
+        page_ids.push_back(page.page_id_);
+        data.insert(data.end(), page.GetData(), page.GetData() + PAGE_SIZE);
+        page.is_dirty_ = false;
+      }
+    }
+    for (size_t i = 0; i < page_ids.size(); i++) {
+      writes.emplace_back(page_ids[i], data.data() + i * PAGE_SIZE);
+    }
+    for (auto &write : writes) {
+      flushing_.emplace(write.first, write.second);
+    }
+  }
+  if (writes.empty()) return 0;
+  bool written = disk_manager_->WritePageBatch(writes);
+  std::scoped_lock<std::mutex> flush_lock(flush_latch_);
+  for (size_t i = 0; i < writes.size(); i++) {
+    page_id_t page_id = writes[i].first;
+    flushing_.erase(page_id);
+    // 没写成功：写的时候又换出过的话有更新的版本；换出的页放回去下一轮再写；帧已经标成干净了，由下一个写这一页的人重写
+    if (written || deferred_writes_.count(page_id) > 0) continue;
+    if (i < deferred.size()) {
+      deferred_writes_.emplace(page_id, std::move(deferred[i]));
+    } else {
+      failed_flushes_.insert(page_id);
+    }
+  }
+  background_write_count_ += writes.size();
+  flush_cv_.notify_all();
+  return writes.size();
+}
+
+size_t BufferPoolManagerInstance::GetHitCount() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return hit_count_;
+}
+
+size_t BufferPoolManagerInstance::GetMissCount() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return miss_count_;
+}
+
+size_t BufferPoolManagerInstance::GetSyncWriteCount() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return sync_write_count_;
+}
+
+size_t BufferPoolManagerInstance::GetBackgroundWriteCount() { return background_write_count_; }
+
+void BufferPoolManagerInstance::EnableCompressedCache(size_t capacity) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  compressed_cache_.reset(capacity == 0 ? nullptr : new CompressedPageCache(capacity));
+}
+
+CompressedCacheStats BufferPoolManagerInstance::GetCompressedCacheStats() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return compressed_cache_ == nullptr ? CompressedCacheStats() : compressed_cache_->GetStats();
+}
+
+size_t BufferPoolManagerInstance::GetResidentPageCount(PageClass page_class) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return replacer_->GetResidentCount(page_class);
+}
+
+size_t BufferPoolManagerInstance::GetEvictionCount(PageClass page_class) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  return replacer_->GetEvictionCount(page_class);
+}
+
+// Only used for debug
+bool BufferPoolManagerInstance::CheckAllUnpinned() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
+  bool res = true;
+  for (size_t i = 0; i < frames_.size(); i++) {
+    if (frames_[i]->pin_count_ != 0) {
+      res = false;
+      LOG(ERROR) << "page " << frames_[i]->page_id_ << " pin count:" << frames_[i]->pin_count_ << endl;
+    }
+  }
+  return res;
+}
@@ -0,0 +1,62 @@
+#include "buffer/clock_replacer.h"
+
+#include "common/macros.h"
+
+CLOCKReplacer::CLOCKReplacer(size_t num_pages)
+    : capacity(num_pages), evictable_(num_pages, false), reference_(num_pages, false) {}
+
+CLOCKReplacer::~CLOCKReplacer() = default;
+
+bool CLOCKReplacer::Victim(frame_id_t *frame_id) {
+  if (size_ == 0) return false;
+  // at most two sweeps: the first one may only clear reference bits
+  while (true) {
+    size_t frame = clock_hand_;
+    clock_hand_ = (clock_hand_ + 1) % capacity;
+    if (!evictable_[frame]) continue;
+    if (reference_[frame]) {
+      reference_[frame] = false;  // second chance
+      continue;
+    }
+    evictable_[frame] = false;
+    size_--;
+    *frame_id = static_cast<frame_id_t>(frame);
+    return true;
+  }
+}
+
+void CLOCKReplacer::Pin(frame_id_t frame_id) {
+  ASSERT(static_cast<size_t>(frame_id) < capacity, "Invalid frame id.");
+  if (evictable_[frame_id]) {
+    evictable_[frame_id] = false;
+    size_--;
+  }
+}
+
+void CLOCKReplacer::Unpin(frame_id_t frame_id) {
+  ASSERT(static_cast<size_t>(frame_id) < capacity, "Invalid frame id.");
+  if (!evictable_[frame_id]) {
+    evictable_[frame_id] = true;
+    size_++;
+  }
+  reference_[frame_id] = true;
+}
+
+void CLOCKReplacer::GetVictimCandidates(size_t count, vector<frame_id_t> *frames) {
+  // the hand takes unreferenced frames in its first sweep and the referenced ones, now cleared, in the second
+  for (bool referenced : {false, true}) {
+    for (size_t i = 0; i < capacity && frames->size() < count; i++) {
+      size_t frame = (clock_hand_ + i) % capacity;
+      if (evictable_[frame] && reference_[frame] == referenced) frames->push_back(static_cast<frame_id_t>(frame));
+    }
+  }
+}
+
+size_t CLOCKReplacer::Size() { return size_; }
+
+void CLOCKReplacer::Grow(size_t num_pages) {
+  if (num_pages <= capacity) return;
+  capacity = num_pages;
+  evictable_.resize(num_pages, false);
+  reference_.resize(num_pages, false);
+}
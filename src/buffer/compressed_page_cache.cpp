@@ -0,0 +1,52 @@
+#include "buffer/compressed_page_cache.h"
+
+#include <iterator>
+
+#include "common/lz_codec.h"
+
+bool CompressedPageCache::Put(page_id_t page_id, const char *page_data) {
+  Erase(page_id);
+  size_t size = LZCodec::Compress(page_data, PAGE_SIZE, buffer_, PAGE_SIZE - PAGE_SIZE / 8);
+  if (size == 0 || size > capacity_) {
+    stats_.rejected_++;
+    return false;
+  }
+  // 从最早放进来的开始丢，直到放得下
+  while (stats_.compressed_bytes_ + size > capacity_) {
+    EraseEntry(std::prev(entries_.end()));
+  }
+  entries_.push_front({page_id, std::string(buffer_, size)});
+  index_[page_id] = entries_.begin();
+  stats_.pages_++;
+  stats_.compressed_bytes_ += size;
+  return true;
+}
+
+bool CompressedPageCache::Get(page_id_t page_id, char *page_data) {
+  auto it = index_.find(page_id);
+  if (it == index_.end()) {
+    stats_.misses_++;
+    return false;
+  }
+  const std::string &data = it->second->data_;
+  size_t size = LZCodec::Decompress(data.data(), data.size(), page_data, PAGE_SIZE);
+  EraseEntry(it->second);
+  if (size != PAGE_SIZE) {
+    stats_.misses_++;  // 不应该发生，当作没命中从磁盘读
+    return false;
+  }
+  stats_.hits_++;
+  return true;
+}
+
+void CompressedPageCache::Erase(page_id_t page_id) {
+  auto it = index_.find(page_id);
+  if (it != index_.end()) EraseEntry(it->second);
+}
+
+void CompressedPageCache::EraseEntry(std::list<Entry>::iterator it) {
+  stats_.pages_--;
+  stats_.compressed_bytes_ -= it->data_.size();
+  index_.erase(it->page_id_);
+  entries_.erase(it);
+}
@@ -0,0 +1,57 @@
+#include "buffer/lru_k_replacer.h"
+
+LRUKReplacer::LRUKReplacer(size_t num_pages, size_t k) : k_(k) { histories_.reserve(num_pages); }
+
+LRUKReplacer::~LRUKReplacer() = default;
+
+bool LRUKReplacer::Victim(frame_id_t *frame_id) {
+  if (evictable_frames_.empty()) return false;
+  auto victim = evictable_frames_.begin();
+  *frame_id = victim->second;
+  evictable_frames_.erase(victim);
+  // the frame will hold another page, its history does not apply any more
+  histories_.erase(*frame_id);
+  return true;
+}
+
+void LRUKReplacer::Pin(frame_id_t frame_id) {
+  auto &history = histories_[frame_id];
+  if (history.evictable_) {
+    evictable_frames_.erase({GetEvictKey(history), frame_id});
+    history.evictable_ = false;
+  }
+  RecordAccess(history);
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id) {
+  auto &history = histories_[frame_id];
+  if (history.evictable_) return;
+  if (history.accesses_.empty()) RecordAccess(history);  // never pinned through this replacer
+  history.evictable_ = true;
+  evictable_frames_.emplace(GetEvictKey(history), frame_id);
+}
+
+void LRUKReplacer::Remove(frame_id_t frame_id) {
+  auto it = histories_.find(frame_id);
+  if (it == histories_.end()) return;
+  if (it->second.evictable_) evictable_frames_.erase({GetEvictKey(it->second), frame_id});
+  histories_.erase(it);
+}
+
+void LRUKReplacer::GetVictimCandidates(size_t count, vector<frame_id_t> *frames) {
+  for (auto it = evictable_frames_.begin(); it != evictable_frames_.end() && frames->size() < count; ++it) {
+    frames->push_back(it->second);
+  }
+}
+
+size_t LRUKReplacer::Size() { return evictable_frames_.size(); }
+
+void LRUKReplacer::RecordAccess(FrameHistory &history) {
+  history.accesses_.push_back(current_timestamp_++);
+  if (history.accesses_.size() > k_) history.accesses_.pop_front();
+}
+
+LRUKReplacer::EvictKey LRUKReplacer::GetEvictKey(const FrameHistory &history) const {
+  // with k accesses the front is the k-th most recent one, otherwise it is the earliest one
+  return {history.accesses_.size() < k_ ? 0 : 1, history.accesses_.front()};
+}
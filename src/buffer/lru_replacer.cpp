@@ -38,6 +38,12 @@ void LRUReplacer::Unpin(frame_id_t frame_id) {
   }
 }
 
+void LRUReplacer::GetVictimCandidates(size_t count, vector<frame_id_t> *frames) {
+  for (auto it = lru_list_.begin(); it != lru_list_.end() && frames->size() < count; ++it) {
+    frames->push_back(*it);
+  }
+}
+
 /**
  * TODO: Student Implement
  */
@@ -0,0 +1,63 @@
+#include "buffer/mapped_buffer_pool_manager.h"
+
+#include <memory>
+
+#include "glog/logging.h"
+
+MappedBufferPoolManager::MappedBufferPoolManager(DiskManager *disk_manager)
+    : BufferPoolManager(disk_manager),
+      mapped_pages_(new std::atomic<Page *>[disk_manager->GetMaxPageId()]()),
+      num_pages_(disk_manager->GetMaxPageId()) {
+  ASSERT(disk_manager->IsReadOnly(), "Only a read-only database file can be served from its mapping.");
+}
+
+MappedBufferPoolManager::~MappedBufferPoolManager() {
+  // the read-ahead helper fetches mapped pages, stop it before they go away
+  StopReadAhead();
+  for (size_t i = 0; i < num_pages_; i++) {
+    delete mapped_pages_[i].load(std::memory_order_relaxed);
+  }
+}
+
+Page *MappedBufferPoolManager::FetchPage(page_id_t page_id, BufferRing * /*ring*/) {
+  if (page_id < 0 || static_cast<size_t>(page_id) >= num_pages_) return nullptr;
+  Page *page = mapped_pages_[page_id].load(std::memory_order_acquire);
+  if (page != nullptr) return page;
+  std::scoped_lock<std::mutex> lock(latch_);
+  page = mapped_pages_[page_id].load(std::memory_order_relaxed);
+  if (page == nullptr) {  // 第一次访问这页，别的线程可能刚建好
+    // 映射是只读的，页的数据不会被写
+    page = new Page(const_cast<char *>(disk_manager_->GetMappedPage(page_id)));
+    page->page_id_ = page_id;
+    mapped_pages_[page_id].store(page, std::memory_order_release);
+  }
+  return page;
+}
+
+std::vector<Page *> MappedBufferPoolManager::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<Page *> pages;
+  pages.reserve(page_ids.size());
+  for (auto page_id : page_ids) {
+    pages.push_back(FetchPage(page_id));
+  }
+  return pages;
+}
+
+bool MappedBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  return !is_dirty && page_id >= 0 && static_cast<size_t>(page_id) < num_pages_;
+}
+
+bool MappedBufferPoolManager::FlushPage(page_id_t page_id) {
+  return page_id >= 0 && static_cast<size_t>(page_id) < num_pages_;
+}
+
+Page *MappedBufferPoolManager::NewPage(page_id_t &page_id, page_id_t /*near_page_id*/) {
+  LOG(ERROR) << "NewPage rejected, the database is read-only";
+  page_id = INVALID_PAGE_ID;
+  return nullptr;
+}
+
+bool MappedBufferPoolManager::DeletePage(page_id_t /*page_id*/) {
+  LOG(ERROR) << "DeletePage rejected, the database is read-only";
+  return false;
+}
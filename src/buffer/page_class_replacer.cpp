@@ -0,0 +1,103 @@
+#include "buffer/page_class_replacer.h"
+
+// classes from the first to give up victims to the last
+static const PageClass EVICTION_ORDER[NUM_PAGE_CLASSES] = {PageClass::kHeap, PageClass::kIndexLeaf,
+                                                           PageClass::kMeta, PageClass::kIndexInternal};
+
+// share of the pool, in eighths, up to which a class is protected by its place in EVICTION_ORDER, indexed by class
+static const size_t PROTECTED_EIGHTHS[NUM_PAGE_CLASSES] = {8, 4, 4, 1};
+
+PageClassReplacer::PageClassReplacer(ReplacerType type, size_t num_pages)
+    : frame_class_(num_pages, NOT_RESIDENT), capacity_(num_pages) {
+  for (size_t i = 0; i < NUM_PAGE_CLASSES; i++) {
+    replacers_.push_back(Replacer::Create(type, num_pages));
+  }
+}
+
+PageClassReplacer::~PageClassReplacer() {
+  for (auto replacer : replacers_) {
+    delete replacer;
+  }
+}
+
+bool PageClassReplacer::Victim(frame_id_t *frame_id) {
+  for (auto page_class : EvictionOrder()) {
+    if (!replacers_[page_class]->Victim(frame_id)) continue;
+    frame_class_[*frame_id] = NOT_RESIDENT;
+    resident_[page_class]--;
+    evictions_[page_class]++;
+    return true;
+  }
+  return false;
+}
+
+void PageClassReplacer::Pin(frame_id_t frame_id) {
+  Track(frame_id);
+  replacers_[frame_class_[frame_id]]->Pin(frame_id);
+}
+
+void PageClassReplacer::Unpin(frame_id_t frame_id) {
+  Track(frame_id);
+  replacers_[frame_class_[frame_id]]->Unpin(frame_id);
+}
+
+void PageClassReplacer::Remove(frame_id_t frame_id) {
+  int8_t page_class = frame_class_[frame_id];
+  if (page_class == NOT_RESIDENT) return;
+  replacers_[page_class]->Remove(frame_id);
+  frame_class_[frame_id] = NOT_RESIDENT;
+  resident_[page_class]--;
+}
+
+void PageClassReplacer::GetVictimCandidates(size_t count, std::vector<frame_id_t> *frames) {
+  size_t limit = frames->size() + count;
+  for (auto page_class : EvictionOrder()) {
+    replacers_[page_class]->GetVictimCandidates(limit, frames);
+  }
+}
+
+size_t PageClassReplacer::Size() {
+  size_t size = 0;
+  for (auto replacer : replacers_) {
+    size += replacer->Size();
+  }
+  return size;
+}
+
+void PageClassReplacer::Grow(size_t num_pages) {
+  if (num_pages <= frame_class_.size()) return;
+  frame_class_.resize(num_pages, NOT_RESIDENT);
+  for (auto replacer : replacers_) {
+    replacer->Grow(num_pages);
+  }
+}
+
+void PageClassReplacer::SetFrameClass(frame_id_t frame_id, PageClass page_class) {
+  auto new_class = static_cast<int8_t>(page_class);
+  int8_t old_class = frame_class_[frame_id];
+  if (old_class == new_class || old_class == NOT_RESIDENT) return;
+  replacers_[old_class]->Remove(frame_id);
+  resident_[old_class]--;
+  frame_class_[frame_id] = new_class;
+  resident_[new_class]++;
+}
+
+void PageClassReplacer::Track(frame_id_t frame_id) {
+  if (frame_class_[frame_id] != NOT_RESIDENT) return;
+  frame_class_[frame_id] = static_cast<int8_t>(PageClass::kHeap);
+  resident_[static_cast<size_t>(PageClass::kHeap)]++;
+}
+
+std::vector<size_t> PageClassReplacer::EvictionOrder() const {
+  // 超出配额的类先换出，其余的按优先级
+  std::vector<size_t> order;
+  for (auto page_class : EVICTION_ORDER) {
+    auto i = static_cast<size_t>(page_class);
+    if (resident_[i] * 8 > capacity_ * PROTECTED_EIGHTHS[i]) order.push_back(i);
+  }
+  for (auto page_class : EVICTION_ORDER) {
+    auto i = static_cast<size_t>(page_class);
+    if (resident_[i] * 8 <= capacity_ * PROTECTED_EIGHTHS[i]) order.push_back(i);
+  }
+  return order;
+}
@@ -0,0 +1,224 @@
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include <mutex>
+
+ParallelBufferPoolManager::ParallelBufferPoolManager(size_t num_instances, size_t pool_size,
+                                                     DiskManager *disk_manager, ReplacerType replacer_type,
+                                                     size_t max_pool_size)
+    : BufferPoolManager(disk_manager), num_instances_(num_instances) {
+  ASSERT(num_instances_ > 0, "Buffer pool needs at least one instance.");
+  ASSERT(pool_size > 0, "Every buffer pool instance needs at least one frame.");
+  for (size_t i = 0; i < num_instances_; i++) {
+    instances_.push_back(new BufferPoolManagerInstance(pool_size, disk_manager, replacer_type, max_pool_size));
+  }
+}
+
+ParallelBufferPoolManager::~ParallelBufferPoolManager() {
+  // the helper threads walk the instances, stop them before the instances go away
+  StopReadAhead();
+  StopBackgroundWriter();
+  if (!warm_start_file_.empty()) {
+    SaveResidentPages(warm_start_file_);
+    warm_start_file_.clear();
+  }
+  WriteDirtyPages();
+  for (auto instance : instances_) {
+    delete instance;
+  }
+}
+
+Page *ParallelBufferPoolManager::FetchPage(page_id_t page_id, BufferRing *ring) {
+  return GetInstance(page_id)->FetchPage(page_id, ring);
+}
+
+std::vector<Page *> ParallelBufferPoolManager::FetchPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<std::vector<page_id_t>> instance_page_ids(num_instances_);
+  for (auto page_id : page_ids) {
+    instance_page_ids[page_id % num_instances_].push_back(page_id);
+  }
+  std::vector<std::vector<Page *>> instance_pages(num_instances_);
+  for (size_t i = 0; i < num_instances_; i++) {
+    if (!instance_page_ids[i].empty()) instance_pages[i] = instances_[i]->FetchPages(instance_page_ids[i]);
+  }
+  // put the pages back into the order of page_ids
+  std::vector<size_t> next(num_instances_, 0);
+  std::vector<Page *> pages;
+  pages.reserve(page_ids.size());
+  for (auto page_id : page_ids) {
+    size_t instance = page_id % num_instances_;
+    pages.push_back(instance_pages[instance][next[instance]++]);
+  }
+  return pages;
+}
+
+bool ParallelBufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  return GetInstance(page_id)->UnpinPage(page_id, is_dirty);
+}
+
+bool ParallelBufferPoolManager::FlushPage(page_id_t page_id) { return GetInstance(page_id)->FlushPage(page_id); }
+
+bool ParallelBufferPoolManager::FlushAllPages() {
+  bool written = WriteDirtyPages();
+  return disk_manager_->Sync() && written;
+}
+
+Page *ParallelBufferPoolManager::NewPage(page_id_t &page_id, page_id_t near_page_id) {
+  page_id = AllocatePage(near_page_id);
+  if (page_id == INVALID_PAGE_ID) return nullptr;
+  Page *page = GetInstance(page_id)->NewPageWithId(page_id);
+  if (page == nullptr) {
+    // the owning instance is fully pinned, give the page id back
+    DeallocatePage(page_id);
+    page_id = INVALID_PAGE_ID;
+  }
+  return page;
+}
+
+bool ParallelBufferPoolManager::DeletePage(page_id_t page_id) { return GetInstance(page_id)->DeletePage(page_id); }
+
+bool ParallelBufferPoolManager::CheckAllUnpinned() {
+  bool res = true;
+  for (auto instance : instances_) {
+    res = instance->CheckAllUnpinned() && res;
+  }
+  return res;
+}
+
+size_t ParallelBufferPoolManager::GetPoolSize() {
+  size_t pool_size = 0;
+  for (auto instance : instances_) {
+    pool_size += instance->GetPoolSize();
+  }
+  return pool_size;
+}
+
+size_t ParallelBufferPoolManager::Resize(size_t pool_size) {
+  size_t resized = 0;
+  for (auto instance : instances_) {
+    resized += instance->Resize(pool_size / num_instances_);
+  }
+  return resized;
+}
+
+void ParallelBufferPoolManager::SetMaxPoolSize(size_t max_pool_size) {
+  for (auto instance : instances_) {
+    instance->SetMaxPoolSize(max_pool_size / num_instances_);
+  }
+}
+
+size_t ParallelBufferPoolManager::GetHitCount() {
+  size_t hits = 0;
+  for (auto instance : instances_) {
+    hits += instance->GetHitCount();
+  }
+  return hits;
+}
+
+size_t ParallelBufferPoolManager::GetMissCount() {
+  size_t misses = 0;
+  for (auto instance : instances_) {
+    misses += instance->GetMissCount();
+  }
+  return misses;
+}
+
+size_t ParallelBufferPoolManager::GetSyncWriteCount() {
+  size_t writes = 0;
+  for (auto instance : instances_) {
+    writes += instance->GetSyncWriteCount();
+  }
+  return writes;
+}
+
+size_t ParallelBufferPoolManager::GetBackgroundWriteCount() {
+  size_t writes = 0;
+  for (auto instance : instances_) {
+    writes += instance->GetBackgroundWriteCount();
+  }
+  return writes;
+}
+
+size_t ParallelBufferPoolManager::GetResidentPageCount(PageClass page_class) {
+  size_t pages = 0;
+  for (auto instance : instances_) {
+    pages += instance->GetResidentPageCount(page_class);
+  }
+  return pages;
+}
+
+size_t ParallelBufferPoolManager::GetEvictionCount(PageClass page_class) {
+  size_t pages = 0;
+  for (auto instance : instances_) {
+    pages += instance->GetEvictionCount(page_class);
+  }
+  return pages;
+}
+
+void ParallelBufferPoolManager::EnableCompressedCache(size_t capacity) {
+  for (auto instance : instances_) {
+    instance->EnableCompressedCache(capacity / num_instances_);
+  }
+}
+
+CompressedCacheStats ParallelBufferPoolManager::GetCompressedCacheStats() {
+  CompressedCacheStats stats;
+  for (auto instance : instances_) {
+    stats += instance->GetCompressedCacheStats();
+  }
+  return stats;
+}
+
+size_t ParallelBufferPoolManager::BackgroundWriterStep(size_t clean_target) {
+  size_t writes = 0;
+  for (auto instance : instances_) {
+    writes += instance->BackgroundWriterStep(clean_target);
+  }
+  return writes;
+}
+
+bool ParallelBufferPoolManager::WriteDirtyPages() {
+  // 按顺序加锁，其他地方一次只拿一个实例的锁，不会死锁；后台的写要先完成，不拿着锁等
+  std::vector<std::unique_lock<std::recursive_mutex>> locks;
+  bool flushing;
+  do {
+    locks.clear();
+    for (auto instance : instances_) {
+      instance->WaitForFlush(INVALID_PAGE_ID);
+    }
+    flushing = false;
+    for (auto instance : instances_) {
+      locks.emplace_back(instance->latch_);
+      flushing = flushing || instance->IsFlushing(INVALID_PAGE_ID);
+    }
+  } while (flushing);
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  for (auto instance : instances_) {
+    instance->CollectDirtyPages(&writes);
+  }
+  if (!disk_manager_->WritePageBatch(writes)) return false;
+  for (auto instance : instances_) {
+    instance->MarkClean(writes);
+  }
+  return true;
+}
+
+std::vector<page_id_t> ParallelBufferPoolManager::GetResidentPages() {
+  std::vector<page_id_t> page_ids;
+  for (auto instance : instances_) {
+    auto instance_page_ids = instance->GetResidentPages();
+    page_ids.insert(page_ids.end(), instance_page_ids.begin(), instance_page_ids.end());
+  }
+  return page_ids;
+}
+
+size_t ParallelBufferPoolManager::LoadPages(const std::vector<page_id_t> &page_ids) {
+  std::vector<std::vector<page_id_t>> instance_page_ids(num_instances_);
+  for (auto page_id : page_ids) {
+    if (page_id >= 0) instance_page_ids[page_id % num_instances_].push_back(page_id);
+  }
+  size_t loaded = 0;
+  for (size_t i = 0; i < num_instances_; i++) {
+    loaded += instances_[i]->LoadPages(instance_page_ids[i]);
+  }
+  return loaded;
+}
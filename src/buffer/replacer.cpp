@@ -0,0 +1,17 @@
+#include "buffer/replacer.h"
+
+#include "buffer/clock_replacer.h"
+#include "buffer/lru_k_replacer.h"
+#include "buffer/lru_replacer.h"
+
+Replacer *Replacer::Create(ReplacerType type, size_t num_pages) {
+  switch (type) {
+    case ReplacerType::kLRUK:
+      return new LRUKReplacer(num_pages);
+    case ReplacerType::kClock:
+      return new CLOCKReplacer(num_pages);
+    case ReplacerType::kLRU:
+    default:
+      return new LRUReplacer(num_pages);
+  }
+}
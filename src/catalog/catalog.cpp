@@ -74,9 +74,21 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
     this->next_table_id_=catalog_meta_->GetNextTableId();
   }else{//从文件中初始化信息
     Page* meta_page=this->buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
+    meta_page->SetPageClass(PageClass::kMeta);
     this->catalog_meta_=CatalogMeta::DeserializeFrom(meta_page->GetData());
+    this->buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID,false);
     this->next_table_id_=catalog_meta_->GetNextTableId();
     this->next_index_id_=catalog_meta_->GetNextIndexId();
+    //一次性读入所有元数据页，之后的Load都能直接命中
+    vector<page_id_t> meta_page_ids;
+    for(auto it:catalog_meta_->table_meta_pages_) meta_page_ids.push_back(it.second);
+    for(auto it:catalog_meta_->index_meta_pages_) meta_page_ids.push_back(it.second);
+    auto meta_pages=this->buffer_pool_manager_->FetchPages(meta_page_ids);
+    for(size_t i=0;i<meta_page_ids.size();i++)
+      if(meta_pages[i]!=nullptr){
+        meta_pages[i]->SetPageClass(PageClass::kMeta);
+        this->buffer_pool_manager_->UnpinPage(meta_page_ids[i],false);
+      }
     for(auto it:catalog_meta_->table_meta_pages_){
       ASSERT(LoadTable(it.first,it.second)==DB_SUCCESS,"wrong");
     }
@@ -102,11 +114,13 @@ CatalogManager::~CatalogManager() {
  */
 dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema,
                                     Transaction *txn, TableInfo *&table_info) {
+  if(buffer_pool_manager_->IsReadOnly()) return DB_FAILED;//只读数据库
   if(table_names_.find(table_name)!=table_names_.end())
     return DB_TABLE_ALREADY_EXIST;
   //table_heap
   TableHeap* table_heap=TableHeap::Create(buffer_pool_manager_,schema, nullptr,log_manager_,lock_manager_);
   TableMetadata* meta_data=TableMetadata::Create(next_table_id_++,table_name,table_heap->GetFirstPageId(),schema);
+  meta_data->SetFreeSpaceMapPageId(table_heap->GetFreeSpaceMapPageId());
   table_info=TableInfo::Create();
   table_info->Init(meta_data,table_heap);
   //table_name&tables
@@ -115,6 +129,7 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   //找个page写table元数据
   page_id_t page_id;
   Page* page=buffer_pool_manager_->NewPage(page_id);
+  page->SetPageClass(PageClass::kMeta);
   meta_data->SerializeTo(page->GetData());
   buffer_pool_manager_->UnpinPage(page_id,true);
   //更新catalog metadata
@@ -149,6 +164,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
                                     const std::vector<std::string> &index_keys, Transaction *txn,
                                     IndexInfo *&index_info, const string &index_type) {
   // ASSERT(false, "Not Implemented yet");
+  if(buffer_pool_manager_->IsReadOnly()) return DB_FAILED;//只读数据库
   dberr_t dberr= GetIndex(table_name,index_name,index_info);
   if(dberr!=DB_INDEX_NOT_FOUND) return dberr==DB_SUCCESS?DB_INDEX_ALREADY_EXIST:dberr;
   index_id_t index_id=this->next_index_id_++;
@@ -165,7 +181,8 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   index_info=IndexInfo::Create();
   index_info->Init(meta_data,table_info,buffer_pool_manager_);
   //将table中原有的数据插入索引中
-  auto itr=table_info->GetTableHeap()->Begin(txn);
+  BufferRing ring;  // 回填只需扫一遍table，不要挤掉已缓存的索引页
+  auto itr=table_info->GetTableHeap()->Begin(txn,&ring);
   vector<uint32_t> column_ids;
   vector<Column *> columns = index_info->GetIndexKeySchema()->GetColumns();
   for (auto column : columns) {
@@ -173,7 +190,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
     if (table_info->GetSchema()->GetColumnIndex(column->GetName(), column_id) == DB_SUCCESS)
       column_ids.push_back(column_id);
   }
-  for(;itr!=table_info->GetTableHeap()->End();itr++){
+  for(;itr!=table_info->GetTableHeap()->End();++itr){
     Row tmp=*itr;
     vector<Field> fields;
     for (auto column_id : column_ids) fields.push_back(*tmp.GetField(column_id));
@@ -183,6 +200,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   //找个page写元数据
   page_id_t page_id;
   Page* page=buffer_pool_manager_->NewPage(page_id);
+  page->SetPageClass(PageClass::kMeta);
   meta_data->SerializeTo(page->GetData());
   buffer_pool_manager_->UnpinPage(page_id,true);
   //更新table_names&indexes
@@ -222,11 +240,115 @@ dberr_t CatalogManager::GetTableIndexes(const std::string &table_name, std::vect
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::BulkInsert(const std::string &table_name, std::vector<Row> &rows, Transaction *txn) {
+  if (buffer_pool_manager_->IsReadOnly()) return DB_FAILED;  // 只读数据库
+  TableInfo *table_info = nullptr;
+  dberr_t dberr = GetTable(table_name, table_info);
+  if (dberr != DB_SUCCESS) return dberr;
+  auto *table_heap = table_info->GetTableHeap();
+  size_t inserted = table_heap->BulkInsert(rows, txn);
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  // 按索引逐个插入，前面的索引成功了后面的失败，要把前面插进去的删掉
+  std::vector<std::vector<std::pair<Row, RowId>>> index_entries;
+  bool failed = inserted < rows.size();
+  for (auto index_info : indexes) {
+    if (failed) break;
+    std::vector<uint32_t> column_ids;
+    for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+      uint32_t column_id;
+      if (table_info->GetSchema()->GetColumnIndex(column->GetName(), column_id) == DB_SUCCESS)
+        column_ids.push_back(column_id);
+    }
+    std::vector<std::pair<Row, RowId>> entries;
+    entries.reserve(rows.size());
+    for (auto &row : rows) {
+      std::vector<Field> fields;
+      for (auto column_id : column_ids) fields.push_back(*row.GetField(column_id));
+      entries.emplace_back(Row(fields), row.GetRowId());
+    }
+    failed = index_info->GetIndex()->InsertEntries(entries, txn) != DB_SUCCESS;
+    if (!failed) index_entries.push_back(std::move(entries));
+  }
+  if (!failed) return DB_SUCCESS;
+  for (size_t i = 0; i < index_entries.size(); i++) {
+    for (auto &entry : index_entries[i]) indexes[i]->GetIndex()->RemoveEntry(entry.first, entry.second, txn);
+  }
+  for (size_t i = 0; i < inserted; i++) table_heap->ApplyDelete(rows[i].GetRowId(), txn);
+  return DB_FAILED;
+}
+
+dberr_t CatalogManager::RemoveRows(const std::string &table_name, const std::vector<RowId> &row_ids, Transaction *txn) {
+  if (buffer_pool_manager_->IsReadOnly()) return DB_FAILED;  // 只读数据库
+  TableInfo *table_info = nullptr;
+  dberr_t dberr = GetTable(table_name, table_info);
+  if (dberr != DB_SUCCESS) return dberr;
+  auto *table_heap = table_info->GetTableHeap();
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  std::vector<std::vector<uint32_t>> key_columns;
+  for (auto index_info : indexes) {
+    std::vector<uint32_t> column_ids;
+    for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+      uint32_t column_id;
+      if (table_info->GetSchema()->GetColumnIndex(column->GetName(), column_id) == DB_SUCCESS)
+        column_ids.push_back(column_id);
+    }
+    key_columns.push_back(column_ids);
+  }
+  // 先读出元组拿到索引的键，删掉索引项再删元组
+  for (auto &row_id : row_ids) {
+    Row row(row_id);
+    if (!table_heap->GetTuple(&row, txn)) continue;
+    for (size_t i = 0; i < indexes.size(); i++) {
+      std::vector<Field> fields;
+      for (auto column_id : key_columns[i]) fields.push_back(*row.GetField(column_id));
+      indexes[i]->GetIndex()->RemoveEntry(Row(fields), row_id, txn);
+    }
+    table_heap->ApplyDelete(row_id, txn);
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::VacuumTable(const std::string &table_name, Transaction *txn, size_t *freed_pages) {
+  if (buffer_pool_manager_->IsReadOnly()) return DB_FAILED;  // 只读数据库
+  TableInfo *table_info = nullptr;
+  dberr_t dberr = GetTable(table_name, table_info);
+  if (dberr != DB_SUCCESS) return dberr;
+  std::vector<IndexInfo *> indexes;
+  GetTableIndexes(table_name, indexes);
+  // 每个索引的键在表里是哪几列
+  std::vector<std::vector<uint32_t>> key_columns;
+  for (auto index_info : indexes) {
+    std::vector<uint32_t> column_ids;
+    for (auto column : index_info->GetIndexKeySchema()->GetColumns()) {
+      uint32_t column_id;
+      if (table_info->GetSchema()->GetColumnIndex(column->GetName(), column_id) == DB_SUCCESS)
+        column_ids.push_back(column_id);
+    }
+    key_columns.push_back(column_ids);
+  }
+  size_t freed = table_info->GetTableHeap()->Vacuum(txn, [&](const Row &row, const RowId &old_rid) {
+    for (size_t i = 0; i < indexes.size(); i++) {
+      std::vector<Field> fields;
+      for (auto column_id : key_columns[i]) fields.push_back(*row.GetField(column_id));
+      Row key_row(fields);
+      indexes[i]->GetIndex()->RemoveEntry(key_row, old_rid, txn);
+      indexes[i]->GetIndex()->InsertEntry(key_row, row.GetRowId(), txn);
+    }
+  });
+  // 写回位图，文件末尾空出来的页随之截掉
+  buffer_pool_manager_->FlushAllPages();
+  if (freed_pages != nullptr) *freed_pages = freed;
+  return DB_SUCCESS;
+}
+
 /**
  * TODO: Student Implement
  */
 dberr_t CatalogManager::DropTable(const string &table_name) {
   // ASSERT(false, "Not Implemented yet");
+  if(buffer_pool_manager_->IsReadOnly()) return DB_FAILED;//只读数据库
   auto it=table_names_.find(table_name);
   if(it==table_names_.end()) return DB_TABLE_NOT_EXIST;
   //先删索引
@@ -257,6 +379,7 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
  */
 dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_name) {
   // ASSERT(false, "Not Implemented yet");
+  if(buffer_pool_manager_->IsReadOnly()) return DB_FAILED;//只读数据库
   auto it1=index_names_.find(table_name);
   if(it1==index_names_.end()) return DB_TABLE_NOT_EXIST;
   auto it2=it1->second.find(index_name);
@@ -279,7 +402,9 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
  * TODO: Student Implement
  */
 dberr_t CatalogManager::FlushCatalogMetaPage() const {
+  if(buffer_pool_manager_->IsReadOnly()) return DB_SUCCESS;//只读数据库的元数据不会变
   Page* page=buffer_pool_manager_->FetchPage(CATALOG_META_PAGE_ID);
+  page->SetPageClass(PageClass::kMeta);
   this->catalog_meta_->SerializeTo(page->GetData());
   buffer_pool_manager_->UnpinPage(CATALOG_META_PAGE_ID,true);
   buffer_pool_manager_->FlushPage(CATALOG_META_PAGE_ID);
@@ -291,11 +416,20 @@ dberr_t CatalogManager::FlushCatalogMetaPage() const {
  */
 dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t page_id) {
   Page* page=buffer_pool_manager_->FetchPage(page_id);
+  page->SetPageClass(PageClass::kMeta);
   //meta_data
   TableMetadata* meta_data;
   TableMetadata::DeserializeFrom(page->GetData(),meta_data);
   //table_heap
-  TableHeap* table_heap=TableHeap::Create(buffer_pool_manager_,meta_data->GetFirstPageId(),meta_data->GetSchema(),log_manager_,lock_manager_);
+  TableHeap* table_heap=TableHeap::Create(buffer_pool_manager_,meta_data->GetFirstPageId(),meta_data->GetSchema(),
+                                          log_manager_,lock_manager_,meta_data->GetFreeSpaceMapPageId());
+  //旧表没有空闲空间表，建一个并记进元数据
+  bool upgraded=false;
+  if(meta_data->GetFreeSpaceMapPageId()==INVALID_PAGE_ID&&!buffer_pool_manager_->IsReadOnly()){
+    meta_data->SetFreeSpaceMapPageId(table_heap->GetFreeSpaceMapPageId());
+    meta_data->SerializeTo(page->GetData());
+    upgraded=true;
+  }
   //table_info
   TableInfo* table_info=TableInfo::Create();
   table_info->Init(meta_data,table_heap);
@@ -304,7 +438,7 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   this->table_names_[meta_data->GetTableName()]=table_id;
   this->tables_[table_id]=table_info;
   //Unpin
-  buffer_pool_manager_->UnpinPage(page_id,false);
+  buffer_pool_manager_->UnpinPage(page_id,upgraded);
   return DB_SUCCESS;
 }
 
@@ -314,6 +448,7 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
 dberr_t CatalogManager::LoadIndex(const index_id_t index_id, const page_id_t page_id) {
   // ASSERT(false, "Not Implemented yet");
   Page* page=buffer_pool_manager_->FetchPage(page_id);
+  page->SetPageClass(PageClass::kMeta);
   //meta_data
   IndexMetadata* meta_data;
   IndexMetadata::DeserializeFrom(page->GetData(),meta_data);
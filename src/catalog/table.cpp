@@ -5,7 +5,7 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
     uint32_t ofs = GetSerializedSize();
     ASSERT(ofs <= PAGE_SIZE, "Failed to serialize table info.");
     // magic num
-    MACH_WRITE_UINT32(buf, TABLE_METADATA_MAGIC_NUM);
+    MACH_WRITE_UINT32(buf, TABLE_METADATA_FSM_MAGIC_NUM);
     buf += 4;
     // table id
     MACH_WRITE_TO(table_id_t, buf, table_id_);
@@ -18,6 +18,9 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
     // table heap root page id
     MACH_WRITE_TO(page_id_t, buf, root_page_id_);
     buf += 4;
+    // free space map page id
+    MACH_WRITE_TO(page_id_t, buf, fsm_page_id_);
+    buf += 4;
     // table schema
     buf += schema_->SerializeTo(buf);
     ASSERT(buf - p == ofs, "Unexpected serialize size.");
@@ -29,7 +32,7 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
  * TODO: Student Implement
  */
 uint32_t TableMetadata::GetSerializedSize() const {
-  return 4*4+table_name_.length()+schema_->GetSerializedSize();
+  return 5*4+table_name_.length()+schema_->GetSerializedSize();
 }
 
 uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
@@ -40,7 +43,8 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
     // magic num
     uint32_t magic_num = MACH_READ_UINT32(buf);
     buf += 4;
-    ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM, "Failed to deserialize table info.");
+    ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM || magic_num == TABLE_METADATA_FSM_MAGIC_NUM,
+           "Failed to deserialize table info.");
     // table id
     table_id_t table_id = MACH_READ_FROM(table_id_t, buf);
     buf += 4;
@@ -52,11 +56,18 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
     // table heap root page id
     page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
     buf += 4;
+    // free space map page id, tables written before the map existed have none
+    page_id_t fsm_page_id = INVALID_PAGE_ID;
+    if (magic_num == TABLE_METADATA_FSM_MAGIC_NUM) {
+      fsm_page_id = MACH_READ_FROM(page_id_t, buf);
+      buf += 4;
+    }
     // table schema
     TableSchema *schema = nullptr;
     buf += TableSchema::DeserializeFrom(buf, schema);
     // allocate space for table metadata
     table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+    table_meta->fsm_page_id_ = fsm_page_id;
     return buf - p;
 }
 
@@ -3,16 +3,43 @@
 //
 #include "common/instance.h"
 
-DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size)
+#include <algorithm>
+
+#include "buffer/mapped_buffer_pool_manager.h"
+#include "buffer/parallel_buffer_pool_manager.h"
+
+DBStorageEngine::DBStorageEngine(std::string db_name, bool init, uint32_t buffer_pool_size,
+                                 uint32_t buffer_pool_instances, ReplacerType replacer_type,
+                                 uint32_t max_buffer_pool_size, bool read_only)
     : db_file_name_(std::move(db_name)), init_(init) {
   // Init database file if needed
   db_file_name_ = "./databases/"+db_file_name_;
+  if (read_only) {
+    if (init_) throw logic_error("A read-only database can not be initialized.");
+    disk_mgr_ = new DiskManager(db_file_name_, false, true);
+    bpm_ = new MappedBufferPoolManager(disk_mgr_);
+    ASSERT(!bpm_->IsPageFree(CATALOG_META_PAGE_ID), "Invalid catalog meta page.");
+    catalog_mgr_ = new CatalogManager(bpm_, nullptr, nullptr, false);
+    return;
+  }
   if (init_) {
     remove(db_file_name_.c_str());
+    remove((db_file_name_ + WARM_START_FILE_SUFFIX).c_str());
   }
   // Initialize components
   disk_mgr_ = new DiskManager(db_file_name_);
-  bpm_ = new BufferPoolManager(buffer_pool_size, disk_mgr_);
+  // 每个实例至少要有一个frame，frame比实例少时就少开几个实例
+  buffer_pool_instances = std::max<uint32_t>(std::min(buffer_pool_instances, buffer_pool_size), 1);
+  if (buffer_pool_instances > 1) {
+    bpm_ = new ParallelBufferPoolManager(buffer_pool_instances, buffer_pool_size / buffer_pool_instances, disk_mgr_,
+                                         replacer_type, max_buffer_pool_size / buffer_pool_instances);
+  } else {
+    bpm_ = new BufferPoolManagerInstance(buffer_pool_size, disk_mgr_, replacer_type, max_buffer_pool_size);
+  }
+  bpm_->EnableCompressedCache(DEFAULT_COMPRESSED_CACHE_SIZE);
+  // reload the hot pages of the last run before the first query
+  bpm_->EnableWarmStart(db_file_name_ + WARM_START_FILE_SUFFIX);
+  bpm_->StartBackgroundWriter();
 
   // Allocate static page for db storage engine
   if (init) {
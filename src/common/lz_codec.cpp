@@ -0,0 +1,109 @@
+#include "common/lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+
+static const size_t MIN_MATCH = 4;
+static const size_t MAX_DISTANCE = 65535;
+static const int HASH_BITS = 12;
+
+static inline uint32_t Read32(const char *p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint32_t Hash(uint32_t value) { return (value * 2654435761U) >> (32 - HASH_BITS); }
+
+/** Append the extra bytes of a length whose nibble is 15 */
+static inline bool PutLength(size_t length, char *dst, size_t &op, size_t capacity) {
+  for (; length >= 255; length -= 255) {
+    if (op >= capacity) return false;
+    dst[op++] = static_cast<char>(255);
+  }
+  if (op >= capacity) return false;
+  dst[op++] = static_cast<char>(length);
+  return true;
+}
+
+/** Read the extra bytes of a length whose nibble is 15 */
+static inline bool GetLength(const unsigned char *src, size_t &ip, size_t size, size_t &length) {
+  unsigned char byte;
+  do {
+    if (ip >= size) return false;
+    byte = src[ip++];
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+/** Write one sequence, match_length 0 for the final literals-only sequence */
+static bool PutSequence(const char *literals, size_t literal_length, size_t distance, size_t match_length, char *dst,
+                        size_t &op, size_t capacity) {
+  size_t match_code = match_length == 0 ? 0 : match_length - MIN_MATCH;
+  if (op >= capacity) return false;
+  size_t token = op++;
+  dst[token] = static_cast<char>(((literal_length < 15 ? literal_length : 15) << 4) |
+                                 (match_code < 15 ? match_code : 15));
+  if (literal_length >= 15 && !PutLength(literal_length - 15, dst, op, capacity)) return false;
+  if (op + literal_length > capacity) return false;
+  memcpy(dst + op, literals, literal_length);
+  op += literal_length;
+  if (match_length == 0) return true;
+  if (op + 2 > capacity) return false;
+  dst[op++] = static_cast<char>(distance & 0xff);
+  dst[op++] = static_cast<char>(distance >> 8);
+  return match_code < 15 || PutLength(match_code - 15, dst, op, capacity);
+}
+
+size_t LZCodec::Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity) {
+  uint32_t table[1 << HASH_BITS] = {0};  // position + 1 of the last occurrence of a hash, 0 if none
+  size_t ip = 0;
+  size_t anchor = 0;  // start of the pending literals
+  size_t op = 0;
+  while (ip + MIN_MATCH <= src_size) {
+    uint32_t h = Hash(Read32(src + ip));
+    size_t candidate = table[h];
+    table[h] = static_cast<uint32_t>(ip + 1);
+    if (candidate == 0 || ip - (candidate - 1) > MAX_DISTANCE || Read32(src + candidate - 1) != Read32(src + ip)) {
+      ip++;
+      continue;
+    }
+    size_t match = candidate - 1;
+    size_t length = MIN_MATCH;
+    while (ip + length < src_size && src[match + length] == src[ip + length]) length++;
+    if (!PutSequence(src + anchor, ip - anchor, ip - match, length, dst, op, dst_capacity)) return 0;
+    ip += length;
+    anchor = ip;
+  }
+  if (anchor < src_size && !PutSequence(src + anchor, src_size - anchor, 0, 0, dst, op, dst_capacity)) return 0;
+  return op;
+}
+
+size_t LZCodec::Decompress(const char *src, size_t src_size, char *dst, size_t dst_capacity) {
+  auto in = reinterpret_cast<const unsigned char *>(src);
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < src_size) {
+    unsigned char token = in[ip++];
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !GetLength(in, ip, src_size, literal_length)) return 0;
+    if (ip + literal_length > src_size || op + literal_length > dst_capacity) return 0;
+    memcpy(dst + op, src + ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+    if (ip == src_size) break;  // 最后一个序列只有字面量
+    if (ip + 2 > src_size) return 0;
+    size_t distance = in[ip] | (in[ip + 1] << 8);
+    ip += 2;
+    size_t match_length = token & 15;
+    if (match_length == 15 && !GetLength(in, ip, src_size, match_length)) return 0;
+    match_length += MIN_MATCH;
+    if (distance == 0 || distance > op || op + match_length > dst_capacity) return 0;
+    // 匹配可能和输出重叠，逐字节复制
+    for (size_t i = 0; i < match_length; i++, op++) {
+      dst[op] = dst[op - distance];
+    }
+  }
+  return op;
+}
@@ -37,14 +37,24 @@ ExecuteEngine::ExecuteEngine() {
   while((stdir = readdir(dir)) != nullptr) {
     if( strcmp( stdir->d_name , "." ) == 0 ||
         strcmp( stdir->d_name , "..") == 0 ||
-        stdir->d_name[0] == '.')
+        stdir->d_name[0] == '.' ||
+        std::string(stdir->d_name).find(WARM_START_FILE_SUFFIX) != std::string::npos)
       continue;
-    dbs_[stdir->d_name] = new DBStorageEngine(stdir->d_name, false);
+    dbs_[stdir->d_name] = OpenDatabase(stdir->d_name, false);
   }
    **/
   closedir(dir);
 }
 
+DBStorageEngine *ExecuteEngine::OpenDatabase(const std::string &db_name, bool init) {
+  size_t pool_size = budget_.GetInitialFrames(MIN_BUFFER_POOL_SIZE);
+  // 先按初始大小建pool，之后由budget按负载放大
+  auto *db = new DBStorageEngine(db_name, init, pool_size, DEFAULT_BUFFER_POOL_INSTANCES, ReplacerType::kLRUK,
+                                 pool_size);
+  budget_.Register(db->bpm_, MIN_BUFFER_POOL_SIZE);
+  return db;
+}
+
 std::unique_ptr<AbstractExecutor> ExecuteEngine::CreateExecutor(ExecuteContext *exec_ctx,
                                                                 const AbstractPlanNodeRef &plan) {
   switch (plan->GetType()) {
@@ -110,6 +120,7 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
     return DB_FAILED;
   }
   auto start_time = std::chrono::system_clock::now();
+  budget_.Rebalance();  // 负载变了的话在数据库之间重新分配frame
   unique_ptr<ExecuteContext> context(nullptr);
   if(!current_db_.empty())
     context = dbs_[current_db_]->MakeExecuteContext(nullptr);
@@ -144,6 +155,10 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteExecfile(ast, context.get());
     case kNodeQuit:
       return ExecuteQuit(ast, context.get());
+    case kNodeVacuum:
+      return ExecuteVacuum(ast, context.get());
+    case kNodeLoadData:
+      return ExecuteLoadData(ast, context.get());
     default:
       break;
   }
@@ -253,7 +268,7 @@ dberr_t ExecuteEngine::ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *co
   std::string db_name(ast->child_->val_);
   if(this->dbs_.find(db_name)!=dbs_.end())
     return DB_ALREADY_EXIST;
-  dbs_.insert(std::pair<string,DBStorageEngine*>(db_name,new DBStorageEngine(db_name)));
+  dbs_.insert(std::pair<string,DBStorageEngine*>(db_name,OpenDatabase(db_name, true)));
   return DB_SUCCESS;
 }
 
@@ -268,12 +283,14 @@ dberr_t ExecuteEngine::ExecuteDropDatabase(pSyntaxNode ast, ExecuteContext *cont
  std::string db_name(ast->child_->val_);
  if(dbs_.find(db_name)==dbs_.end())
    return DB_NOT_EXIST;
+ budget_.Unregister(dbs_[db_name]->bpm_);
  delete dbs_[db_name];
  dbs_.erase(db_name);
  if(current_db_==db_name)
    current_db_.clear();
- std::string db_file_name="./database/"+db_name;
+ std::string db_file_name="./databases/"+db_name;
  remove(db_file_name.c_str());
+ remove((db_file_name+WARM_START_FILE_SUFFIX).c_str());
  std::cout<<"Database '"<<db_name<<"' dropped"<<std::endl;
  return DB_SUCCESS;
 }
@@ -736,3 +753,167 @@ dberr_t ExecuteEngine::ExecuteQuit(pSyntaxNode ast, ExecuteContext *context) {
     return DB_QUIT;
   return DB_FAILED;
 }
+
+dberr_t ExecuteEngine::ExecuteVacuum(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteVacuum" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected." << endl;
+    return DB_FAILED;
+  }
+  CatalogManager *catalog = dbs_[current_db_]->catalog_mgr_;
+  // 没给表名就整理所有表
+  vector<string> table_names;
+  if (ast->child_ != nullptr) {
+    table_names.emplace_back(ast->child_->val_);
+  } else {
+    vector<TableInfo *> table_infos;
+    catalog->GetTables(table_infos);
+    for (auto table_info : table_infos) table_names.push_back(table_info->GetTableName());
+  }
+  for (const auto &table_name : table_names) {
+    size_t freed_pages = 0;
+    dberr_t result = catalog->VacuumTable(table_name, nullptr, &freed_pages);
+    if (result != DB_SUCCESS) return result;
+    cout << "Table '" << table_name << "' vacuumed, " << freed_pages << " pages freed." << endl;
+  }
+  return DB_SUCCESS;
+}
+
+/**
+ * Split a line of a CSV file into its fields. A field in double quotes may contain commas, two double quotes in it
+ * stand for one.
+ * @param[out] quoted whether each field was quoted, an empty field that was not is NULL
+ */
+static vector<string> SplitCsvLine(const string &line, vector<bool> *quoted) {
+  vector<string> fields(1);
+  quoted->assign(1, false);
+  bool in_quotes = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (in_quotes) {
+      if (c != '"') {
+        fields.back() += c;
+      } else if (i + 1 < line.size() && line[i + 1] == '"') {
+        fields.back() += '"';
+        i++;
+      } else {
+        in_quotes = false;
+      }
+    } else if (c == '"') {
+      in_quotes = true;
+      quoted->back() = true;
+    } else if (c == ',') {
+      fields.emplace_back();
+      quoted->push_back(false);
+    } else if (c != '\r') {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+dberr_t ExecuteEngine::ExecuteLoadData(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteLoadData" << std::endl;
+#endif
+  if (current_db_.empty()) {
+    cout << "No database selected." << endl;
+    return DB_FAILED;
+  }
+  string file_name = ast->child_->val_;
+  string table_name = ast->child_->next_->val_;
+  CatalogManager *catalog = context->GetCatalog();
+  TableInfo *table_info = nullptr;
+  if (catalog->GetTable(table_name, table_info) != DB_SUCCESS) return DB_TABLE_NOT_EXIST;
+  ifstream file(file_name);
+  if (!file.is_open()) {
+    cout << "file can't be opened." << endl;
+    return DB_FAILED;
+  }
+  // 攒够一批再插，索引的键按批排序，批越大插索引时越顺
+  static constexpr size_t LOAD_DATA_BATCH_SIZE = 65536;
+  auto start_time = std::chrono::system_clock::now();
+  Schema *schema = table_info->GetSchema();
+  uint32_t column_count = schema->GetColumnCount();
+  vector<Row> rows;
+  vector<RowId> loaded_rids;  // 前面几批已经插入的行，后面出错时要删掉
+  size_t line_no = 0;
+  string line;
+  vector<bool> quoted;
+  dberr_t result = DB_SUCCESS;
+  while (result == DB_SUCCESS) {
+    bool eof = !getline(file, line);
+    if (!eof) {
+      line_no++;
+      if (line.empty() || line == "\r") continue;
+      vector<string> values = SplitCsvLine(line, &quoted);
+      if (values.size() != column_count) {
+        cout << "Line " << line_no << ": " << values.size() << " values for " << column_count << " columns." << endl;
+        result = DB_FAILED;
+        break;
+      }
+      vector<Field> fields;
+      for (uint32_t i = 0; i < column_count && result == DB_SUCCESS; i++) {
+        const Column *column = schema->GetColumn(i);
+        if (values[i].empty() && !quoted[i]) {
+          if (!column->IsNullable()) {
+            cout << "Line " << line_no << ": column '" << column->GetName() << "' can not be null." << endl;
+            result = DB_FAILED;
+            break;
+          }
+          fields.emplace_back(column->GetType());
+          continue;
+        }
+        try {
+          size_t parsed = 0;  // stoi和stof遇到不是数字的字符就停，要检查整个字段都读完了
+          switch (column->GetType()) {
+            case kTypeInt:
+              fields.emplace_back(kTypeInt, static_cast<int32_t>(stoi(values[i], &parsed)));
+              break;
+            case kTypeFloat:
+              fields.emplace_back(kTypeFloat, stof(values[i], &parsed));
+              break;
+            case kTypeChar:
+              if (values[i].size() > column->GetLength()) throw std::out_of_range("value too long");
+              fields.emplace_back(kTypeChar, const_cast<char *>(values[i].c_str()), values[i].size(), true);
+              break;
+            default:
+              throw std::invalid_argument("unknown column type");
+          }
+          if (column->GetType() != kTypeChar && parsed != values[i].size()) {
+            throw std::invalid_argument("trailing characters");
+          }
+        } catch (const exception &) {
+          cout << "Line " << line_no << ": invalid value for column '" << column->GetName() << "'." << endl;
+          result = DB_FAILED;
+        }
+      }
+      if (result != DB_SUCCESS) break;
+      rows.emplace_back(fields);
+    }
+    if (rows.size() == LOAD_DATA_BATCH_SIZE || (eof && !rows.empty())) {
+      result = catalog->BulkInsert(table_name, rows, context->GetTransaction());
+      if (result != DB_SUCCESS) {
+        cout << "Rows " << loaded_rids.size() + 1 << " to " << loaded_rids.size() + rows.size()
+             << " not loaded, a key is duplicated or a row is too large." << endl;
+        break;
+      }
+      for (auto &row : rows) loaded_rids.push_back(row.GetRowId());
+      rows.clear();
+    }
+    if (eof) break;
+  }
+  // 整个文件要么全部导入要么都不导入
+  if (result != DB_SUCCESS && !loaded_rids.empty()) {
+    catalog->RemoveRows(table_name, loaded_rids, context->GetTransaction());
+    loaded_rids.clear();
+  }
+  auto stop_time = std::chrono::system_clock::now();
+  double duration_time =
+      double((std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time)).count());
+  cout << loaded_rids.size() << " rows loaded into '" << table_name << "' (" << duration_time / 1000 << " sec)."
+       << endl;
+  return result;
+}
@@ -14,68 +14,39 @@ SeqScanExecutor::SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode
 }
 
 void SeqScanExecutor::Init() {
+  next_page_id_=INVALID_PAGE_ID;
+  count_=0;
+  cursor_=0;
   if (exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_) != DB_SUCCESS){
     LOG(WARNING) << "Get table name fail." << endl;
     return;
   }
-  this->itr=table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction());
-//  if(exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info) != DB_SUCCESS){
-//    LOG(WARNING) << "Get table name fail.";
-//    exit(1);
-//  }
-//  iter = table_info->GetTableHeap()->Begin(exec_ctx_->GetTransaction());
+  next_page_id_=table_info_->GetTableHeap()->GetFirstPageId();
+  out_columns_.clear();
+  for(auto column:plan_->OutputSchema()->GetColumns())
+    out_columns_.push_back(column->GetTableInd());
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
-  TableHeap* table_heap=table_info_->GetTableHeap();
-  if(itr==table_heap->End())
-    return false;
-  Row tmp=*itr;
-  if(plan_->GetPredicate()!=nullptr){
-    for(;itr!=table_heap->End();itr++){
-      tmp=*itr;
-      Field field=plan_->GetPredicate()->Evaluate(&tmp);
-      if(field.CompareEquals(Field(kTypeInt,1)))//equal
-        break;
-    }
+  //这一页的结果取完了就扫下一页，直到有结果或者扫完
+  while(cursor_>=count_){
+    if(next_page_id_==INVALID_PAGE_ID)
+      return false;
+    count_=0;
+    cursor_=0;
+    const AbstractExpression *predicate=plan_->GetPredicate().get();
+    next_page_id_=table_info_->GetTableHeap()->ScanPage(next_page_id_,[&](const RowView &view){
+      if(predicate!=nullptr&&predicate->Evaluate(&view).CompareEquals(Field(kTypeInt,1))!=CmpBool::kTrue)
+        return;
+      if(count_==rows_.size()) rows_.emplace_back();
+      view.ToRow(&rows_[count_++],out_columns_);//页要放开了，只拷出输出列
+    },&ring_,&read_ahead_);
   }
-  if(itr==table_heap->End())return false;//没有了
-  vector<Field> fields;
-  const Schema* schema=plan_->OutputSchema();
-  for(auto column:schema->GetColumns())
-//    for(auto original_column:table_info_->GetSchema()->GetColumns())
-//      if(column->GetName()==original_column->GetName())
-        fields.push_back(*tmp.GetField(column->GetTableInd()));
-  *row=Row(fields);
-  *rid=RowId(tmp.GetRowId());
-  itr++;
+  //字段直接换给调用者，不再拷贝一遍
+  Row &tmp=rows_[cursor_++];
+  row->destroy();
+  row->GetFields().swap(tmp.GetFields());
+  row->SetRowId(tmp.GetRowId());
+  *rid=tmp.GetRowId();
   return true;
-//  Row temp_row;
-//  TableHeap *table_heap = table_info->GetTableHeap();
-//  if(plan_->GetPredicate() != nullptr){
-//    for(; iter != table_heap->End(); iter++) {
-//      temp_row = *iter
-//      Field field = plan_->GetPredicate()->Evaluate(&temp_row);
-//      if (field.CompareEquals(Field(kTypeInt, 1))) {
-//        break;
-//      }
-//    }
-//  }
-//
-//  if(iter == table_heap->End()){
-//    //    iter = table_heap->Begin(exec_ctx_->GetTransaction());
-//    return false;
-//  }
-//  vector<Field> fields;
-//  const Schema *schema = plan_->OutputSchema();
-//  for(auto column: schema->GetColumns())
-//    for(auto old_column: table_info->GetSchema()->GetColumns()){
-//      if(column->GetName() == old_column->GetName())
-//        fields.push_back(*temp_row.GetField(old_column->GetTableInd()));
-//    }
-//
-//  *row = Row(fields);
-//  *rid = RowId(temp_row.GetRowId());
-//  iter++;
-//  return true;
 }
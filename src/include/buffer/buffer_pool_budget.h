@@ -0,0 +1,70 @@
+#ifndef MINISQL_BUFFER_POOL_BUDGET_H
+#define MINISQL_BUFFER_POOL_BUDGET_H
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * BufferPoolBudget shares a fixed number of frames among the buffer pools of all open databases.
+ *
+ * Every registered pool is guaranteed its minimum. The frames left over are handed out in proportion to how many
+ * pages each pool accessed recently, smoothed over several rounds, so a busy database grows at the expense of idle
+ * ones and gives the frames back once its load moves elsewhere. Pools are resized online, see
+ * BufferPoolManager::Resize. A pool only needs to be created with its initial frames, the budget raises its max pool
+ * size when it grants it more.
+ */
+class BufferPoolBudget {
+ public:
+  /**
+   * @param total_frames number of frames shared by all registered pools
+   * @param interval minimum time between two rebalances that are not forced
+   */
+  explicit BufferPoolBudget(size_t total_frames, std::chrono::milliseconds interval =
+                                                     std::chrono::milliseconds(BUFFER_POOL_REBALANCE_INTERVAL_MS));
+
+  /** @return the number of frames shared by all registered pools */
+  size_t GetTotalFrames() const { return total_frames_; }
+
+  /**
+   * Frames a newly opened pool should start with: its fair share of the budget, at least min_frames.
+   * The budget is only restored by the rebalance that follows its registration.
+   */
+  size_t GetInitialFrames(size_t min_frames);
+
+  /** Start sharing the budget with bpm, which keeps at least min_frames frames. Rebalances at once. */
+  void Register(BufferPoolManager *bpm, size_t min_frames);
+
+  /** Stop sharing the budget with bpm, its frames go to the other pools. Rebalances at once. */
+  void Unregister(BufferPoolManager *bpm);
+
+  /**
+   * Move frames from idle pools to busy ones. Pools are shrunk before others are grown and only grow into frames no
+   * other pool holds, so the total stays within the budget. Changes below a small threshold are skipped so that
+   * pools do not churn.
+   * @param force rebalance even if the last rebalance is more recent than the interval
+   * @return false if the rebalance was skipped
+   */
+  bool Rebalance(bool force = false);
+
+ private:
+  struct Pool {
+    BufferPoolManager *bpm_;
+    size_t min_frames_;
+    size_t last_accesses_;  // hits and misses at the last rebalance
+    double load_;           // moving average of the accesses per rebalance
+  };
+
+  void RebalanceLocked();
+
+ private:
+  const size_t total_frames_;
+  const std::chrono::milliseconds interval_;
+  std::chrono::steady_clock::time_point last_rebalance_;
+  std::vector<Pool> pools_;
+  std::mutex latch_;
+};
+
+#endif  // MINISQL_BUFFER_POOL_BUDGET_H
@@ -1,58 +1,241 @@
 #ifndef MINISQL_BUFFER_POOL_MANAGER_H
 #define MINISQL_BUFFER_POOL_MANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "buffer/lru_replacer.h"
+#include "buffer/buffer_ring.h"
+#include "buffer/compressed_page_cache.h"
+#include "buffer/page_class_replacer.h"
 #include "page/disk_file_meta_page.h"
 #include "page/page.h"
 #include "storage/disk_manager.h"
 
 using namespace std;
 
+/**
+ * BufferPoolManager is the interface through which the rest of the system reaches pages. It is implemented by
+ * BufferPoolManagerInstance, which caches pages in its own frames, ParallelBufferPoolManager, which spreads page ids
+ * over several instances, and MappedBufferPoolManager, which serves a read-only file from a memory mapping.
+ *
+ * The helpers every implementation shares live here and work through the protected hooks:
+ *
+ * An optional background writer thread writes dirty unpinned frames ahead of the replacer's victim order, so that
+ * FetchPage and NewPage usually find a clean victim and do not have to write it back on the query's critical path.
+ *
+ * Scans that follow a chain of pages (table heap pages, B+ tree leaves) may ask for read-ahead: a helper thread
+ * walks the chain ahead of the scan and brings the next pages in, so the scan finds them cached.
+ *
+ * With warm start enabled, the pool saves its resident page ids in replacement order to a sidecar file on shutdown
+ * and reloads them on the next start, so the hot set does not have to fault back in one page at a time.
+ *
+ * Implementations must stop the helper threads in their own destructor, the threads call back into them.
+ */
 class BufferPoolManager {
  public:
-  explicit BufferPoolManager(size_t pool_size, DiskManager *disk_manager);
+  virtual ~BufferPoolManager();
 
-  ~BufferPoolManager();
+  /**
+   * Fetch a page and pin it.
+   * @param ring access strategy of a bulk read, a miss recycles the frame of the oldest ring page if possible
+   * @return nullptr if the page is not resident and all frames are pinned
+   */
+  virtual Page *FetchPage(page_id_t page_id, BufferRing *ring = nullptr) = 0;
+
+  /**
+   * Fetch and pin several pages with a single latch acquisition, the misses are read from disk as one batch.
+   * @return the pages in the order of page_ids, nullptr for those that could not be brought in
+   */
+  virtual std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) = 0;
+
+  virtual bool UnpinPage(page_id_t page_id, bool is_dirty) = 0;
+
+  virtual bool FlushPage(page_id_t page_id) = 0;
 
-  Page *FetchPage(page_id_t page_id);
+  /**
+   * Checkpoint: write all dirty pages as one batch, in file order with adjacent pages merged into one write, then
+   * sync the file once.
+   * @return false on an I/O error, pages that may not have been written stay dirty
+   */
+  virtual bool FlushAllPages() = 0;
 
-  bool UnpinPage(page_id_t page_id, bool is_dirty);
+  /**
+   * Allocate a new page and pin it.
+   * @param near_page_id a page of the same object, the new page is placed physically close after it (see
+   * DiskManager::AllocatePage), INVALID_PAGE_ID to take any free page
+   */
+  virtual Page *NewPage(page_id_t &page_id, page_id_t near_page_id = INVALID_PAGE_ID) = 0;
 
-  bool FlushPage(page_id_t page_id);
+  virtual bool DeletePage(page_id_t page_id) = 0;
 
-  Page *NewPage(page_id_t &page_id);
+  virtual bool IsPageFree(page_id_t page_id);
 
-  bool DeletePage(page_id_t page_id);
+  virtual bool CheckAllUnpinned() = 0;
 
-  bool IsPageFree(page_id_t page_id);
+  /** @return the number of frames managed by this buffer pool */
+  virtual size_t GetPoolSize() = 0;
 
-  bool CheckAllUnpinned();
+  /** @return true if pages must not be modified, see MappedBufferPoolManager */
+  virtual bool IsReadOnly() { return false; }
+
+  /** @return the largest size this buffer pool can be resized to */
+  virtual size_t GetMaxPoolSize() = 0;
+
+  /**
+   * Change the largest size this buffer pool can be resized to. Nothing is allocated until the pool grows, and a
+   * max pool size below the current size does not shrink the pool, only later resizes are clamped to it.
+   */
+  virtual void SetMaxPoolSize(size_t max_pool_size) = 0;
+
+  /**
+   * Grow or shrink the pool without blocking it for longer than the write back of the evicted dirty frames.
+   * Unpinned frames beyond the new size are evicted at once, pinned ones when their last pin is released.
+   * @param pool_size requested number of frames, clamped to [1, max pool size]
+   * @return the new number of frames
+   */
+  virtual size_t Resize(size_t pool_size) = 0;
+
+  /** @return the number of FetchPage calls served from memory */
+  virtual size_t GetHitCount() = 0;
+
+  /** @return the number of FetchPage calls that had to read from disk */
+  virtual size_t GetMissCount() = 0;
+
+  /** @return the number of dirty victims FetchPage and NewPage had to write back themselves */
+  virtual size_t GetSyncWriteCount() = 0;
+
+  /** @return the number of dirty pages written by the background writer */
+  virtual size_t GetBackgroundWriteCount() = 0;
+
+  /** @return the number of resident pages of a class, a page counts under its tag once it has been unpinned */
+  virtual size_t GetResidentPageCount(PageClass page_class) = 0;
+
+  /** @return the number of pages of a class evicted to make room for other pages */
+  virtual size_t GetEvictionCount(PageClass page_class) = 0;
+
+  /**
+   * Keep compressed copies of pages evicted by the replacer and look there before reading a missed page from disk.
+   * Pages evicted through a BufferRing are not kept, a bulk read would only flush the cache.
+   * @param capacity bytes of compressed pages to keep, 0 turns the cache off
+   */
+  virtual void EnableCompressedCache(size_t capacity) = 0;
+
+  /** @return the counters of the compressed page cache, all zero if it is off */
+  virtual CompressedCacheStats GetCompressedCacheStats() = 0;
+
+  /**
+   * Start the background writer. Every interval it looks at the next clean_target victims of the replacer and
+   * writes back those that are dirty. Free frames count towards the target.
+   * @param clean_target number of frames kept clean ahead of the replacer, per instance
+   * @param interval time between two rounds
+   */
+  void StartBackgroundWriter(size_t clean_target = DEFAULT_BG_WRITER_CLEAN_TARGET,
+                             std::chrono::milliseconds interval =
+                                 std::chrono::milliseconds(DEFAULT_BG_WRITER_INTERVAL_MS));
+
+  /** Stop the background writer and wait for its in-flight writes. Safe to call if it is not running. */
+  void StopBackgroundWriter();
+
+  /** Reads the id of the page that follows page in its chain, INVALID_PAGE_ID at the end */
+  using NextPageFn = page_id_t (*)(Page *page);
+
+  /**
+   * Bring the count pages that follow page_id in its chain into the pool, on a helper thread started on first use.
+   * The prefetched pages are left unpinned and recycle a private ring of frames, so read-ahead never occupies more
+   * than a few dozen frames of the pool.
+   * @param next_page how to follow the chain
+   */
+  void ReadAhead(page_id_t page_id, NextPageFn next_page, size_t count = READ_AHEAD_PAGES);
+
+  /**
+   * Reload the pages listed in file_name, if it exists, and save the resident pages to it again on destruction.
+   * Call it before the pool is used.
+   * @return the number of pages reloaded
+   */
+  size_t EnableWarmStart(const std::string &file_name);
+
+  /**
+   * Write the ids of all resident pages to file_name, from the next victim to the most recently used page.
+   * @return false if the file cannot be written
+   */
+  bool SaveResidentPages(const std::string &file_name);
+
+  /**
+   * Bring the pages listed in file_name into free frames, reading runs of consecutive page ids at once, and restore
+   * their replacement order. If there are more pages than free frames, the hottest ones are kept.
+   * @return the number of pages loaded
+   */
+  size_t LoadResidentPages(const std::string &file_name);
+
+ protected:
+  explicit BufferPoolManager(DiskManager *disk_manager);
+
+  /**
+   * One round of the background writer: copy the dirty pages among the next clean_target victims under the latch,
+   * then write them without holding it.
+   * @return the number of pages written
+   */
+  virtual size_t BackgroundWriterStep(size_t clean_target) = 0;
+
+  /** @return the resident pages from the next victim to the most recently used one, pinned pages last */
+  virtual std::vector<page_id_t> GetResidentPages() = 0;
+
+  /**
+   * Load pages into free frames without pinning them, page_ids ordered from cold to hot.
+   * @return the number of pages loaded
+   */
+  virtual size_t LoadPages(const std::vector<page_id_t> &page_ids) = 0;
+
+  /** Stop the read-ahead helper, pending requests are dropped. Safe to call if it is not running. */
+  void StopReadAhead();
 
- private:
   /**
    * Allocate new page (operations like create index/table) For now just keep an increasing counter
    */
-  page_id_t AllocatePage();
+  page_id_t AllocatePage(page_id_t near_page_id = INVALID_PAGE_ID);
 
   /**
    * Deallocate page (operations like drop index/table) Need bitmap in header page for tracking pages
    */
   void DeallocatePage(page_id_t page_id);
 
-  frame_id_t TryToFindFreePage();
+ protected:
+  DiskManager *disk_manager_;    // pointer to the disk manager.
+  std::string warm_start_file_;  // resident pages are saved here on destruction
 
  private:
-  size_t pool_size_;                                 // number of pages in buffer pool
-  Page *pages_;                                      // array of pages
-  DiskManager *disk_manager_;                        // pointer to the disk manager.
-  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
-  Replacer *replacer_;                               // to find an unpinned page for replacement
-  list<frame_id_t> free_list_;                       // to find a free page for replacement
-  recursive_mutex latch_;                            // to protect shared data structure
+  struct ReadAheadRequest {
+    page_id_t page_id_;
+    NextPageFn next_page_;
+    size_t count_;
+  };
+
+  void BackgroundWriterLoop(size_t clean_target, std::chrono::milliseconds interval);
+
+  void ReadAheadLoop();
+
+  thread bg_writer_;
+  mutex bg_writer_latch_;
+  condition_variable bg_writer_cv_;
+  bool bg_writer_stop_{false};
+
+  thread read_ahead_thread_;
+  mutex read_ahead_latch_;  // protects the queue and the stop flag
+  condition_variable read_ahead_cv_;
+  deque<ReadAheadRequest> read_ahead_queue_;
+  bool read_ahead_stop_{false};
+  BufferRing read_ahead_ring_{2 * READ_AHEAD_PAGES};  // only used by the helper thread
 };
 
 #endif  // MINISQL_BUFFER_POOL_MANAGER_H
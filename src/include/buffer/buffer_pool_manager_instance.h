@@ -0,0 +1,223 @@
+#ifndef MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+#define MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * BufferPoolManagerInstance caches disk pages in a fixed number of in-memory frames.
+ *
+ * All public operations are serialized by the instance latch, so a single instance may be shared by several query
+ * threads. To scale across cores, use ParallelBufferPoolManager, which spreads page ids over several independent
+ * instances.
+ *
+ * Nothing waits for the background writer while holding the latch: a page whose write is in flight is read back from
+ * the writer's copy, and a newer version evicted meanwhile is handed to the writer to write after the older one.
+ *
+ * Page data lives in page-aligned arenas, backed by huge pages when the system provides them, while frames_ only
+ * holds the frame metadata. Aligned frames also allow the disk manager to use O_DIRECT.
+ *
+ * A pool created with a max_pool_size above pool_size can be resized online between the two, and the max pool size
+ * can be raised later, e.g. by a BufferPoolBudget. Frames are only created when the pool first grows over them, each
+ * growth mapping one more arena, so frame ids and page addresses never move and a pool pays for the frames it has
+ * held rather than for its max pool size; shrinking evicts the frames beyond the new size and gives their memory back
+ * to the system, pinned ones as soon as they are unpinned.
+ *
+ * Callers may tag pages with a PageClass (see Page::SetPageClass). Victims are taken from heap pages first, so the
+ * upper levels of an index stay resident while large tables are scanned; see PageClassReplacer.
+ *
+ * An optional CompressedPageCache keeps compressed copies of evicted pages in memory, so a working set somewhat
+ * larger than the pool is served without disk reads.
+ *
+ * The background writer, FetchPages and FlushAllPages hand their pages to the disk manager as one batch, which keeps
+ * many I/Os in flight at once (see AsyncIO).
+ */
+class BufferPoolManagerInstance : public BufferPoolManager {
+  friend class ParallelBufferPoolManager;
+
+ public:
+  /**
+   * @param pool_size number of frames of the buffer pool, at least one
+   * @param replacer_type replacement policy used to pick victim frames
+   * @param max_pool_size largest size the pool may be resized to, 0 for a fixed size pool
+   */
+  explicit BufferPoolManagerInstance(size_t pool_size, DiskManager *disk_manager,
+                                     ReplacerType replacer_type = ReplacerType::kLRU, size_t max_pool_size = 0);
+
+  ~BufferPoolManagerInstance() override;
+
+  Page *FetchPage(page_id_t page_id, BufferRing *ring = nullptr) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  bool FlushAllPages() override;
+
+  Page *NewPage(page_id_t &page_id, page_id_t near_page_id = INVALID_PAGE_ID) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  size_t GetPoolSize() override {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    return pool_size_;
+  }
+
+  size_t GetMaxPoolSize() override {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    return max_pool_size_;
+  }
+
+  void SetMaxPoolSize(size_t max_pool_size) override {
+    std::scoped_lock<std::recursive_mutex> lock(latch_);
+    max_pool_size_ = max_pool_size;
+  }
+
+  size_t Resize(size_t pool_size) override;
+
+  size_t GetHitCount() override;
+
+  size_t GetMissCount() override;
+
+  size_t GetSyncWriteCount() override;
+
+  size_t GetBackgroundWriteCount() override;
+
+  size_t GetResidentPageCount(PageClass page_class) override;
+
+  size_t GetEvictionCount(PageClass page_class) override;
+
+  void EnableCompressedCache(size_t capacity) override;
+
+  CompressedCacheStats GetCompressedCacheStats() override;
+
+ protected:
+  size_t BackgroundWriterStep(size_t clean_target) override;
+
+  std::vector<page_id_t> GetResidentPages() override;
+
+  size_t LoadPages(const std::vector<page_id_t> &page_ids) override;
+
+ private:
+  /**
+   * Bring a freshly allocated page into a frame, the caller must have allocated page_id from the disk manager. A copy
+   * of page_id that is still resident, e.g. read ahead after the page was deleted, is reset and taken over.
+   * @return nullptr if all frames are pinned
+   */
+  Page *NewPageWithId(page_id_t page_id);
+
+  /**
+   * Find a frame for a new page, either from the free list or the replacer. A dirty victim is written back and
+   * removed from the page table.
+   * @return INVALID_FRAME_ID if all frames are pinned
+   */
+  frame_id_t TryToFindFreePage();
+
+  /**
+   * Take back the frame of the oldest page of a ring, so that a bulk read does not evict the shared pool.
+   * @return INVALID_FRAME_ID if that page is no longer resident in this instance or is pinned
+   */
+  frame_id_t TryToReuseRingFrame(BufferRing *ring);
+
+  /**
+   * FetchPage without taking the latch, the caller must hold it.
+   * @param reads if not null, a page that has to be read from disk is added here instead of read right away
+   */
+  Page *FetchPageLocked(page_id_t page_id, BufferRing *ring,
+                        std::vector<std::pair<page_id_t, char *>> *reads = nullptr);
+
+  /**
+   * Write all dirty pages as one batch, without syncing.
+   * @return false on an I/O error, the pages stay dirty
+   */
+  bool WriteDirtyPages();
+
+  /**
+   * Add the dirty pages of this instance to writes, the caller must hold the latch and keep it until the pages are
+   * written and marked clean. No background write may be in flight, see WaitForFlush.
+   */
+  void CollectDirtyPages(std::vector<std::pair<page_id_t, const char *>> *writes);
+
+  /** Mark the frames of this instance among writes clean once they are on disk, the caller holds the latch */
+  void MarkClean(const std::vector<std::pair<page_id_t, const char *>> &writes);
+
+  /**
+   * Write back a dirty frame that is about to hold another page and drop its old page from the page table. If the
+   * background writer is writing the page, the frame is copied to deferred_writes_ instead of waiting for it.
+   */
+  void EvictFrame(frame_id_t frame_id);
+
+  /**
+   * Create count more frames in a new arena, their ids follow the existing frames. The caller holds the latch.
+   * @param resizable the frames may be retired by a shrink, see AllocateArena
+   */
+  void AddFrames(size_t count, bool resizable);
+
+  /** Evict an unpinned frame beyond the pool size and release its memory, the frame is not reused until regrown */
+  void RetireFrame(frame_id_t frame_id);
+
+  /**
+   * Block until the background writer has no write of page_id in flight. Must be called without holding the latch:
+   * the writer may start again before the caller takes it, so check IsFlushing under the latch and retry.
+   * @param page_id INVALID_PAGE_ID to wait until no write is in flight at all
+   */
+  void WaitForFlush(page_id_t page_id);
+
+  /** @return true if a write of page_id, or any page for INVALID_PAGE_ID, is in flight */
+  bool IsFlushing(page_id_t page_id);
+
+  /** @return true if a background write of page_id failed since the frame was marked clean, and forget it */
+  bool TakeFailedFlush(page_id_t page_id);
+
+  /**
+   * Fill a frame with the newest copy of a page that is not on disk yet: a deferred write or the copy the background
+   * writer is writing. The frame is marked dirty, as the copy may never reach the disk otherwise.
+   * @return false if the disk copy is current
+   */
+  bool ReadUnwrittenCopy(page_id_t page_id, Page *frame);
+
+  /** Write the deferred copy of a page that is not resident, @return false if there was none */
+  bool WriteDeferredCopy(page_id_t page_id);
+
+  /** Forget the unwritten copies of a deleted page, they must not overwrite the page once it is reused */
+  void DropUnwrittenCopies(page_id_t page_id);
+
+ private:
+  size_t pool_size_;                                 // number of pages in buffer pool
+  size_t max_pool_size_;                             // largest size the pool may be resized to
+  std::vector<Page *> frames_;                       // metadata of the frames created so far, by frame id
+  std::vector<std::pair<char *, size_t>> arenas_;    // page data of the frames and its mapped size, one per growth
+  unordered_map<page_id_t, frame_id_t> page_table_;  // to keep track of pages
+  PageClassReplacer *replacer_;                      // to find an unpinned page for replacement
+  list<frame_id_t> free_list_;                       // to find a free page for replacement
+  recursive_mutex latch_;                            // to protect shared data structure
+  size_t hit_count_{0};                              // FetchPage calls served from memory
+  size_t miss_count_{0};                             // FetchPage calls served from disk
+  size_t sync_write_count_{0};                       // dirty victims written on the eviction path
+
+  // compressed copies of evicted pages, never holds a resident page
+  std::unique_ptr<CompressedPageCache> compressed_cache_;
+
+  // pages the background writer is writing and the copy it writes, the disk copy of these is stale
+  unordered_map<page_id_t, const char *> flushing_;
+  // newer copies of pages evicted while they were in flight, written by the background writer after the older copy
+  unordered_map<page_id_t, unique_ptr<char[]>> deferred_writes_;
+  // pages the background writer marked clean but could not write, reported once by TakeFailedFlush
+  unordered_set<page_id_t> failed_flushes_;
+  mutex flush_latch_;  // protects the three above, taken after latch_ or alone
+  condition_variable flush_cv_;
+  atomic<size_t> background_write_count_{0};
+};
+
+#endif  // MINISQL_BUFFER_POOL_MANAGER_INSTANCE_H
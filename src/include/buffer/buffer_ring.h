@@ -0,0 +1,39 @@
+#ifndef MINISQL_BUFFER_RING_H
+#define MINISQL_BUFFER_RING_H
+
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * BufferRing is the access strategy of a bulk read, such as a sequential scan over a table larger than the pool.
+ *
+ * The ring remembers the last few pages the bulk read brought in. When the read misses again, the buffer pool
+ * recycles the frame of the oldest ring page, if it is still resident and unpinned, instead of evicting a frame
+ * of the shared pool. A large scan therefore only ever occupies about ring size frames and leaves the rest of the
+ * pool untouched. Pages that were already cached are used in place and never become part of the ring.
+ *
+ * A ring belongs to a single scan and is not thread-safe.
+ */
+class BufferRing {
+ public:
+  explicit BufferRing(size_t size = BUFFER_RING_SIZE) : slots_(size, INVALID_PAGE_ID) {}
+
+  /** @return the page whose frame is recycled by the next miss, INVALID_PAGE_ID while the ring is filling up */
+  page_id_t Current() const { return slots_[cursor_]; }
+
+  /** Record page_id as the page held by the current slot and move on to the next slot */
+  void Push(page_id_t page_id) {
+    slots_[cursor_] = page_id;
+    cursor_ = (cursor_ + 1) % slots_.size();
+  }
+
+  /** @return the number of slots in the ring */
+  size_t Size() const { return slots_.size(); }
+
+ private:
+  std::vector<page_id_t> slots_;
+  size_t cursor_{0};
+};
+
+#endif  // MINISQL_BUFFER_RING_H
@@ -16,6 +16,9 @@ using namespace std;
 
 /**
  * CLOCKReplacer implements the clock replacement.
+ *
+ * The clock hand sweeps over all frames. An evictable frame with its reference bit set gets a second chance: the bit
+ * is cleared and the hand moves on. The first evictable frame found with a cleared bit is the victim.
  */
 class CLOCKReplacer : public Replacer {
  public:
@@ -36,12 +39,18 @@ class CLOCKReplacer : public Replacer {
 
   void Unpin(frame_id_t frame_id) override;
 
+  void GetVictimCandidates(size_t count, vector<frame_id_t> *frames) override;
+
+  void Grow(size_t num_pages) override;
+
   size_t Size() override;
 
  private:
   size_t capacity;
-  list<frame_id_t> clock_list;               // replacer中可以被替换的数据页
-  map<frame_id_t, frame_id_t> clock_status;  // 数据页的存储状态
+  size_t clock_hand_{0};       // next frame the hand looks at
+  size_t size_{0};             // number of evictable frames
+  vector<bool> evictable_;     // replacer中可以被替换的数据页
+  vector<bool> reference_;     // 数据页的引用位
 };
 
 #endif  // MINISQL_CLOCK_REPLACER_H
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef MINISQL_COMPRESSED_PAGE_CACHE_H
+#define MINISQL_COMPRESSED_PAGE_CACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "common/config.h"
+
+/**
+ * Counters of a compressed page cache.
+ */
+struct CompressedCacheStats {
+  size_t hits_{0};              // lookups answered from the cache
+  size_t misses_{0};            // lookups that had to go to disk
+  size_t rejected_{0};          // pages not stored because they did not compress well enough
+  size_t pages_{0};             // pages currently stored
+  size_t compressed_bytes_{0};  // bytes currently used by the stored pages
+
+  /** @return the fraction of lookups answered from the cache */
+  double HitRate() const { return hits_ + misses_ == 0 ? 0 : static_cast<double>(hits_) / (hits_ + misses_); }
+
+  /** @return uncompressed size over compressed size of the stored pages */
+  double CompressionRatio() const {
+    return compressed_bytes_ == 0 ? 0 : static_cast<double>(pages_) * PAGE_SIZE / compressed_bytes_;
+  }
+
+  CompressedCacheStats &operator+=(const CompressedCacheStats &other) {
+    hits_ += other.hits_;
+    misses_ += other.misses_;
+    rejected_ += other.rejected_;
+    pages_ += other.pages_;
+    compressed_bytes_ += other.compressed_bytes_;
+    return *this;
+  }
+};
+
+/**
+ * CompressedPageCache is a second cache level between the buffer pool and the disk. Clean pages evicted from the
+ * buffer pool are compressed with LZCodec and kept in memory up to a byte budget, least recently stored pages are
+ * dropped first. A later miss of the buffer pool looks here before reading from disk.
+ *
+ * The cache only holds pages that are not in the buffer pool: a page is taken out when it is fetched back, and the
+ * buffer pool must Erase a page whose disk copy changes by other means, e.g. when it is deleted. It is not
+ * thread-safe, the buffer pool calls it under its latch.
+ */
+class CompressedPageCache {
+ public:
+  /** @param capacity bytes of compressed data the cache may hold */
+  explicit CompressedPageCache(size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * Store a copy of a clean page, replacing any older copy. Pages that save less than an eighth of their size are
+   * not stored.
+   * @return true if the page was stored
+   */
+  bool Put(page_id_t page_id, const char *page_data);
+
+  /**
+   * Take a page out of the cache.
+   * @param[out] page_data receives PAGE_SIZE bytes of page data
+   * @return false if the page is not cached
+   */
+  bool Get(page_id_t page_id, char *page_data);
+
+  /** Drop the copy of a page, if any */
+  void Erase(page_id_t page_id);
+
+  /** @return the counters of the cache */
+  CompressedCacheStats GetStats() const { return stats_; }
+
+ private:
+  struct Entry {
+    page_id_t page_id_;
+    std::string data_;
+  };
+
+  void EraseEntry(std::list<Entry>::iterator it);
+
+ private:
+  size_t capacity_;
+  std::list<Entry> entries_;  // most recently stored first
+  std::unordered_map<page_id_t, std::list<Entry>::iterator> index_;
+  CompressedCacheStats stats_;
+  char buffer_[PAGE_SIZE];  // compression output
+};
+
+#endif  // MINISQL_COMPRESSED_PAGE_CACHE_H
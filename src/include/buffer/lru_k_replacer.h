@@ -0,0 +1,71 @@
+#ifndef MINISQL_LRU_K_REPLACER_H
+#define MINISQL_LRU_K_REPLACER_H
+
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "common/config.h"
+
+using namespace std;
+
+/**
+ * LRUKReplacer implements the LRU-K replacement policy.
+ *
+ * Every pin of a frame counts as an access, and the replacer keeps the timestamps of the last K accesses of each
+ * frame. The victim is the evictable frame whose K-th most recent access lies furthest in the past (its backward
+ * K-distance is the largest). Frames with fewer than K accesses have an infinite K-distance and are evicted first,
+ * in order of their earliest access. A frame touched once by a sequential scan therefore never pushes out a frame
+ * that is looked up repeatedly.
+ */
+class LRUKReplacer : public Replacer {
+ public:
+  /**
+   * Create a new LRUKReplacer.
+   * @param num_pages the maximum number of pages the LRUKReplacer will be required to store
+   * @param k the number of accesses tracked per frame
+   */
+  explicit LRUKReplacer(size_t num_pages, size_t k = DEFAULT_LRU_K);
+
+  /**
+   * Destroys the LRUKReplacer.
+   */
+  ~LRUKReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void GetVictimCandidates(size_t count, vector<frame_id_t> *frames) override;
+
+  size_t Size() override;
+
+ private:
+  /** (has fewer than k accesses ? 0 : 1, timestamp deciding the order within the group) */
+  using EvictKey = pair<int, uint64_t>;
+
+  struct FrameHistory {
+    deque<uint64_t> accesses_;  // the last k access timestamps, oldest first
+    bool evictable_{false};
+  };
+
+  /** Append an access to the history of frame_id */
+  void RecordAccess(FrameHistory &history);
+
+  EvictKey GetEvictKey(const FrameHistory &history) const;
+
+ private:
+  size_t k_;
+  uint64_t current_timestamp_{0};
+  unordered_map<frame_id_t, FrameHistory> histories_;
+  set<pair<EvictKey, frame_id_t>> evictable_frames_;  // ordered by eviction priority
+};
+
+#endif  // MINISQL_LRU_K_REPLACER_H
@@ -3,6 +3,7 @@
 
 #include <list>
 #include <mutex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <algorithm>
@@ -34,6 +35,8 @@ class LRUReplacer : public Replacer {
 
   void Unpin(frame_id_t frame_id) override;
 
+  void GetVictimCandidates(size_t count, vector<frame_id_t> *frames) override;
+
   size_t Size() override;
 
 private:
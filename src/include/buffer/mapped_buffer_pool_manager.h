@@ -0,0 +1,87 @@
+#ifndef MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
+#define MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * MappedBufferPoolManager serves a database file opened read-only, e.g. a reporting replica that never changes.
+ *
+ * The disk manager maps the whole file into memory, and every page id has a fixed Page whose data points straight
+ * into the mapping, created the first time the page is fetched. After that FetchPage is an array lookup: no frame is
+ * filled, nothing is ever evicted, and pins are not counted, the operating system pages the mapping in and out
+ * instead.
+ *
+ * The mapping is read-only. NewPage, DeletePage and unpinning a page as dirty fail, and writing into a page's data
+ * faults; the catalog, table heaps and B+ trees check IsReadOnly and reject their write operations up front.
+ */
+class MappedBufferPoolManager : public BufferPoolManager {
+ public:
+  /** @param disk_manager a read-only disk manager */
+  explicit MappedBufferPoolManager(DiskManager *disk_manager);
+
+  ~MappedBufferPoolManager() override;
+
+  /** @return the mapped page, nullptr for a page id beyond the extents of the file */
+  Page *FetchPage(page_id_t page_id, BufferRing *ring = nullptr) override;
+
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  /** @return false if is_dirty is set, the page can not have been modified */
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  bool FlushAllPages() override { return true; }
+
+  Page *NewPage(page_id_t &page_id, page_id_t near_page_id = INVALID_PAGE_ID) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override { return true; }
+
+  bool IsReadOnly() override { return true; }
+
+  /** @return 0, the pool owns no frame */
+  size_t GetPoolSize() override { return 0; }
+
+  size_t GetMaxPoolSize() override { return 0; }
+
+  void SetMaxPoolSize(size_t /*max_pool_size*/) override {}
+
+  size_t Resize(size_t /*pool_size*/) override { return 0; }
+
+  size_t GetHitCount() override { return 0; }
+
+  size_t GetMissCount() override { return 0; }
+
+  size_t GetSyncWriteCount() override { return 0; }
+
+  size_t GetBackgroundWriteCount() override { return 0; }
+
+  size_t GetResidentPageCount(PageClass /*page_class*/) override { return 0; }
+
+  size_t GetEvictionCount(PageClass /*page_class*/) override { return 0; }
+
+  void EnableCompressedCache(size_t /*capacity*/) override {}
+
+  CompressedCacheStats GetCompressedCacheStats() override { return {}; }
+
+ protected:
+  size_t BackgroundWriterStep(size_t /*clean_target*/) override { return 0; }
+
+  std::vector<page_id_t> GetResidentPages() override { return {}; }
+
+  size_t LoadPages(const std::vector<page_id_t> & /*page_ids*/) override { return 0; }
+
+ private:
+  std::unique_ptr<std::atomic<Page *>[]> mapped_pages_;  // Page of every page id, nullptr until first fetched
+  size_t num_pages_;
+  std::mutex latch_;  // serializes the first fetch of a page
+};
+
+#endif  // MINISQL_MAPPED_BUFFER_POOL_MANAGER_H
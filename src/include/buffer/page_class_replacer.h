@@ -0,0 +1,79 @@
+#ifndef MINISQL_PAGE_CLASS_REPLACER_H
+#define MINISQL_PAGE_CLASS_REPLACER_H
+
+#include <vector>
+
+#include "buffer/replacer.h"
+#include "page/page.h"
+
+using namespace std;
+
+/**
+ * PageClassReplacer keeps one replacer of the configured policy per page class and decides which class gives up
+ * the next victim.
+ *
+ * Classes are drained in the order heap, index leaf, meta, index internal, so that a scan over a large table evicts
+ * its own pages before a single B+ tree level. Every class but heap is only protected up to a share of the pool: a
+ * class holding more resident frames than its share is evicted from first, so that neither leaves nor meta data can
+ * take over the whole pool.
+ *
+ * Frames count as heap frames until SetFrameClass moves them, their class is forgotten when they are victimized or
+ * removed.
+ */
+class PageClassReplacer : public Replacer {
+ public:
+  /**
+   * @param type replacement policy used within each class
+   * @param num_pages the maximum number of frames the replacer will be required to store
+   */
+  PageClassReplacer(ReplacerType type, size_t num_pages);
+
+  ~PageClassReplacer() override;
+
+  bool Victim(frame_id_t *frame_id) override;
+
+  void Pin(frame_id_t frame_id) override;
+
+  void Unpin(frame_id_t frame_id) override;
+
+  void Remove(frame_id_t frame_id) override;
+
+  void GetVictimCandidates(size_t count, std::vector<frame_id_t> *frames) override;
+
+  size_t Size() override;
+
+  void Grow(size_t num_pages) override;
+
+  /**
+   * File a resident frame under another class. The frame must not be evictable, i.e. call it before Unpin.
+   * Changing the class restarts the frame's history in its new class.
+   */
+  void SetFrameClass(frame_id_t frame_id, PageClass page_class);
+
+  /** Set the number of frames the class shares are computed from, e.g. after the buffer pool was resized */
+  void SetCapacity(size_t capacity) { capacity_ = capacity; }
+
+  /** @return the number of resident frames of a class, pinned or not */
+  size_t GetResidentCount(PageClass page_class) const { return resident_[static_cast<size_t>(page_class)]; }
+
+  /** @return the number of frames of a class handed out by Victim */
+  size_t GetEvictionCount(PageClass page_class) const { return evictions_[static_cast<size_t>(page_class)]; }
+
+ private:
+  static constexpr int8_t NOT_RESIDENT = -1;
+
+  /** Start tracking a frame that is not resident yet as a heap frame */
+  void Track(frame_id_t frame_id);
+
+  /** @return the classes in the order they give up victims right now */
+  std::vector<size_t> EvictionOrder() const;
+
+ private:
+  std::vector<Replacer *> replacers_;  // one per page class
+  std::vector<int8_t> frame_class_;    // class of every frame, NOT_RESIDENT if untracked
+  size_t resident_[NUM_PAGE_CLASSES]{};
+  size_t evictions_[NUM_PAGE_CLASSES]{};
+  size_t capacity_;
+};
+
+#endif  // MINISQL_PAGE_CLASS_REPLACER_H
@@ -0,0 +1,109 @@
+#ifndef MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+#define MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+
+/**
+ * ParallelBufferPoolManager hash-partitions page ids over several independent BufferPoolManagerInstances. Every
+ * instance owns its own latch, free list and replacer, so threads working on different pages rarely contend.
+ *
+ * Page p always lives in instance (p % num_instances). New page ids come from the shared disk manager, so NewPage
+ * allocates first and then asks the owning instance for a frame.
+ *
+ * A BufferRing only recycles a frame when its oldest page lives in the same instance as the missed page. For
+ * consecutive page ids this holds whenever the ring size is a multiple of the number of instances.
+ *
+ * Resizing splits the new size evenly over the instances.
+ */
+class ParallelBufferPoolManager : public BufferPoolManager {
+ public:
+  /**
+   * @param num_instances number of buffer pool instances
+   * @param pool_size number of frames in each instance, at least one
+   * @param disk_manager the disk manager shared by all instances
+   * @param replacer_type replacement policy of every instance
+   * @param max_pool_size largest size each instance may be resized to, 0 for a fixed size pool
+   */
+  ParallelBufferPoolManager(size_t num_instances, size_t pool_size, DiskManager *disk_manager,
+                            ReplacerType replacer_type = ReplacerType::kLRU, size_t max_pool_size = 0);
+
+  ~ParallelBufferPoolManager() override;
+
+  Page *FetchPage(page_id_t page_id, BufferRing *ring = nullptr) override;
+
+  /** Pages are grouped by instance, so every instance latch is taken once */
+  std::vector<Page *> FetchPages(const std::vector<page_id_t> &page_ids) override;
+
+  bool UnpinPage(page_id_t page_id, bool is_dirty) override;
+
+  bool FlushPage(page_id_t page_id) override;
+
+  bool FlushAllPages() override;
+
+  Page *NewPage(page_id_t &page_id, page_id_t near_page_id = INVALID_PAGE_ID) override;
+
+  bool DeletePage(page_id_t page_id) override;
+
+  bool CheckAllUnpinned() override;
+
+  /** @return the total number of frames over all instances */
+  size_t GetPoolSize() override;
+
+  size_t GetMaxPoolSize() override { return num_instances_ * instances_[0]->GetMaxPoolSize(); }
+
+  /** @param max_pool_size total number of frames, rounded down to a multiple of the number of instances */
+  void SetMaxPoolSize(size_t max_pool_size) override;
+
+  /**
+   * @param pool_size total number of frames, rounded down to a multiple of the number of instances, every instance
+   * keeps at least one frame
+   */
+  size_t Resize(size_t pool_size) override;
+
+  size_t GetHitCount() override;
+
+  size_t GetMissCount() override;
+
+  size_t GetSyncWriteCount() override;
+
+  size_t GetBackgroundWriteCount() override;
+
+  size_t GetResidentPageCount(PageClass page_class) override;
+
+  size_t GetEvictionCount(PageClass page_class) override;
+
+  /** @param capacity total bytes, split evenly over the instances */
+  void EnableCompressedCache(size_t capacity) override;
+
+  CompressedCacheStats GetCompressedCacheStats() override;
+
+  /** @return the number of buffer pool instances */
+  size_t GetNumInstances() const { return num_instances_; }
+
+ protected:
+  /** A single background writer thread serves all instances, clean_target applies to each of them */
+  size_t BackgroundWriterStep(size_t clean_target) override;
+
+  /** Concatenation of the instance lists, each in its own replacement order */
+  std::vector<page_id_t> GetResidentPages() override;
+
+  size_t LoadPages(const std::vector<page_id_t> &page_ids) override;
+
+ private:
+  /**
+   * The dirty pages of all instances go into one batch with all instance latches held, so that adjacent pages,
+   * which live in different instances, are still merged into one write.
+   */
+  bool WriteDirtyPages();
+
+  /** @return the instance responsible for page_id */
+  BufferPoolManagerInstance *GetInstance(page_id_t page_id) { return instances_[page_id % num_instances_]; }
+
+ private:
+  size_t num_instances_;
+  std::vector<BufferPoolManagerInstance *> instances_;
+};
+
+#endif  // MINISQL_PARALLEL_BUFFER_POOL_MANAGER_H
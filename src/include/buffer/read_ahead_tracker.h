@@ -0,0 +1,30 @@
+#ifndef MINISQL_READ_AHEAD_TRACKER_H
+#define MINISQL_READ_AHEAD_TRACKER_H
+
+#include "buffer/buffer_pool_manager.h"
+
+/**
+ * ReadAheadTracker detects when a scan walks a chain of pages sequentially and then keeps read-ahead going.
+ *
+ * The scan reports every hop along a next-page link. After READ_AHEAD_TRIGGER hops in a row the tracker asks the
+ * buffer pool to prefetch the next READ_AHEAD_PAGES pages, and asks again every half window, so the helper thread
+ * stays ahead of the scan.
+ */
+class ReadAheadTracker {
+ public:
+  /**
+   * Report that the scan followed the chain to page_id.
+   * @param next_page how the buffer pool follows the chain
+   */
+  void OnNextPage(BufferPoolManager *bpm, page_id_t page_id, BufferPoolManager::NextPageFn next_page) {
+    if (++sequential_pages_ < READ_AHEAD_TRIGGER) return;
+    if ((sequential_pages_ - READ_AHEAD_TRIGGER) % (READ_AHEAD_PAGES / 2) == 0) {
+      bpm->ReadAhead(page_id, next_page);
+    }
+  }
+
+ private:
+  size_t sequential_pages_{0};
+};
+
+#endif  // MINISQL_READ_AHEAD_TRACKER_H
@@ -2,9 +2,19 @@
 #define MINISQL_REPLACER_H
 
 #include <cstdio>
+#include <vector>
 
 #include "common/config.h"
 
+/**
+ * Replacement policies a buffer pool can be created with.
+ */
+enum class ReplacerType {
+  kLRU,   /** plain least recently used */
+  kLRUK,  /** LRU-K, resistant to sequential scans */
+  kClock  /** clock (second chance) */
+};
+
 /**
  * Replacer is an abstract class that tracks page usage.
  */
@@ -33,8 +43,34 @@ class Replacer {
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * Forget a frame whose page is dropped from the buffer pool without going through Victim, e.g. a deleted page.
+   * Policies that keep a per-frame history must clear it, so that the next page in the frame starts afresh.
+   * @param frame_id the id of the frame to remove
+   */
+  virtual void Remove(frame_id_t frame_id) { Pin(frame_id); }
+
+  /**
+   * Make room for more frames, called when the buffer pool grows past the frames it has created so far.
+   * @param num_pages the new maximum number of frames the replacer will be required to store
+   */
+  virtual void Grow(__attribute__((unused)) size_t num_pages) {}
+
+  /**
+   * List the frames Victim would return next, in that order, without removing them from the replacer.
+   * @param count the maximum number of frames to list
+   * @param[out] frames receives the frames
+   */
+  virtual void GetVictimCandidates(size_t count, std::vector<frame_id_t> *frames) = 0;
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual size_t Size() = 0;
+
+  /**
+   * Create a replacer of the given policy.
+   * @param num_pages the maximum number of frames the replacer will be required to store
+   */
+  static Replacer *Create(ReplacerType type, size_t num_pages);
 };
 
 #endif  // MINISQL_REPLACER_H
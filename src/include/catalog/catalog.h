@@ -4,6 +4,7 @@
 #include <map>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/indexes.h"
@@ -94,6 +95,26 @@ dberr_t GetTables(std::vector<TableInfo *> &tables) const;
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Load rows into a table: TableHeap::BulkInsert packs them into pages, then the entries of every index are
+   * inserted sorted by key. No unique check is run per row; a key that is already in an index, or twice among the
+   * rows, fails the whole batch and the rows are removed again.
+   * @param[in/out] rows the rows to load, their row ids are set
+   */
+  dberr_t BulkInsert(const std::string &table_name, std::vector<Row> &rows, Transaction *txn);
+
+  /**
+   * Remove rows from a table together with their index entries, e.g. the batches a load inserted before one of its
+   * later batches failed. Row ids that no longer hold a tuple are skipped.
+   */
+  dberr_t RemoveRows(const std::string &table_name, const std::vector<RowId> &row_ids, Transaction *txn);
+
+  /**
+   * Compact a table, move the index entries of the moved rows along and shrink the file.
+   * @param[out] freed_pages number of table pages freed, may be null
+   */
+  dberr_t VacuumTable(const std::string &table_name, Transaction *txn, size_t *freed_pages = nullptr);
+
  private:
   dberr_t DropTable(table_id_t table_id);
 
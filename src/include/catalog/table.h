@@ -31,6 +31,10 @@ class TableMetadata {
 
   inline uint32_t GetFirstPageId() const { return root_page_id_; }
 
+  inline page_id_t GetFreeSpaceMapPageId() const { return fsm_page_id_; }
+
+  inline void SetFreeSpaceMapPageId(page_id_t fsm_page_id) { fsm_page_id_ = fsm_page_id; }
+
   inline Schema *GetSchema() const { return schema_; }
 
  private:
@@ -40,9 +44,11 @@ class TableMetadata {
 
  private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
+  static constexpr uint32_t TABLE_METADATA_FSM_MAGIC_NUM = 344529;  // followed by the free space map page id
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
+  page_id_t fsm_page_id_{INVALID_PAGE_ID};
   Schema *schema_;
 };
 
@@ -13,8 +13,34 @@ static constexpr int META_PAGE_ID = 0;          // physical page id of the disk
 static constexpr int CATALOG_META_PAGE_ID = 0;  // logical page id of the catalog meta data
 static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index roots
 
-static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
-static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
+// set by the MINISQL_PAGE_SIZE build option
+#ifndef MINISQL_PAGE_SIZE
+#define MINISQL_PAGE_SIZE 4096
+#endif
+static constexpr int PAGE_SIZE = MINISQL_PAGE_SIZE;        // size of a data page in byte
+static_assert(PAGE_SIZE >= 4096 && PAGE_SIZE <= 32768 && (PAGE_SIZE & (PAGE_SIZE - 1)) == 0,
+              "page size must be a power of two between 4 KB and 32 KB");
+static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;     // default size of buffer pool
+static constexpr int DEFAULT_BUFFER_POOL_INSTANCES = 8;    // default number of buffer pool instances
+static constexpr int DEFAULT_LRU_K = 2;                    // number of accesses tracked by the LRU-K replacer
+static constexpr int BUFFER_RING_SIZE = 32;                // number of frames recycled by a bulk read
+static constexpr int DEFAULT_BG_WRITER_CLEAN_TARGET = 32;  // frames the background writer keeps clean per instance
+static constexpr int DEFAULT_BG_WRITER_INTERVAL_MS = 20;   // pause between two background writer rounds
+static constexpr int READ_AHEAD_PAGES = 16;                // pages prefetched ahead of a sequential scan
+static constexpr int READ_AHEAD_TRIGGER = 2;               // next-page hops before a scan counts as sequential
+static constexpr bool DEFAULT_DIRECT_IO = false;           // bypass the OS page cache for database files
+static constexpr bool DEFAULT_PAGE_COMPRESSION = false;    // store the pages of new database files compressed
+static constexpr int WARM_START_BATCH_PAGES = 64;          // max pages read at once when reloading a warm pool
+static constexpr const char *WARM_START_FILE_SUFFIX = ".warm";  // sidecar of a database file listing its hot pages
+static constexpr int MIN_BUFFER_POOL_SIZE = 1024;               // frames every open database keeps
+static constexpr int BUFFER_POOL_REBALANCE_INTERVAL_MS = 1000;  // min time between two rebalances of the budget
+static constexpr int DEFAULT_COMPRESSED_CACHE_SIZE = 0;         // evicted pages kept compressed per database, in bytes
+static constexpr int ASYNC_IO_QUEUE_DEPTH = 64;                 // max page I/Os of a batch in flight at once
+static constexpr int ASYNC_IO_THREADS = 8;                      // threads of the fallback when io_uring is missing
+static constexpr int PAGE_RUN_SIZE = 64;                        // adjacent pages reserved at once for a growing object
+
+// frames shared by the buffer pools of all open databases
+static constexpr int DEFAULT_BUFFER_POOL_BUDGET = 4 * DEFAULT_BUFFER_POOL_SIZE;
 
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
 static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
@@ -14,7 +14,18 @@
 
 class DBStorageEngine {
  public:
-  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE);
+  /**
+   * @param buffer_pool_size total number of frames of the buffer pool
+   * @param buffer_pool_instances number of buffer pool instances the frames are spread over, at most one per frame
+   * @param replacer_type replacement policy of the buffer pool
+   * @param max_buffer_pool_size total number of frames the buffer pool may be resized to, 0 for a fixed size
+   * @param read_only open an existing database read-only, pages are read straight from a memory mapping of the file
+   * and the buffer pool parameters are ignored
+   */
+  explicit DBStorageEngine(std::string db_name, bool init = true, uint32_t buffer_pool_size = DEFAULT_BUFFER_POOL_SIZE,
+                           uint32_t buffer_pool_instances = DEFAULT_BUFFER_POOL_INSTANCES,
+                           ReplacerType replacer_type = ReplacerType::kLRUK, uint32_t max_buffer_pool_size = 0,
+                           bool read_only = false);
 
   ~DBStorageEngine();
 
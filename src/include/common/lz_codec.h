@@ -0,0 +1,30 @@
+#ifndef MINISQL_LZ_CODEC_H
+#define MINISQL_LZ_CODEC_H
+
+#include <cstddef>
+
+/**
+ * A small LZ77 codec in the spirit of LZ4, fast enough to run on the buffer pool's eviction path.
+ *
+ * The output is a series of sequences. Each starts with a token byte holding the number of literals in its high
+ * nibble and the match length minus 4 in its low nibble, a nibble of 15 meaning that more length bytes follow
+ * (255 per byte until a smaller byte ends it). The literals come next, then the 2-byte little endian distance
+ * back to the match and the extra match length bytes. The last sequence only holds literals.
+ */
+class LZCodec {
+ public:
+  /**
+   * Compress src into dst.
+   * @param dst_capacity size of dst, compression gives up once the output would not fit
+   * @return the compressed size, 0 if it exceeds dst_capacity
+   */
+  static size_t Compress(const char *src, size_t src_size, char *dst, size_t dst_capacity);
+
+  /**
+   * Decompress src into dst.
+   * @return the decompressed size, 0 if src is corrupt or does not fit into dst_capacity
+   */
+  static size_t Decompress(const char *src, size_t src_size, char *dst, size_t dst_capacity);
+};
+
+#endif  // MINISQL_LZ_CODEC_H
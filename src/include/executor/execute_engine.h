@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "buffer/buffer_pool_budget.h"
 #include "common/dberr.h"
 #include "common/instance.h"
 #include "executor/execute_context.h"
@@ -26,6 +27,7 @@ class ExecuteEngine {
 
   ~ExecuteEngine() {
     for (auto it : dbs_) {
+      budget_.Unregister(it.second->bpm_);
       delete it.second;
     }
   }
@@ -41,6 +43,9 @@ class ExecuteEngine {
   void ExecuteInformation(dberr_t result);
 
  private:
+  /** Open or create a database whose buffer pool shares the frame budget with the other open databases */
+  DBStorageEngine *OpenDatabase(const std::string &db_name, bool init);
+
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
   dberr_t ExecuteCreateDatabase(pSyntaxNode ast, ExecuteContext *context);
@@ -73,9 +78,19 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteVacuum(pSyntaxNode ast, ExecuteContext *context);
+
+  /**
+   * LOAD DATA "file" INTO table: insert the lines of a CSV file as rows, in batches through CatalogManager::BulkInsert.
+   * The load is all or nothing: a bad line or a duplicated key anywhere in the file also removes the rows of the
+   * batches loaded before it.
+   */
+  dberr_t ExecuteLoadData(pSyntaxNode ast, ExecuteContext *context);
+
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  BufferPoolBudget budget_{DEFAULT_BUFFER_POOL_BUDGET};    /** frames shared by the buffer pools of dbs_ */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
@@ -40,8 +40,16 @@ class SeqScanExecutor : public AbstractExecutor {
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
-  TableInfo* table_info_;
-  TableIterator itr;
+  TableInfo* table_info_{nullptr};
+  BufferRing ring_;  // a scan recycles its own frames instead of evicting the shared pool
+  ReadAheadTracker read_ahead_;
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  // 输出列在原表中的下标
+  std::vector<uint32_t> out_columns_;
+  // 一页中满足条件的元组，谓词在页内的RowView上求值，只有满足的才物化成Row；Row换页时复用
+  std::vector<Row> rows_;
+  size_t count_{0};
+  size_t cursor_{0};
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
@@ -1,6 +1,7 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <fstream>
 #include <queue>
 #include <string>
 #include <vector>
@@ -35,6 +36,14 @@ class BPlusTree {
   // Insert a key-value pair into this B+ tree.
   bool Insert(GenericKey *key, const RowId &value, Transaction *transaction = nullptr);
 
+  /**
+   * Build an empty tree from entries sorted by key, bottom up: the leaves are filled one after another, then each
+   * level of internal pages above them, without comparing a single key. No key may appear twice.
+   * @param keys count keys of the key size, one after another
+   * @return false if the tree is not empty
+   */
+  bool BulkLoad(const char *keys, const std::vector<RowId> &values);
+
   // Remove a key and its value from this B+ tree.
   void Remove(const GenericKey *key, Transaction *transaction = nullptr);
 
@@ -62,7 +71,7 @@ class BPlusTree {
     }
     out << "digraph G {" << std::endl;
     Page *root_page = buffer_pool_manager_->FetchPage(root_page_id_);
-    auto *node = reinterpret_cast<BPlusTreePage *>(root_page);
+    auto *node = reinterpret_cast<BPlusTreePage *>(root_page->GetData());
     ToGraph(node, buffer_pool_manager_, out);
     out << "}" << std::endl;
   }
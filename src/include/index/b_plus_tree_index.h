@@ -11,6 +11,12 @@ class BPlusTreeIndex : public Index {
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) override;
 
+  /**
+   * The entries are sorted by key first. An empty tree is built bottom up from them, otherwise they are inserted
+   * one by one in key order, so that consecutive inserts go down the same path of the tree.
+   */
+  dberr_t InsertEntries(const std::vector<std::pair<Row, RowId>> &entries, Transaction *txn) override;
+
   dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) override;
 
   dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn, string compare_operator = "=") override;
@@ -2,6 +2,8 @@
 #define MINISQL_INDEX_H
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "common/dberr.h"
 #include "record/row.h"
@@ -15,6 +17,12 @@ class Index {
 
   virtual dberr_t InsertEntry(const Row &key, RowId row_id, Transaction *txn) = 0;
 
+  /**
+   * Insert many entries, in key order. All or nothing: if a key is in the index already, or twice among the
+   * entries, no entry is inserted.
+   */
+  virtual dberr_t InsertEntries(const std::vector<std::pair<Row, RowId>> &entries, Transaction *txn) = 0;
+
   virtual dberr_t RemoveEntry(const Row &key, RowId row_id, Transaction *txn) = 0;
 
   virtual dberr_t ScanKey(const Row &key, std::vector<RowId> &result, Transaction *txn,
@@ -1,6 +1,7 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include "buffer/read_ahead_tracker.h"
 #include "page/b_plus_tree_leaf_page.h"
 
 class IndexIterator {
@@ -31,6 +32,7 @@ class IndexIterator {
   LeafPage *page{nullptr};
   int item_index{0};
   BufferPoolManager *buffer_pool_manager{nullptr};
+  ReadAheadTracker read_ahead;
   // add your own private member variables here
 };
 
@@ -6,6 +6,12 @@
 #include "common/config.h"
 #include "common/macros.h"
 
+/**
+ * BitmapPage records which pages of an extent are in use, one bit per page, the most significant bit of a byte first.
+ *
+ * Free pages are searched a 64-bit word at a time, starting at next_free_page_, so allocation skips full words with
+ * one comparison and finds the free bit of a word with a single count-leading-zeros instruction.
+ */
 template <size_t PageSize>
 class BitmapPage {
  public:
@@ -15,6 +21,7 @@ class BitmapPage {
   static constexpr size_t GetMaxSupportedSize() { return 8 * MAX_CHARS; }
 
   /**
+   * Allocate the lowest free page at or after next_free_page_, wrapping around to the start of the extent.
    * @param page_offset Index in extent of the page allocated.
    * @return true if successfully allocate a page.
    */
@@ -25,11 +32,23 @@ class BitmapPage {
    */
   bool DeAllocatePage(uint32_t page_offset);
 
+  /**
+   * Allocate a given page.
+   * @return false if the page is not free
+   */
+  bool AllocatePageAt(uint32_t page_offset);
+
   /**
    * @return whether a page in the extent is free
    */
   bool IsPageFree(uint32_t page_offset) const;
 
+  /** @return the first free page in [begin, GetMaxSupportedSize()), or GetMaxSupportedSize() if there is none */
+  uint32_t FindFreePage(uint32_t begin) const;
+
+  /** @return one past the last allocated page of the extent, 0 if no page is allocated */
+  uint32_t FindAllocatedEnd() const;
+
  private:
   /**
    * check a bit(byte_index, bit_index) in bytes is free(value 0).
@@ -42,6 +61,7 @@ class BitmapPage {
 
   /** Note: need to update if modify page structure. */
   static constexpr size_t MAX_CHARS = PageSize - 2 * sizeof(uint32_t);
+  static_assert(MAX_CHARS % sizeof(uint64_t) == 0, "bitmap is searched a word at a time");
 
  private:
   /** The space occupied by all members of the class should be equal to the PageSize */
@@ -5,10 +5,20 @@
 
 #include "page/bitmap_page.h"
 
-static constexpr page_id_t MAX_VALID_PAGE_ID = (PAGE_SIZE - 8) / 4 * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
-//(PAGE_SIZE-8)/4是最大extent数目
+/**
+ * DiskFileMetaPage is the first physical page of a database file. It starts with a magic number and the page size the
+ * file was created with, so that a build with another page size refuses to open it, followed by the page counts
+ * of the extents.
+ *
+ * Files written before the header existed start directly with num_allocated_pages_ and always use 4 KB pages; the
+ * disk manager converts them when it opens them.
+ */
 class DiskFileMetaPage {
  public:
+  static constexpr uint32_t MAGIC = 0x4c51534d;  // "MSQL"
+  static constexpr uint32_t HEADER_SIZE = 4 * sizeof(uint32_t);
+  static constexpr uint32_t MAX_EXTENTS = (PAGE_SIZE - HEADER_SIZE) / sizeof(uint32_t);
+
   uint32_t GetExtentNums() { return num_extents_; }
 
   uint32_t GetAllocatedPages() { return num_allocated_pages_; }
@@ -21,9 +31,16 @@ class DiskFileMetaPage {
   }
 
  public:
+  uint32_t magic_{MAGIC};
+  uint32_t page_size_{PAGE_SIZE};
   uint32_t num_allocated_pages_{0};
   uint32_t num_extents_{0};  // each extent consists with a bit map and BIT_MAP_SIZE pages
-  uint32_t extent_used_page_[0];
+  uint32_t extent_used_page_[MAX_EXTENTS];
 };
 
+static_assert(sizeof(DiskFileMetaPage) == PAGE_SIZE, "the meta page must fill a page");
+
+static constexpr page_id_t MAX_VALID_PAGE_ID =
+    DiskFileMetaPage::MAX_EXTENTS * BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+
 #endif  // MINISQL_DISK_FILE_META_PAGE_H
@@ -0,0 +1,71 @@
+#ifndef MINISQL_FREE_SPACE_MAP_PAGE_H
+#define MINISQL_FREE_SPACE_MAP_PAGE_H
+
+#include <algorithm>
+#include <cstdint>
+
+#include "common/config.h"
+
+/**
+ * A page of the free space map of a table heap. It lists the pages of the heap, in the order of the page chain, each
+ * with a one byte summary of its free space: the free bytes divided by CATEGORY_SIZE, rounded down, so a page has at
+ * least category * CATEGORY_SIZE bytes free. The pages of one map are chained like the pages of the heap.
+ *
+ * Format (size in byte):
+ *  ---------------------------------------------------------------------------------------------------
+ * | NextPageId (4) | Count (4) | PageId_1 (4) | ... | PageId_CAPACITY (4) | Category_1 (1) | ... |
+ *  ---------------------------------------------------------------------------------------------------
+ */
+class FreeSpaceMapPage {
+ public:
+  void Init() {
+    next_page_id_ = INVALID_PAGE_ID;
+    count_ = 0;
+  }
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  uint32_t GetCount() const { return count_; }
+
+  bool IsFull() const { return count_ == CAPACITY; }
+
+  page_id_t GetPageId(uint32_t slot) const { return page_ids_[slot]; }
+
+  uint8_t GetCategory(uint32_t slot) const { return categories_[slot]; }
+
+  void SetCategory(uint32_t slot, uint8_t category) { categories_[slot] = category; }
+
+  /** Add a heap page at the end, the page must not be full */
+  void Append(page_id_t page_id, uint8_t category);
+
+  /** @return the first slot whose category is at least min_category, -1 if there is none */
+  int FindSlot(uint8_t min_category) const;
+
+  /** @return the largest category of the page, 0 if it is empty */
+  uint8_t GetMaxCategory() const;
+
+  /** @return the category of a page with free_bytes bytes free */
+  static uint8_t ToCategory(uint32_t free_bytes) {
+    return static_cast<uint8_t>(std::min<uint32_t>(free_bytes / CATEGORY_SIZE, UINT8_MAX));
+  }
+
+  /** @return the smallest category that guarantees size free bytes */
+  static uint8_t MinCategory(uint32_t size) {
+    return static_cast<uint8_t>(std::min<uint32_t>((size + CATEGORY_SIZE - 1) / CATEGORY_SIZE, UINT8_MAX));
+  }
+
+  static constexpr uint32_t CATEGORY_SIZE = PAGE_SIZE / 256;
+  static constexpr uint32_t CAPACITY = (PAGE_SIZE - 2 * sizeof(uint32_t)) / (sizeof(page_id_t) + sizeof(uint8_t));
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t count_;
+  page_id_t page_ids_[CAPACITY];
+  uint8_t categories_[CAPACITY];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= PAGE_SIZE, "Free space map page does not fit into a page.");
+
+#endif  // MINISQL_FREE_SPACE_MAP_PAGE_H
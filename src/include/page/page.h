@@ -1,27 +1,49 @@
 #ifndef MINISQL_PAGE_H
 #define MINISQL_PAGE_H
 
+#include <atomic>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <shared_mutex>
 
 #include "common/config.h"
 #include "common/rwlatch.h"
 
+/**
+ * What a page holds, as far as the buffer pool's eviction priorities are concerned. Pages are heap pages unless the
+ * code that fetched them says otherwise.
+ */
+enum class PageClass : uint8_t {
+  kHeap,           /** table heap pages and anything untagged */
+  kIndexLeaf,      /** B+ tree leaves */
+  kIndexInternal,  /** B+ tree root and internal pages */
+  kMeta            /** catalog, table and index meta data, index roots */
+};
+
+static constexpr size_t NUM_PAGE_CLASSES = 4;
+
 /**
  * Page is the basic unit of storage within the database system. Page provides a wrapper for actual data pages being
  * held in main memory. Page also contains book-keeping information that is used by the buffer pool manager, e.g.
  * pin count, dirty flag, page id, etc.
+ *
+ * The page data is not stored inline. A frame of the buffer pool points into the pool's page-aligned arena, so the
+ * array of Page objects only holds the compact frame metadata. A Page created on its own owns a private buffer.
  */
 class Page {
   // There is bookkeeping information inside the page that should only be relevant to the buffer pool manager.
-  friend class BufferPoolManager;
+  friend class BufferPoolManagerInstance;
+  friend class MappedBufferPoolManager;
 
  public:
   DISALLOW_COPY(Page)
 
-  /** Constructor. Zeros out the page data. */
-  Page() { ResetMemory(); }
+  /** Constructor of a standalone page. Allocates zeroed page data. */
+  Page() : owned_data_(new char[PAGE_SIZE]{}), data_(owned_data_.get()) {}
+
+  /** Constructor of a buffer pool frame. */
+  explicit Page(char *data) : data_(data) {}
 
   /** Default destructor. */
   ~Page() = default;
@@ -38,6 +60,12 @@ class Page {
   /** @return true if the page in memory has been modified from the page on disk, false otherwise */
   inline bool IsDirty() { return is_dirty_; }
 
+  /** @return the class the page was tagged with, kHeap if it was not tagged */
+  inline PageClass GetPageClass() { return page_class_.load(std::memory_order_relaxed); }
+
+  /** Tag a pinned page with its class. The buffer pool picks the class up when the page is unpinned. */
+  inline void SetPageClass(PageClass page_class) { page_class_.store(page_class, std::memory_order_relaxed); }
+
   /** Acquire the page write latch. */
   inline void WLatch() { rwlatch_.WLock(); }
 
@@ -68,14 +96,18 @@ class Page {
   /** Zeroes out the data that is held within the page. */
   inline void ResetMemory() { memset(data_, OFFSET_PAGE_START, PAGE_SIZE); }
 
+  /** Buffer of a standalone page, empty for buffer pool frames. */
+  std::unique_ptr<char[]> owned_data_;
   /** The actual data that is stored within a page. */
-  char data_[PAGE_SIZE]{};
+  char *data_;
   /** The ID of this page. */
   page_id_t page_id_ = INVALID_PAGE_ID;
   /** The pin count of this page. */
   int pin_count_ = 0;
   /** True if the page is dirty, i.e. it is different from its corresponding page on disk. */
   bool is_dirty_ = false;
+  /** Eviction class of the page, may be set by any thread holding a pin. */
+  std::atomic<PageClass> page_class_{PageClass::kHeap};
   /** Page latch. */
   ReaderWriterLatch rwlatch_;
 };
@@ -9,20 +9,28 @@
  *                                free space pointer
  *
  *  Header format (size in bytes):
- *  ----------------------------------------------------------------------------
- *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(4) |
- *  ----------------------------------------------------------------------------
+ *  ----------------------------------------------------------------------------------------------
+ *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| FreeSpacePointer(2) | RowFormat (2) |
+ *  ----------------------------------------------------------------------------------------------
  *  ----------------------------------------------------------------
  *  | TupleCount (4) | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
  *  ----------------------------------------------------------------
+ *
+ *  RowFormat is the format all tuples of the page are in. Pages written before the row format had versions hold 0
+ *  there, the upper half of the old 4 byte free space pointer, and so read as kRowFormatLegacy: they may hold legacy
+ *  tuples until UpgradeTuples has rewritten them.
  **/
 
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/rowid.h"
 #include "page/page.h"
 #include "record/row.h"
+#include "record/row_view.h"
 #include "transaction/lock_manager.h"
 #include "transaction/log_manager.h"
 #include "transaction/transaction.h"
@@ -58,15 +66,56 @@ class TablePage : public Page {
 
   bool GetTuple(Row *row, Schema *schema, Transaction *txn, LockManager *lock_manager);
 
+  /**
+   * Read every tuple that is not deleted, in slot order, for scans. The rows are reused from call to call: their
+   * fields are replaced, and rows only grows when the page holds more tuples than it has rows.
+   * @return the number of rows set, rows[0, count) hold the tuples
+   */
+  uint32_t GetTuples(std::vector<Row> *rows, Schema *schema);
+
+  /**
+   * Visit every tuple that is not deleted, in slot order, without decoding it: view is pointed at each tuple in this
+   * page in turn and handed to visit. The view is only valid while the page stays pinned and latched.
+   */
+  void VisitTuples(Schema *schema, RowView *view, const std::function<void(const RowView &view)> &visit);
+
+  /**
+   * Rewrite the tuples of this page that are still in the legacy row format in the current one. Pages are upgraded
+   * lazily: InsertTuple and UpdateTuple call this first, pages that are only read keep their old rows, which stay
+   * readable. Nothing changes if the upgraded tuples would not fit in the page. Once the page holds no legacy tuple,
+   * its RowFormat is set and later calls return at once.
+   * @return true if the page holds no legacy tuple afterwards
+   */
+  bool UpgradeTuples(Schema *schema);
+
   bool GetFirstTupleRid(RowId *first_rid);
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
 
+  /** @return true if the page holds no tuple, not even one that is marked deleted */
+  bool IsEmpty() { return GetFreeSpacePointer() == PAGE_SIZE; }
+
+  /** @return the largest serialized row InsertTuple still accepts */
+  uint32_t GetFreeSpaceForInsert() {
+    uint32_t free_space = GetFreeSpaceRemaining();
+    return free_space > SIZE_TUPLE ? free_space - SIZE_TUPLE : 0;
+  }
+
  private:
-  uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+  uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint16_t *>(GetData() + OFFSET_FREE_SPACE); }
 
   void SetFreeSpacePointer(uint32_t free_space_pointer) {
-    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+    auto pointer = static_cast<uint16_t>(free_space_pointer);
+    memcpy(GetData() + OFFSET_FREE_SPACE, &pointer, sizeof(uint16_t));
+  }
+
+  RowFormat GetRowFormat() {
+    return static_cast<RowFormat>(*reinterpret_cast<uint16_t *>(GetData() + OFFSET_ROW_FORMAT));
+  }
+
+  void SetRowFormat(RowFormat format) {
+    auto value = static_cast<uint16_t>(format);
+    memcpy(GetData() + OFFSET_ROW_FORMAT, &value, sizeof(uint16_t));
   }
 
   uint32_t GetTupleCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_COUNT); }
@@ -101,12 +150,14 @@ class TablePage : public Page {
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+  static_assert(PAGE_SIZE <= UINT16_MAX, "The free space pointer is stored in 2 bytes.");
   static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
   static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
   static constexpr size_t SIZE_TUPLE = 8;
   static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
   static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
   static constexpr size_t OFFSET_FREE_SPACE = 16;
+  static constexpr size_t OFFSET_ROW_FORMAT = 18;
   static constexpr size_t OFFSET_TUPLE_COUNT = 20;
   static constexpr size_t OFFSET_TUPLE_OFFSET = 24;
   static constexpr size_t OFFSET_TUPLE_SIZE = 28;
@@ -53,36 +53,39 @@ enum yytokentype {
   SHOW = 269,
   USE = 270,
   USING = 271,
-  DATABASE = 272,
-  DATABASES = 273,
-  TABLE = 274,
-  TABLES = 275,
-  INDEX = 276,
-  INDEXES = 277,
-  ON = 278,
-  FROM = 279,
-  WHERE = 280,
-  INTO = 281,
-  SET = 282,
-  VALUES = 283,
-  PRIMARY = 284,
-  KEY = 285,
-  UNIQUE = 286,
-  CHAR = 287,
-  INT = 288,
-  FLOAT = 289,
-  AND = 290,
-  OR = 291,
-  NOT = 292,
-  IS = 293,
-  FLAGNULL = 294,
-  IDENTIFIER = 295,
-  STRING = 296,
-  NUMBER = 297,
-  EQ = 298,
-  NE = 299,
-  LE = 300,
-  GE = 301
+  VACUUM = 272,
+  LOAD = 273,
+  DATA = 274,
+  DATABASE = 275,
+  DATABASES = 276,
+  TABLE = 277,
+  TABLES = 278,
+  INDEX = 279,
+  INDEXES = 280,
+  ON = 281,
+  FROM = 282,
+  WHERE = 283,
+  INTO = 284,
+  SET = 285,
+  VALUES = 286,
+  PRIMARY = 287,
+  KEY = 288,
+  UNIQUE = 289,
+  CHAR = 290,
+  INT = 291,
+  FLOAT = 292,
+  AND = 293,
+  OR = 294,
+  NOT = 295,
+  IS = 296,
+  FLAGNULL = 297,
+  IDENTIFIER = 298,
+  STRING = 299,
+  NUMBER = 300,
+  EQ = 301,
+  NE = 302,
+  LE = 303,
+  GE = 304
 };
 #endif
 /* Tokens.  */
@@ -100,36 +103,39 @@ enum yytokentype {
 #define SHOW 269
 #define USE 270
 #define USING 271
-#define DATABASE 272
-#define DATABASES 273
-#define TABLE 274
-#define TABLES 275
-#define INDEX 276
-#define INDEXES 277
-#define ON 278
-#define FROM 279
-#define WHERE 280
-#define INTO 281
-#define SET 282
-#define VALUES 283
-#define PRIMARY 284
-#define KEY 285
-#define UNIQUE 286
-#define CHAR 287
-#define INT 288
-#define FLOAT 289
-#define AND 290
-#define OR 291
-#define NOT 292
-#define IS 293
-#define FLAGNULL 294
-#define IDENTIFIER 295
-#define STRING 296
-#define NUMBER 297
-#define EQ 298
-#define NE 299
-#define LE 300
-#define GE 301
+#define VACUUM 272
+#define LOAD 273
+#define DATA 274
+#define DATABASE 275
+#define DATABASES 276
+#define TABLE 277
+#define TABLES 278
+#define INDEX 279
+#define INDEXES 280
+#define ON 281
+#define FROM 282
+#define WHERE 283
+#define INTO 284
+#define SET 285
+#define VALUES 286
+#define PRIMARY 287
+#define KEY 288
+#define UNIQUE 289
+#define CHAR 290
+#define INT 291
+#define FLOAT 292
+#define AND 293
+#define OR 294
+#define NOT 295
+#define IS 296
+#define FLAGNULL 297
+#define IDENTIFIER 298
+#define STRING 299
+#define NUMBER 300
+#define EQ 301
+#define NE 302
+#define LE 303
+#define GE 304
 
 #if !defined YYSTYPE && !defined YYSTYPE_IS_DECLARED
 typedef union YYSTYPE
@@ -138,7 +144,7 @@ typedef union YYSTYPE
   pSyntaxNode syntax_node;
 }
 /* Line 1529 of yacc.c.  */
-#line 145 "./minisql_yacc.h"
+#line 151 "./minisql_yacc.h"
 YYSTYPE;
 #define yystype YYSTYPE /* obsolescent; will be withdrawn */
 #define YYSTYPE_IS_DECLARED 1
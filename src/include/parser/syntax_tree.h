@@ -43,7 +43,9 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin transaction command */
   kNodeTrxCommit,            /** commit transaction command */
-  kNodeTrxRollback           /** rollback transaction command */
+  kNodeTrxRollback,          /** rollback transaction command */
+  kNodeVacuum,               /** vacuum command, optionally with a table name */
+  kNodeLoadData              /** load data command, contains the file name and the table name */
 } SyntaxNodeType;
 
 /**
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "record/row.h"
+#include "record/row_view.h"
 #include "record/schema.h"
 
 class AbstractExpression;
@@ -36,6 +37,13 @@ class AbstractExpression {
   /** @return The field obtained by evaluating the row */
   virtual Field Evaluate(const Row *row) const = 0;
 
+  /**
+   * Evaluate a tuple in place, e.g. a predicate during a scan. A CHAR field in the result may point into the page of
+   * the tuple, so it is only valid while the page stays pinned.
+   * @return The field obtained by evaluating the row view
+   */
+  virtual Field Evaluate(const RowView *row) const = 0;
+
   /**
    * Returns the field obtained by evaluating a JOIN.
    * @param left_row The left row
@@ -10,16 +10,31 @@
 #include "record/schema.h"
 
 /**
- *  Row format:
- * -------------------------------------------
- * | Header | Field-1 | ... | Field-N |
- * -------------------------------------------
+ * Versions of the row format, kept in the high byte of the first word of a serialized row. Rows written before the
+ * format had versions start with the bare field count, so they read as kRowFormatLegacy.
+ */
+enum RowFormat : uint8_t { kRowFormatLegacy = 0, kRowFormatFixed = 1 };
+
+/**
+ *  Row format (kRowFormatFixed):
+ * ------------------------------------------------------------------------
+ * | Header | Fixed part | CHAR offset table | CHAR-1 | ... | CHAR-M |
+ * ------------------------------------------------------------------------
  *  Header format:
- * --------------------------------------------
- * | Field Nums | Null bitmap |
- * -------------------------------------------
- *
+ * ----------------------------------------------------------------
+ * | Version (1) | Field Nums (3) | Null bitmap ((num + 7) / 8) |
+ * ----------------------------------------------------------------
+ *  The fixed part holds the INT/FLOAT columns at offsets taken from the schema (Schema::GetFieldSlot), a null one
+ *  as zeros. The offset table holds, for every CHAR column in schema order, the offset of the end of its data from
+ *  the start of the row (2 bytes each); its data starts where the one before it ends. Any column is found without
+ *  decoding the others.
  *
+ *  Row format (kRowFormatLegacy), still read but only written on request:
+ * -------------------------------------------------
+ * | Field Nums (4) | Null bitmap | Field-1 | ... | Field-N |
+ * -------------------------------------------------
+ *  The bitmap has (num - 1) / 8 * 8 + 1 bytes, null fields take no bytes and a CHAR field is its length (4) followed
+ *  by its data, so a field is found by decoding all the fields before it.
  */
 class Row {
  public:
@@ -81,8 +96,11 @@ class Row {
   /**
    * Note: Make sure that bytes write to buf is equal to GetSerializedSize()
    */
-  uint32_t SerializeTo(char *buf, Schema *schema) const;
+  uint32_t SerializeTo(char *buf, Schema *schema, RowFormat format = kRowFormatFixed) const;
 
+  /**
+   * Reads rows of any format
+   */
   uint32_t DeserializeFrom(char *buf, Schema *schema);
 
   /**
@@ -90,7 +108,17 @@ class Row {
    * For non-empty row with null fields, eg: |null|null|null|, return header size only
    * @return
    */
-  uint32_t GetSerializedSize(Schema *schema) const;
+  uint32_t GetSerializedSize(Schema *schema, RowFormat format = kRowFormatFixed) const;
+
+  /**
+   * @return the format of the row serialized at buf, which must not be an empty row
+   */
+  static RowFormat GetFormat(const char *buf) { return static_cast<RowFormat>(MACH_READ_UINT32(buf) >> 24); }
+
+  /**
+   * @return the number of fields of the row serialized at buf, which must not be an empty row
+   */
+  static uint32_t GetFieldCount(const char *buf) { return MACH_READ_UINT32(buf) & 0x00FFFFFF; }
 
   void GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row);
 
@@ -0,0 +1,74 @@
+#ifndef MINISQL_ROW_VIEW_H
+#define MINISQL_ROW_VIEW_H
+
+#include <vector>
+
+#include "common/rowid.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/**
+ * RowView is a read-only row over a tuple serialized in the format of Row::SerializeTo, usually a tuple inside a
+ * pinned TablePage. Nothing is copied when the view is set up: a field is decoded from the bytes when it is asked
+ * for, and a CHAR field points into the bytes instead of owning a copy. In the fixed-offset format a field is found
+ * directly; in the legacy format the fields before it are walked once and their offsets cached.
+ *
+ * A view, and every field taken from it, is only valid while the bytes are, i.e. while the page stays pinned and
+ * latched. Use ToRow to materialize a Row that owns its data when the result has to outlive that.
+ */
+class RowView {
+ public:
+  RowView() = default;
+
+  RowView(const char *data, Schema *schema, RowId rid = RowId()) { Reset(data, schema, rid); }
+
+  /**
+   * Point the view at another tuple, views are reused for all the tuples of a page
+   */
+  void Reset(const char *data, Schema *schema, RowId rid = RowId());
+
+  inline RowId GetRowId() const { return rid_; }
+
+  inline size_t GetFieldCount() const { return field_count_; }
+
+  bool IsNull(uint32_t idx) const;
+
+  /**
+   * Decode a field. CHAR data is not copied, the field points into the viewed bytes.
+   */
+  Field GetField(uint32_t idx) const;
+
+  /**
+   * Materialize the whole tuple into row, the fields of row own their data
+   */
+  void ToRow(Row *row) const;
+
+  /**
+   * Materialize the fields at idxs, in that order, e.g. the output columns of a projection
+   */
+  void ToRow(Row *row, const std::vector<uint32_t> &idxs) const;
+
+ private:
+  /**
+   * @param[out] len length of the data of a CHAR field
+   * @return the data of field idx, which must not be null
+   */
+  const char *GetFieldData(uint32_t idx, uint32_t *len) const;
+
+  /** @return offset of field idx from data_ in a legacy row, offsets of the fields before it are cached on the way */
+  uint32_t GetLegacyFieldOffset(uint32_t idx) const;
+
+  const char *data_{nullptr};
+  Schema *schema_{nullptr};
+  RowId rid_{};
+  RowFormat format_{kRowFormatFixed};
+  uint32_t field_count_{0};
+  const char *bitmap_{nullptr};
+  const char *fixed_{nullptr};    // 定长区
+  const char *offsets_{nullptr};  // CHAR偏移表
+  // 旧格式字段变长，只能从前往后算偏移；算过的记下来，换元组时只清空不释放
+  mutable std::vector<uint32_t> legacy_offsets_;
+};
+
+#endif  // MINISQL_ROW_VIEW_H
@@ -13,7 +13,17 @@
 class Schema {
  public:
   explicit Schema(const std::vector<Column *> columns, bool is_manage_ = true)
-      : columns_(std::move(columns)), is_manage_(is_manage_) {}
+      : columns_(std::move(columns)), is_manage_(is_manage_) {
+    // 定长列依次排在定长区，CHAR列依次编号，对应偏移表中的一项
+    for (auto column : columns_) {
+      if (column->GetType() == TypeId::kTypeChar) {
+        field_slots_.push_back(char_count_++);
+      } else {
+        field_slots_.push_back(fixed_size_);
+        fixed_size_ += Type::GetTypeSize(column->GetType());
+      }
+    }
+  }
 
   ~Schema() {
     if (is_manage_) {
@@ -39,6 +49,18 @@ class Schema {
 
   inline uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
 
+  /**
+   * Where a column lives in the fixed-offset row format (see Row): for an INT/FLOAT column the offset of its value
+   * in the fixed part, for a CHAR column its index in the offset table.
+   */
+  inline uint32_t GetFieldSlot(const uint32_t column_index) const { return field_slots_[column_index]; }
+
+  /** @return the size of the fixed part of a row, i.e. of all the INT/FLOAT columns */
+  inline uint32_t GetFixedSize() const { return fixed_size_; }
+
+  /** @return the number of CHAR columns, i.e. entries in the offset table of a row */
+  inline uint32_t GetCharCount() const { return char_count_; }
+
   /**
    * Shallow copy schema, only used in index
    *
@@ -84,6 +106,9 @@ class Schema {
   static constexpr uint32_t SCHEMA_MAGIC_NUM = 200715;
   std::vector<Column *> columns_;
   bool is_manage_ = false; /** if false, don't need to delete pointer to column */
+  std::vector<uint32_t> field_slots_;
+  uint32_t fixed_size_{0};
+  uint32_t char_count_{0};
 };
 
 using IndexSchema = Schema;
@@ -0,0 +1,59 @@
+#ifndef MINISQL_ASYNC_IO_H
+#define MINISQL_ASYNC_IO_H
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+
+/**
+ * One read or write of an AsyncIO batch. A vectored request transfers iovcnt_ buffers to or from consecutive file
+ * offsets, like preadv/pwritev; buf_ is unused and size_ is the total size of the buffers.
+ */
+struct IORequest {
+  int fd_;
+  char *buf_;
+  size_t size_;
+  size_t offset_;
+  bool write_;
+  ssize_t result_{0};  // bytes transferred, or -errno
+  const iovec *iov_{nullptr};
+  int iovcnt_{0};
+};
+
+/**
+ * AsyncIO executes batches of independent reads and writes with many of them in flight at once, so that a device
+ * with deep queues, like an NVMe drive, is kept busy by a single caller.
+ *
+ * The preferred engine is io_uring, driven through raw system calls: a batch is queued into the submission ring and
+ * submitted with one io_uring_enter call per round, up to queue_depth requests are in flight. Where io_uring is not
+ * available (old kernels, seccomp filters) a pool of threads issues pread/pwrite calls instead.
+ *
+ * Short transfers are reported as they are, the caller decides whether the end of the file was hit. An engine may
+ * be shared by several threads, batches of different threads are executed one after another.
+ */
+class AsyncIO {
+ public:
+  virtual ~AsyncIO() = default;
+
+  /**
+   * Execute all requests and wait for them to complete, in any order.
+   * @param[in/out] requests the batch, result_ is set for every request
+   */
+  virtual void Execute(std::vector<IORequest> *requests) = 0;
+
+  /** @return the name of the engine, for logging */
+  virtual const char *Name() const = 0;
+
+  /**
+   * @param queue_depth maximum number of requests in flight
+   * @param use_io_uring false to always use the thread pool
+   * @return an io_uring engine if the kernel allows it, otherwise a thread pool
+   */
+  static std::unique_ptr<AsyncIO> Create(size_t queue_depth = ASYNC_IO_QUEUE_DEPTH, bool use_io_uring = true);
+};
+
+#endif  // MINISQL_ASYNC_IO_H
@@ -2,15 +2,19 @@
 #define DISK_MGR_H
 
 #include <atomic>
-#include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/macros.h"
 #include "page/bitmap_page.h"
 #include "page/disk_file_meta_page.h"
+#include "storage/storage_backend.h"
 
 /**
  * DiskManager takes care of the allocation and de allocation of pages within a database. It performs the reading and
@@ -19,10 +23,58 @@
  * Disk page storage format: (Free Page BitMap Size = PAGE_SIZE * 8, we note it as N)
  * | Meta Page | Free Page BitMap 1 | Page 1 | Page 2 | ....
  *      | Page N | Free Page BitMap 2 | Page N+1 | ... | Page 2N | ... |
+ *
+ * Pages are read and written with positional pread/pwrite and no lock, so threads reading or writing different
+ * pages never wait for each other. Only page allocation, which updates the meta page and the bitmaps, is serialized
+ * by db_io_latch_. Writes reach the OS but are not synced to the device until Sync or Close is called. The file
+ * size is cached, reads beyond the end of the file return zeros without a system call.
+ *
+ * The bitmaps are cached in memory once touched, so allocation does no I/O. The meta page and the dirty bitmaps are
+ * written back by Sync and Close, i.e. at checkpoints, instead of on every allocation. Extents at the end of the file
+ * that become empty are dropped, and Sync truncates the file after the last allocated page.
+ *
+ * An object that grows one page at a time (a table heap, an index) passes a page it already owns as a hint. The
+ * disk manager then reserves a run of up to PAGE_RUN_SIZE adjacent free pages after that page, preallocates them
+ * in the file with fallocate, and hands out the following pages of the object from the run: a hint that lies in
+ * the handed out part of a run continues that run. So an object is laid out contiguously even when several objects
+ * grow at the same time. Reserved pages count as allocated; the unused ones are given back by Sync and Close, so
+ * they never leak into the file.
+ *
+ * All I/O goes through a StorageBackend, a local file unless another backend is passed in, e.g. a MemoryBackend or a
+ * ThrottledBackend for reproducible benchmarks. ReadPageBatch and WritePageBatch hand a whole batch of pages to the
+ * backend; the file backend executes it on an AsyncIO engine (io_uring, or a thread pool where it is missing), so
+ * that many page I/Os are in flight at once. A write batch is sorted by file offset first and physically adjacent
+ * pages are merged into one vectored write, so flushing a large part of the buffer pool costs a few sequential
+ * writes instead of a random write per page.
+ *
+ * With direct I/O the file is also opened with O_DIRECT and all page I/O bypasses the OS page cache, so a page is
+ * only cached once, in the buffer pool. Buffers that are not aligned to DIRECT_IO_ALIGNMENT go through a bounce
+ * buffer. If the file system does not support O_DIRECT, the disk manager silently falls back to buffered I/O.
+ *
+ * A file created with compression keeps its pages in a CompressedBackend: every page is stored compressed with a
+ * small page table from page to stored location and size, the buffer pool still sees plain pages. Compressed files
+ * are recognized when they are opened again, and always use buffered I/O.
+ *
+ * A read-only disk manager has the backend map the file into memory; GetMappedPage gives direct access to
+ * the mapped pages (see MappedBufferPoolManager). Page writes, allocation and de-allocation are rejected, and the
+ * file is never written, not even on Close.
  */
 class DiskManager {
  public:
-  explicit DiskManager(const std::string &db_file);
+  /**
+   * @param direct_io open the file with O_DIRECT if the file system supports it
+   * @param read_only open an existing file read-only and map it into memory
+   * @param compressed create a new file with compressed pages, existing files keep their format
+   */
+  explicit DiskManager(const std::string &db_file, bool direct_io = DEFAULT_DIRECT_IO, bool read_only = false,
+                       bool compressed = DEFAULT_PAGE_COMPRESSION);
+
+  /**
+   * Keep the database on another storage backend. Like the file constructor, throws std::runtime_error if the
+   * storage holds a database with another page size.
+   * @param read_only the backend must be able to map the storage into memory
+   */
+  explicit DiskManager(std::unique_ptr<StorageBackend> backend, bool read_only = false);
 
   ~DiskManager() {
     if (!closed) {
@@ -36,18 +88,45 @@ class DiskManager {
    */
   void ReadPage(page_id_t logical_page_id, char *page_data);
 
+  /**
+   * Read count consecutive logical pages starting at logical_page_id into page_data. Pages that are physically
+   * contiguous, i.e. within the same extent, are read with a single request.
+   */
+  void ReadPages(page_id_t logical_page_id, size_t count, char *page_data);
+
   /**
    * Write data to specific page
    * Note: page_id = 0 is reserved for free page bit map
    */
   void WritePage(page_id_t logical_page_id, const char *page_data);
 
+  /**
+   * Read a batch of logical pages with many reads in flight at once, return when all of them are done.
+   * @param pages page id and destination buffer of every read
+   */
+  void ReadPageBatch(const std::vector<std::pair<page_id_t, char *>> &pages);
+
+  /**
+   * Write a batch of logical pages with many writes in flight at once, return when all of them are done.
+   * Adjacent pages are written with a single pwritev. Like WritePage, the writes are not synced.
+   * @param pages page id and page data of every write, in any order; the last write of a page wins
+   * @return false if a write failed or was rejected, the caller must not consider the pages written
+   */
+  bool WritePageBatch(const std::vector<std::pair<page_id_t, const char *>> &pages);
+
   /**
    * Get next free page from disk
    * @return logical page id of allocated page
    */
   page_id_t AllocatePage();
 
+  /**
+   * Allocate a page that is physically close after near_page_id, from a run of pages reserved for the object that
+   * owns near_page_id.
+   * @return logical page id of allocated page
+   */
+  page_id_t AllocatePage(page_id_t near_page_id);
+
   /**
    * Free this page and reset bit map
    */
@@ -59,7 +138,15 @@ class DiskManager {
   bool IsPageFree(page_id_t logical_page_id);
 
   /**
-   * Shut down the disk manager and close all the file resources.
+   * Give back the unused reserved pages, write back the meta page and the dirty bitmaps, cut the free pages off the
+   * end of the file, then make all page writes so far durable.
+   * @return false on an I/O error
+   */
+  bool Sync();
+
+  /**
+   * Write the meta page and sync the file. Page writes after closing are rejected, the backend itself is released
+   * when the disk manager is destroyed.
    */
   void Close();
 
@@ -69,19 +156,81 @@ class DiskManager {
    */
   char *GetMetaData() { return meta_data_; }
 
+  /** @return true if page I/O bypasses the OS page cache */
+  bool IsDirectIO() const { return backend_->Alignment() > 1; }
+
+  /** @return true if the file was opened read-only */
+  bool IsReadOnly() const { return read_only_; }
+
+  /**
+   * @return the data of a logical page inside the mapping of a read-only file, a page of zeros for a page beyond
+   * the end of the file
+   */
+  const char *GetMappedPage(page_id_t logical_page_id);
+
+  /** @return the number of logical page ids the extents of the file cover */
+  size_t GetMaxPageId() const {
+    return reinterpret_cast<const DiskFileMetaPage *>(meta_data_)->num_extents_ * BITMAP_SIZE;
+  }
+
   static constexpr size_t BITMAP_SIZE = BitmapPage<PAGE_SIZE>::GetMaxSupportedSize();
+  static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
 
  private:
+  /** Raise the cached file size to end if the file grew */
+  void UpdateFileSize(size_t end);
+
   /**
-   * Helper function to get disk file size
+   * Check the magic number and page size in the meta page just read, fill them in for a new file and convert the
+   * meta page of a file written before the header existed.
+   * @return false if the file was created with another page size or is no database file
    */
-  int GetFileSize(const std::string &file_name);
+  bool CheckFileHeader();
+
+  /** @return the cached bitmap of an extent, read from disk on first use */
+  BitmapPage<PAGE_SIZE> *GetBitmap(uint32_t extent);
+
+  /** Start a new extent at the end of the file, the caller must hold db_io_latch_ */
+  bool AddExtent();
+
+  /** Adjacent pages reserved for one object, [begin, next) are handed out, [next, end) are not yet */
+  struct PageRun {
+    page_id_t next_;
+    page_id_t end_;
+  };
+
+  /**
+   * Reserve up to PAGE_RUN_SIZE adjacent pages from the first free page at or after begin, within its extent.
+   * The caller must hold db_io_latch_.
+   * @return the new run, runs_.end() if the extent has no free page from begin on
+   */
+  std::map<page_id_t, PageRun>::iterator ReserveRun(page_id_t begin);
+
+  /** @return the run that handed out page_id and still has pages left, runs_.end() if there is none */
+  std::map<page_id_t, PageRun>::iterator FindRun(page_id_t page_id);
+
+  /** Free the pages of all runs that were not handed out, the caller must hold db_io_latch_ */
+  void ReleaseRuns();
+
+  /** Write the meta page and the dirty bitmaps, the caller must hold db_io_latch_ */
+  void WriteAllocatorMetadata();
+
+  /** Cut the file after the last allocated page, the caller must hold db_io_latch_ */
+  void TruncateFile();
+
+  /** @return the physical page id of the bitmap of an extent */
+  static page_id_t BitmapPageId(uint32_t extent) { return 1 + extent * (BITMAP_SIZE + 1); }
 
   /**
    * Read physical page from disk
    */
   void ReadPhysicalPage(page_id_t physical_page_id, char *page_data);
 
+  /**
+   * Read count contiguous physical pages from disk
+   */
+  void ReadPhysicalPages(page_id_t physical_page_id, size_t count, char *page_data);
+
   /**
    * Write data to physical page in disk
    */
@@ -93,13 +242,26 @@ class DiskManager {
   page_id_t MapPageId(page_id_t logical_page_id);
 
  private:
-  // stream to write db file
-  std::fstream db_io_;
-  std::string file_name_;
-  // with multiple buffer pool instances, need to protect file access
+  // where the pages are stored, released by Close
+  std::unique_ptr<StorageBackend> backend_;
+  // protects the meta page and the bitmaps, page I/O needs no lock
   std::recursive_mutex db_io_latch_;
   bool closed{false};
   char meta_data_[PAGE_SIZE];
+  // size of the file, pages at or beyond it read as zeros
+  std::atomic<size_t> file_size_{0};
+  // bitmaps of the extents touched so far, and whether they differ from the disk copy
+  std::vector<std::unique_ptr<BitmapPage<PAGE_SIZE>>> bitmaps_;
+  std::vector<bool> bitmap_dirty_;
+  bool meta_dirty_{false};
+  // all extents before this one are full
+  uint32_t free_extent_hint_{0};
+  // reserved runs by first page
+  std::map<page_id_t, PageRun> runs_;
+  bool read_only_{false};
+  // the whole file, mapped read-only by the backend
+  const char *mapping_{nullptr};
+  size_t mapping_size_{0};
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,322 @@
+#ifndef MINISQL_STORAGE_BACKEND_H
+#define MINISQL_STORAGE_BACKEND_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "storage/async_io.h"
+
+/**
+ * StorageBackend is the byte-addressed device a DiskManager keeps its pages on. The disk manager decides what goes
+ * where (meta page, bitmaps, extents), the backend only stores bytes at offsets.
+ *
+ * Storage beyond Size() reads as nothing, so reads there return fewer bytes than requested, and writes beyond it
+ * grow the storage. Reads and writes of different ranges may run concurrently.
+ *
+ * FileBackend keeps the pages in a local file, MemoryBackend in memory for benchmarks of our own CPU costs, and
+ * ThrottledBackend wraps another backend with simulated latency and bandwidth, so I/O sensitive changes can be
+ * evaluated reproducibly without a slow disk. CompressedBackend wraps another backend and stores every page
+ * compressed.
+ */
+class StorageBackend {
+ public:
+  virtual ~StorageBackend() = default;
+
+  /**
+   * Read up to size bytes at offset.
+   * @return the number of bytes read, less than size at the end of the storage
+   */
+  virtual size_t Read(char *buf, size_t size, size_t offset) = 0;
+
+  /**
+   * Write size bytes at offset, growing the storage if needed.
+   * @return false on an I/O error
+   */
+  virtual bool Write(const char *buf, size_t size, size_t offset) = 0;
+
+  /**
+   * Execute a batch of independent reads and writes, return when all of them are done. The fd_ of the requests is
+   * ignored. The default executes them one after another.
+   * @param[in/out] requests the batch, result_ is set for every request
+   */
+  virtual void Execute(std::vector<IORequest> *requests);
+
+  /**
+   * Make all writes so far durable.
+   * @return false on an I/O error
+   */
+  virtual bool Sync() = 0;
+
+  /** @return the size of the storage in bytes */
+  virtual size_t Size() = 0;
+
+  /**
+   * Cut the storage to size bytes.
+   * @return false on an I/O error
+   */
+  virtual bool Truncate(size_t size) = 0;
+
+  /** Hint that [offset, offset + size) is about to be written, so it can be laid out in one piece */
+  virtual void Preallocate([[maybe_unused]] size_t offset, [[maybe_unused]] size_t size) {}
+
+  /** @return the alignment I/O buffers must have, 1 if any buffer will do */
+  virtual size_t Alignment() const { return 1; }
+
+  /** @return the whole storage mapped read-only into memory, nullptr if the backend can not map it */
+  virtual const char *Map() { return nullptr; }
+
+  /** @return the name of the backend, or of the file, for logging */
+  virtual const char *Name() const = 0;
+};
+
+/**
+ * A local file, read and written with pread/pwrite. Batches go to an AsyncIO engine created on first use.
+ *
+ * With direct I/O the file is also opened with O_DIRECT and all I/O goes through that descriptor, buffers then have
+ * to be aligned to DIRECT_IO_ALIGNMENT. If the file system does not support O_DIRECT, the backend silently falls
+ * back to buffered I/O. A read-only file is opened O_RDONLY and can be mapped into memory.
+ */
+class FileBackend : public StorageBackend {
+ public:
+  /**
+   * Open or create a file, std::runtime_error if that fails.
+   * @param direct_io open the file with O_DIRECT if the file system supports it
+   * @param read_only open an existing file read-only
+   */
+  FileBackend(const std::string &file_name, bool direct_io, bool read_only);
+
+  ~FileBackend() override;
+
+  size_t Read(char *buf, size_t size, size_t offset) override;
+
+  bool Write(const char *buf, size_t size, size_t offset) override;
+
+  void Execute(std::vector<IORequest> *requests) override;
+
+  bool Sync() override;
+
+  size_t Size() override;
+
+  bool Truncate(size_t size) override;
+
+  /** Reserve the disk space with fallocate, ignored where that is not supported */
+  void Preallocate(size_t offset, size_t size) override;
+
+  size_t Alignment() const override { return direct_fd_ >= 0 ? DIRECT_IO_ALIGNMENT : 1; }
+
+  /** The file is mapped on first use, only read-only files can be mapped */
+  const char *Map() override;
+
+  const char *Name() const override { return file_name_.c_str(); }
+
+  static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+ private:
+  /** @return the descriptor I/O goes through */
+  int IOFd() const { return direct_fd_ >= 0 ? direct_fd_ : fd_; }
+
+ private:
+  std::string file_name_;
+  int fd_{-1};
+  // O_DIRECT descriptor of the same file, -1 for buffered I/O
+  int direct_fd_{-1};
+  bool read_only_;
+  std::once_flag map_once_;
+  char *mapping_{nullptr};
+  size_t mapping_size_{0};
+  std::once_flag async_io_once_;
+  std::unique_ptr<AsyncIO> async_io_;
+};
+
+/**
+ * Storage in memory, nothing is ever written to disk. Reads and writes within the current size run concurrently,
+ * growing and truncating take the latch exclusively.
+ */
+class MemoryBackend : public StorageBackend {
+ public:
+  size_t Read(char *buf, size_t size, size_t offset) override;
+
+  bool Write(const char *buf, size_t size, size_t offset) override;
+
+  bool Sync() override { return true; }
+
+  size_t Size() override;
+
+  bool Truncate(size_t size) override;
+
+  const char *Name() const override { return "memory"; }
+
+ private:
+  std::shared_mutex latch_;
+  std::vector<char> data_;
+};
+
+/** Simulated device characteristics of a ThrottledBackend */
+struct ThrottleOptions {
+  std::chrono::microseconds read_latency_{0};
+  std::chrono::microseconds write_latency_{0};
+  std::chrono::microseconds sync_latency_{0};
+  size_t read_bandwidth_{0};   // bytes per second, 0 for unlimited
+  size_t write_bandwidth_{0};  // bytes per second, 0 for unlimited
+  size_t queue_depth_{1};      // requests of a batch whose latencies overlap
+};
+
+/**
+ * Wraps another backend and makes every operation take at least as long as it would on the simulated device.
+ *
+ * The device has one channel: transfers of all threads queue up on it, each taking size / bandwidth. A request
+ * completes one latency after its transfer. The requests of a batch are served queue_depth at a time, so their
+ * latencies overlap, like on a drive with a deep queue. Time spent in the wrapped backend counts towards the delay.
+ */
+class ThrottledBackend : public StorageBackend {
+ public:
+  ThrottledBackend(std::unique_ptr<StorageBackend> backend, const ThrottleOptions &options)
+      : backend_(std::move(backend)), options_(options) {}
+
+  size_t Read(char *buf, size_t size, size_t offset) override;
+
+  bool Write(const char *buf, size_t size, size_t offset) override;
+
+  void Execute(std::vector<IORequest> *requests) override;
+
+  bool Sync() override;
+
+  size_t Size() override { return backend_->Size(); }
+
+  bool Truncate(size_t size) override { return backend_->Truncate(size); }
+
+  void Preallocate(size_t offset, size_t size) override { backend_->Preallocate(offset, size); }
+
+  size_t Alignment() const override { return backend_->Alignment(); }
+
+  const char *Name() const override { return "throttled"; }
+
+ private:
+  /**
+   * Queue a transfer on the channel.
+   * @param transfer time the channel is busy with the transfer
+   * @param latency time from the end of the transfer until the requests complete
+   * @return the time the requests complete on the simulated device
+   */
+  std::chrono::steady_clock::time_point Schedule(std::chrono::nanoseconds transfer,
+                                                 std::chrono::nanoseconds latency);
+
+ private:
+  std::unique_ptr<StorageBackend> backend_;
+  ThrottleOptions options_;
+  std::mutex latch_;
+  // the channel is busy with earlier transfers until then
+  std::chrono::steady_clock::time_point channel_free_;
+};
+
+/**
+ * Wraps another backend and stores the pages compressed with LZCodec, so a file of padded rows takes a fraction of
+ * the disk space and of the I/O. Callers still see PAGE_SIZE-byte pages at their usual offsets.
+ *
+ * Storage format of the wrapped backend, in slots of SLOT_SIZE bytes:
+ *  | Header | compressed pages and the page table, in any order, with free slots in between |
+ *
+ * The page table maps every page to the slot its data starts at and its stored size: 0 for a page of zeros, which
+ * takes no slots, PAGE_SIZE for a page that did not compress, which is stored as is, anything else for compressed
+ * data. A page is never rewritten in place: every write goes to the first run of free slots that is large enough,
+ * or to the end of the storage.
+ *
+ * The page table lives in memory and is written by Sync, into free slots, and synced together with the page data
+ * before the header is pointed at it and synced in turn.
+ * Slots the last written table still refers to are only reused after the next Sync, so a crash between two Syncs
+ * leaves the storage as of the last Sync. Sync also cuts free slots off the end of the storage.
+ *
+ * Reads of different pages run concurrently, writes are serialized by latch_; compression runs outside the latch.
+ * Map decompresses the whole storage into memory once, for read-only databases.
+ */
+class CompressedBackend : public StorageBackend {
+ public:
+  /**
+   * Wrap an empty storage or one written by a CompressedBackend, std::runtime_error for anything else.
+   */
+  explicit CompressedBackend(std::unique_ptr<StorageBackend> backend);
+
+  /** @return whether the storage holds compressed pages */
+  static bool IsCompressed(StorageBackend *backend);
+
+  size_t Read(char *buf, size_t size, size_t offset) override;
+
+  bool Write(const char *buf, size_t size, size_t offset) override;
+
+  bool Sync() override;
+
+  size_t Size() override;
+
+  /** The size is rounded up to whole pages */
+  bool Truncate(size_t size) override;
+
+  const char *Map() override;
+
+  const char *Name() const override { return backend_->Name(); }
+
+  static constexpr size_t SLOT_SIZE = 512;
+  static constexpr uint64_t MAGIC = 0x315a4c51534dULL;  // "MSQLZ1"
+
+ private:
+  struct Header {
+    uint64_t magic_;
+    uint32_t page_size_;
+    uint32_t slot_size_;
+    uint32_t table_slot_;
+    uint32_t num_pages_;
+  };
+
+  struct Entry {
+    uint32_t slot_{0};
+    uint32_t size_{0};  // 0 for a page of zeros, PAGE_SIZE for an uncompressed page
+  };
+
+  static uint32_t SlotCount(size_t size) { return (size + SLOT_SIZE - 1) / SLOT_SIZE; }
+
+  /**
+   * Compress a page.
+   * @param[out] out PAGE_SIZE bytes for the stored form
+   * @return the stored size
+   */
+  static uint32_t Encode(const char *page, char *out);
+
+  /** Read and decompress a page, the caller holds latch_ */
+  bool ReadPage(size_t page_no, char *page_data);
+
+  /** Store an encoded page, the caller holds latch_ exclusively */
+  bool StorePage(size_t page_no, const char *data, uint32_t size);
+
+  /** Take count slots from the free slots or the end of the storage */
+  uint32_t AllocateSlots(uint32_t count);
+
+  /** Give slots back, merging them with their free neighbours */
+  void FreeSlots(uint32_t slot, uint32_t count);
+
+  /** Free slots once the next page table is durable */
+  void ReleaseSlots(uint32_t slot, uint32_t count) {
+    if (count > 0) pending_free_.emplace_back(slot, count);
+  }
+
+ private:
+  std::unique_ptr<StorageBackend> backend_;
+  std::shared_mutex latch_;
+  std::vector<Entry> entries_;
+  // free runs of slots, first slot -> number of slots
+  std::map<uint32_t, uint32_t> free_;
+  // slots the last written page table may still refer to
+  std::vector<std::pair<uint32_t, uint32_t>> pending_free_;
+  // pages stored since the last Sync, their slots are not in the last written page table
+  std::unordered_set<size_t> unsynced_pages_;
+  Entry table_;           // where the last written page table is
+  uint32_t end_slot_{1};  // slot 0 is the header
+  std::once_flag map_once_;
+  std::vector<char> mapping_;
+};
+
+#endif  // MINISQL_STORAGE_BACKEND_H
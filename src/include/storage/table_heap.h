@@ -1,13 +1,30 @@
 #ifndef MINISQL_TABLE_HEAP_H
 #define MINISQL_TABLE_HEAP_H
 
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "buffer/buffer_pool_manager.h"
+#include "page/free_space_map_page.h"
 #include "page/header_page.h"
 #include "page/table_page.h"
 #include "storage/table_iterator.h"
 #include "transaction/lock_manager.h"
 #include "transaction/log_manager.h"
 
+/**
+ * TableHeap is a chain of table pages. Next to the chain it keeps a free space map (FSM), a chain of
+ * FreeSpaceMapPages listing every table page with the free space it has, kept up to date by inserts, updates and
+ * deletes. An insert asks the map for a page with enough room instead of trying the pages of the chain one by one;
+ * only if no page has room, a page is appended.
+ *
+ * The map is read into memory on first use, as the position of every table page in the map and the largest free
+ * space of every map page, so finding a page costs one map page fetch. A heap opened without a map, e.g. one
+ * created before the map existed, builds one from its pages on first use; the owner of the heap persists
+ * GetFreeSpaceMapPageId next to the first page id.
+ */
 class TableHeap {
   friend class TableIterator;
 
@@ -17,9 +34,14 @@ class TableHeap {
     return new TableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager);
   }
 
+  /**
+   * Open an existing table heap.
+   * @param fsm_page_id first page of its free space map, INVALID_PAGE_ID to build a new map on first use
+   */
   static TableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                           LogManager *log_manager, LockManager *lock_manager) {
-    return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
+                           LogManager *log_manager, LockManager *lock_manager,
+                           page_id_t fsm_page_id = INVALID_PAGE_ID) {
+    return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager, fsm_page_id);
   }
 
   ~TableHeap() {}
@@ -32,6 +54,16 @@ class TableHeap {
    */
   bool InsertTuple(Row &row, Transaction *txn);
 
+  /**
+   * Insert many tuples at once, for loading data. The tuples are packed into the last page of the chain and then
+   * into new pages appended after it, each page filled up before the next one is allocated; free space elsewhere in
+   * the heap is not looked for. Other inserts wait until the whole batch is in.
+   * @param[in/out] rows tuples to insert in this order, the rid of every inserted tuple is set
+   * @param[in] txn the transaction performing the insert
+   * @return the number of tuples inserted, fewer than rows.size() if a tuple is too large or no page was left
+   */
+  size_t BulkInsert(std::vector<Row> &rows, Transaction *txn);
+
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
    * @param[in] rid Resource id of the tuple of delete
@@ -67,31 +99,57 @@ class TableHeap {
    * Read a tuple from the table.
    * @param[in/out] row Output variable for the tuple, row id of the tuple is wrapped in row
    * @param[in] txn transaction performing the read
+   * @param[in] ring access strategy of the scan the read belongs to, if any
    * @return true if the read was successful (i.e. the tuple exists)
    */
-  bool GetTuple(Row *row, Transaction *txn);
+  bool GetTuple(Row *row, Transaction *txn, BufferRing *ring = nullptr);
+
+  /**
+   * Visit the live tuples of a page as views over the page bytes, for scans that only keep some of the tuples. The
+   * page stays pinned and read latched while visit runs, so visit must not write the table, and must materialize a
+   * view it wants to keep (RowView::ToRow).
+   * The page must be fetchable: a page that can not be fetched is a failure, never the end of the chain.
+   * @param read_ahead read-ahead state of a scan that walks the page chain, if any
+   * @return the next page of the table, INVALID_PAGE_ID after the last one
+   */
+  page_id_t ScanPage(page_id_t page_id, const std::function<void(const RowView &view)> &visit,
+                     BufferRing *ring = nullptr, ReadAheadTracker *read_ahead = nullptr);
 
   void FreeTableHeap() {
+    BufferRing ring;  // 整条链只读一遍，不要挤占缓冲池
     auto next_page_id = first_page_id_;
     while (next_page_id != INVALID_PAGE_ID) {
       auto old_page_id = next_page_id;
-      auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id));
+      auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id, &ring));
       assert(page != nullptr);
       next_page_id = page->GetNextPageId();
       buffer_pool_manager_->UnpinPage(old_page_id, false);
       buffer_pool_manager_->DeletePage(old_page_id);
     }
+    DeleteFreeSpaceMap();
   }
 
   /**
-   * Free table heap and release storage in disk file
+   * Free table heap and release storage in disk file, the free space map too if page_id is the first page
    */
   void DeleteTable(page_id_t page_id = INVALID_PAGE_ID);
 
   /**
+   * Compact the table: tuples are moved from the last pages of the chain into free space of the first ones, then
+   * the pages that became empty are unlinked and freed. No other statement may use the table meanwhile; inserts
+   * wait, as the free space map latch is held throughout.
+   * @param txn transaction performing the vacuum
+   * @param on_move called for every moved tuple with the row at its new place and the old row id, so that the
+   *                caller can update the indexes
+   * @return the number of pages freed
+   */
+  size_t Vacuum(Transaction *txn, const std::function<void(const Row &row, const RowId &old_rid)> &on_move);
+
+  /**
+   * @param ring access strategy of the scan, pass one for scans that may be larger than the buffer pool
    * @return the begin iterator of this table
    */
-  TableIterator Begin(Transaction *txn);
+  TableIterator Begin(Transaction *txn, BufferRing *ring = nullptr);
 
   /**
    * @return the end iterator of this table
@@ -103,6 +161,16 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * @return the id of the first page of the free space map, created if the heap has none yet
+   */
+  page_id_t GetFreeSpaceMapPageId();
+
+  /**
+   * Rewrite the free space map from the free space of every page of the chain.
+   */
+  void RebuildFreeSpaceMap();
+
 private:
   /**
    * create table heap and initialize first page
@@ -115,16 +183,48 @@ private:
           lock_manager_(lock_manager) {
     auto page=reinterpret_cast<TablePage*>(buffer_pool_manager->NewPage(first_page_id_));
     page->Init(first_page_id_,INVALID_PAGE_ID,this->log_manager_,txn);
-    this->buffer_pool_manager_->UnpinPage(this->first_page_id_,false);
+    uint32_t free_space=page->GetFreeSpaceForInsert();
+    this->buffer_pool_manager_->UnpinPage(this->first_page_id_,true);//初始化过的页要写回磁盘
+    std::scoped_lock<std::mutex> lock(fsm_latch_);
+    fsm_loaded_=true;
+    AppendToFreeSpaceMap(first_page_id_,free_space);
   };
 
   explicit TableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
-                     LogManager *log_manager, LockManager *lock_manager)
+                     LogManager *log_manager, LockManager *lock_manager, page_id_t fsm_page_id)
       : buffer_pool_manager_(buffer_pool_manager),
         first_page_id_(first_page_id),
         schema_(schema),
         log_manager_(log_manager),
-        lock_manager_(lock_manager) {}
+        lock_manager_(lock_manager),
+        fsm_page_id_(fsm_page_id) {}
+
+  /** Read the free space map into memory, or build it if there is none; the caller holds fsm_latch_ */
+  void LoadFreeSpaceMap();
+
+  /** Rewrite the free space map from the pages of the chain, the caller holds fsm_latch_ */
+  void BuildFreeSpaceMap();
+
+  /**
+   * Look a page up in the free space map, the caller holds fsm_latch_.
+   * @return a page that has size bytes free, INVALID_PAGE_ID if there is none
+   */
+  page_id_t FindPageWithSpace(uint32_t size);
+
+  /** Record the free space of a page after a change, takes fsm_latch_ */
+  void UpdateFreeSpace(page_id_t page_id, uint32_t free_space);
+
+  /** Record the free space of a page, the caller holds fsm_latch_ */
+  void SetFreeSpace(page_id_t page_id, uint32_t free_space);
+
+  /** Add a page appended to the chain to the map, the caller holds fsm_latch_ */
+  bool AppendToFreeSpaceMap(page_id_t page_id, uint32_t free_space);
+
+  /** @return the pages of the free space map, the caller holds fsm_latch_ */
+  std::vector<page_id_t> GetFreeSpaceMapPages();
+
+  /** Give the pages of the free space map back to the buffer pool */
+  void DeleteFreeSpaceMap();
 
  private:
   BufferPoolManager *buffer_pool_manager_;
@@ -132,6 +232,14 @@ private:
   Schema *schema_;
   [[maybe_unused]] LogManager *log_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
+  // 空闲空间表，下面的成员都由fsm_latch_保护
+  std::mutex fsm_latch_;
+  page_id_t fsm_page_id_{INVALID_PAGE_ID};
+  bool fsm_loaded_{false};
+  std::vector<page_id_t> fsm_pages_;                   // the pages of the map in chain order
+  std::vector<uint8_t> fsm_max_categories_;            // per map page, no category of it is larger
+  std::unordered_map<page_id_t, size_t> fsm_entries_;  // table page -> its position in the map
+  page_id_t last_page_id_{INVALID_PAGE_ID};            // the last page of the chain
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
@@ -1,19 +1,32 @@
 #ifndef MINISQL_TABLE_ITERATOR_H
 #define MINISQL_TABLE_ITERATOR_H
 
+#include <vector>
+
+#include "buffer/buffer_ring.h"
+#include "buffer/read_ahead_tracker.h"
 #include "common/rowid.h"
 #include "record/row.h"
 #include "transaction/transaction.h"
 
 class TableHeap;
 
+/**
+ * Scan cursor over a table heap. It works a page at a time: a page is pinned once, all its live tuples are decoded
+ * into a batch of rows, and the page is unpinned again before the first of them is returned. The rows of the batch
+ * are reused for the next page, so a scan does not allocate a Row per tuple. A row returned by operator* stays
+ * valid until the iterator moves to the next page.
+ */
 class TableIterator {
 public:
   // you may define your own constructor based on your member variables
  explicit TableIterator(){};
- explicit TableIterator(TableHeap* tableHeap,RowId rid);
+ /**
+  * @param ring access strategy of the scan, nullptr to go through the shared buffer pool
+  */
+ explicit TableIterator(TableHeap* tableHeap,RowId rid,BufferRing *ring = nullptr);
 
-  explicit TableIterator(const TableIterator &other);
+  TableIterator(const TableIterator &other);
 
   virtual ~TableIterator();
 
@@ -31,10 +44,27 @@ public:
 
   TableIterator operator++(int);
 
+private:
+  /** Decode the live tuples of a page into rows_ and remember the next page of the chain */
+  void LoadPage(page_id_t page_id);
+
+  /** Move on to the next page with a live tuple if the batch is used up, to the end if there is none */
+  void SkipEmptyPages();
+
+  /** @return the row id of the current tuple, INVALID_ROWID at the end */
+  RowId GetRowId() const { return cursor_ < count_ ? rows_[cursor_].GetRowId() : INVALID_ROWID; }
+
 private:
   // add your own private member variables here
- TableHeap* table_heap_;
- Row* row;
+ TableHeap* table_heap_{nullptr};
+ BufferRing *ring_{nullptr};
+ ReadAheadTracker read_ahead_;
+ // 当前页上没删除的元组，换页时Row复用；只有前count_个有效
+ std::vector<Row> rows_;
+ size_t count_{0};
+ size_t cursor_{0};
+ page_id_t next_page_id_{INVALID_PAGE_ID};
+ Row end_row_{INVALID_ROWID};  // 到头之后*返回它
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
@@ -18,6 +18,7 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
       leaf_max_size_(LEAF_PAGE_SIZE),
       internal_max_size_(INTERNAL_PAGE_SIZE) {
   Page* page=buffer_pool_manager->FetchPage(INDEX_ROOTS_PAGE_ID);
+  page->SetPageClass(PageClass::kMeta);
   auto index_roots_page=reinterpret_cast<IndexRootsPage*>(page->GetData());
   index_roots_page->GetRootId(index_id,&this->root_page_id_);
   buffer_pool_manager->UnpinPage(INDEX_ROOTS_PAGE_ID,false);
@@ -45,7 +46,7 @@ bool BPlusTree::IsEmpty() const {
  */
 bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Transaction *transaction) {
   if(this->IsEmpty()) return false;
-  BPlusTreeLeafPage* leaf_page=reinterpret_cast<BPlusTreeLeafPage*>(this->FindLeafPage(key));
+  BPlusTreeLeafPage* leaf_page=reinterpret_cast<BPlusTreeLeafPage*>(this->FindLeafPage(key)->GetData());
   //遍历leaf_page
   RowId value;
   if(!leaf_page->Lookup(key,value,processor_)){//not exist
@@ -68,6 +69,7 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Tran
  * keys return false, otherwise return true.
  */
 bool BPlusTree::Insert(GenericKey *key, const RowId &value, Transaction *transaction) {
+  if(buffer_pool_manager_->IsReadOnly()) return false;//只读数据库
   if(this->IsEmpty()){//数空
     this->StartNewTree(key,value);
   }else{//树不空
@@ -75,6 +77,68 @@ bool BPlusTree::Insert(GenericKey *key, const RowId &value, Transaction *transac
   }
   return true;
 }
+bool BPlusTree::BulkLoad(const char *keys, const std::vector<RowId> &values) {
+  if (!IsEmpty() || values.empty() || buffer_pool_manager_->IsReadOnly()) return false;
+  size_t key_size = processor_.GetKeySize();
+  auto key_at = [&](size_t i) { return reinterpret_cast<GenericKey *>(const_cast<char *>(keys + i * key_size)); };
+  // 当前这一层的节点：页号和它子树里最小的键的下标
+  std::vector<std::pair<page_id_t, size_t>> level;
+  // 条目平均分到各页，最后一页不会比别的页空太多
+  size_t count = (values.size() + leaf_max_size_ - 1) / leaf_max_size_;
+  LeafPage *prev_leaf = nullptr;
+  for (size_t i = 0, begin = 0; i < count; i++) {
+    size_t end = values.size() * (i + 1) / count;
+    page_id_t page_id;
+    Page *page = buffer_pool_manager_->NewPage(page_id, level.empty() ? INVALID_PAGE_ID : level.back().first);
+    ASSERT(page != nullptr, "out of memory");
+    page->SetPageClass(PageClass::kIndexLeaf);
+    auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    leaf->Init(page_id, INVALID_PAGE_ID, key_size, leaf_max_size_);
+    for (size_t j = begin; j < end; j++) {
+      leaf->SetKeyAt(j - begin, key_at(j));
+      leaf->SetValueAt(j - begin, values[j]);
+    }
+    leaf->SetSize(end - begin);
+    if (prev_leaf != nullptr) {
+      prev_leaf->SetNextPageId(page_id);
+      buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+    }
+    prev_leaf = leaf;
+    level.emplace_back(page_id, begin);
+    begin = end;
+  }
+  buffer_pool_manager_->UnpinPage(prev_leaf->GetPageId(), true);
+  // 一层一层往上建，直到只剩一个节点，它就是根
+  while (level.size() > 1) {
+    std::vector<std::pair<page_id_t, size_t>> parents;
+    count = (level.size() + internal_max_size_ - 1) / internal_max_size_;
+    for (size_t i = 0, begin = 0; i < count; i++) {
+      size_t end = level.size() * (i + 1) / count;
+      page_id_t page_id;
+      Page *page = buffer_pool_manager_->NewPage(page_id, level[begin].first);
+      ASSERT(page != nullptr, "out of memory");
+      page->SetPageClass(PageClass::kIndexInternal);
+      auto node = reinterpret_cast<InternalPage *>(page->GetData());
+      node->Init(page_id, INVALID_PAGE_ID, key_size, internal_max_size_);
+      for (size_t j = begin; j < end; j++) {
+        node->SetKeyAt(j - begin, key_at(level[j].second));
+        node->SetValueAt(j - begin, level[j].first);
+        auto child = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(level[j].first)->GetData());
+        child->SetParentPageId(page_id);
+        buffer_pool_manager_->UnpinPage(level[j].first, true);
+      }
+      node->SetSize(end - begin);
+      buffer_pool_manager_->UnpinPage(page_id, true);
+      parents.emplace_back(page_id, level[begin].second);
+      begin = end;
+    }
+    level.swap(parents);
+  }
+  root_page_id_ = level[0].first;
+  UpdateRootPageId(1);
+  return true;
+}
+
 /*
  * Insert constant key & value pair into an empty tree
  * User needs to first ask for new page from buffer pool manager(NOTICE: throw
@@ -85,6 +149,7 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
   //获得一块新的page
   Page* page=this->buffer_pool_manager_->NewPage(this->root_page_id_);
   ASSERT(page!= nullptr,"out of memory");
+  page->SetPageClass(PageClass::kIndexLeaf);
   BPlusTreeLeafPage* root_page=reinterpret_cast<BPlusTreeLeafPage*>(page->GetData());
   //初始化
   root_page->Init(root_page_id_,INVALID_PAGE_ID,processor_.GetKeySize(),this->leaf_max_size_);
@@ -138,8 +203,9 @@ bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Transaction
  */
 BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Transaction *transaction) {
   page_id_t new_page_id;
-  Page* new_page=buffer_pool_manager_->NewPage(new_page_id);
+  Page* new_page=buffer_pool_manager_->NewPage(new_page_id,node->GetPageId());//放在被分裂的页附近
   ASSERT(new_page!= nullptr,"out of memory");
+  new_page->SetPageClass(PageClass::kIndexInternal);
   BPlusTreeInternalPage* new_node=reinterpret_cast<BPlusTreeInternalPage*>(new_page->GetData());
   new_node->Init(new_page_id,node->GetParentPageId(),processor_.GetKeySize(),this->internal_max_size_);
   node->MoveHalfTo(new_node,buffer_pool_manager_);
@@ -148,8 +214,9 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Transaction *transac
 
 BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Transaction *transaction) {
   page_id_t new_page_id;
-  Page* new_page=buffer_pool_manager_->NewPage(new_page_id);
+  Page* new_page=buffer_pool_manager_->NewPage(new_page_id,node->GetPageId());//放在被分裂的页附近
   ASSERT(new_page!= nullptr,"out of memory");
+  new_page->SetPageClass(PageClass::kIndexLeaf);
   BPlusTreeLeafPage* new_node=reinterpret_cast<BPlusTreeLeafPage*>(new_page->GetData());
   new_node->Init(new_page_id,node->GetParentPageId(),processor_.GetKeySize(),this->leaf_max_size_);
   node->MoveHalfTo(new_node);
@@ -175,8 +242,9 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
   BPlusTreeInternalPage* parent_node;
   if(old_node->IsRootPage()){//如果old_node是根节点
     //新建一个根节点
-    parent_page=buffer_pool_manager_->NewPage(parent_page_id);
+    parent_page=buffer_pool_manager_->NewPage(parent_page_id,old_node->GetPageId());
     this->root_page_id_=parent_page_id;//记得更改
+    parent_page->SetPageClass(PageClass::kIndexInternal);
     parent_node=reinterpret_cast<BPlusTreeInternalPage*>(parent_page->GetData());
     parent_node->Init(parent_page_id,INVALID_PAGE_ID,processor_.GetKeySize(),this->internal_max_size_);
     //插入数据
@@ -224,7 +292,7 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
  * necessary.
  */
 void BPlusTree::Remove(const GenericKey *key, Transaction *transaction) {
-  if(IsEmpty()) return;//empty
+  if(IsEmpty()||buffer_pool_manager_->IsReadOnly()) return;//empty或只读
   Page* leaf_page=this->FindLeafPage(key);
   BPlusTreeLeafPage* leaf_node=reinterpret_cast<BPlusTreeLeafPage*>(leaf_page->GetData());
   leaf_node->RemoveAndDeleteRecord(key,processor_);
@@ -299,11 +367,9 @@ bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage
   //删除node，不需要设置为为dirty
   buffer_pool_manager_->UnpinPage(node->GetPageId(),false);
   buffer_pool_manager_->DeletePage(node->GetPageId());
-  //parent是根节点
-  if(parent->IsRootPage()) return parent->GetSize()>1?false:true;
-  else if(parent->GetSize()<parent->GetMinSize()){
+  //parent不够半满就继续向上调整，parent是根节点时只剩一个孩子才由AdjustRoot换根
+  if(parent->GetSize()<parent->GetMinSize())
     return this->CoalesceOrRedistribute<BPlusTreeInternalPage>(parent,transaction);
-  }
   return false;
 }
 
@@ -316,7 +382,7 @@ bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, Inte
   //删除node，不需要设置为为dirty
   buffer_pool_manager_->UnpinPage(node->GetPageId(),false);
   buffer_pool_manager_->DeletePage(node->GetPageId());
-  if(parent->IsRootPage()&&parent->GetSize()<parent->GetMinSize())
+  if(parent->GetSize()<parent->GetMinSize())
     return this->CoalesceOrRedistribute<BPlusTreeInternalPage>(parent,transaction);
   return false;
 }
@@ -340,7 +406,7 @@ void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, int index)
   }
   else{
     neighbor_node->MoveLastToFrontOf(node);
-    int p_index=parent_node->ValueAt(node->GetPageId());
+    int p_index=parent_node->ValueIndex(node->GetPageId());
     parent_node->SetKeyAt(p_index,node->KeyAt(0));
   }
   buffer_pool_manager_->UnpinPage(parent_page->GetPageId(),true);
@@ -354,9 +420,10 @@ void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, in
     parent_node->SetKeyAt(p_index,neighbor_node->KeyAt(0));//value不用改;
   }
   else{
-    int p_index=parent_node->ValueAt(node->GetPageId());
+    int p_index=parent_node->ValueIndex(node->GetPageId());
     neighbor_node->MoveLastToFrontOf(node,parent_node->KeyAt(p_index),buffer_pool_manager_);
-    parent_node->SetKeyAt(p_index,node->KeyAt(0));
+    //移走的是neighbor的最后一个，它的key成为新的分隔key
+    parent_node->SetKeyAt(p_index,neighbor_node->KeyAt(neighbor_node->GetSize()));
   }
   buffer_pool_manager_->UnpinPage(parent_page->GetPageId(),true);
 }
@@ -407,7 +474,10 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
 IndexIterator BPlusTree::Begin() {
   GenericKey* key;
   Page* left_page=this->FindLeafPage(key,INVALID_PAGE_ID,true);
-  return IndexIterator(left_page->GetPageId(),buffer_pool_manager_,0);
+  if(left_page==nullptr) return End();//空树
+  page_id_t page_id=left_page->GetPageId();
+  buffer_pool_manager_->UnpinPage(page_id,false);//iterator会自己再pin一次
+  return IndexIterator(page_id,buffer_pool_manager_,0);
 }
 
 /*
@@ -417,9 +487,12 @@ IndexIterator BPlusTree::Begin() {
  */
 IndexIterator BPlusTree::Begin(const GenericKey *key) {
   Page* page=this->FindLeafPage(key,0, false);
-  BPlusTreeLeafPage* node=reinterpret_cast<BPlusTreeLeafPage*>(page);
+  if(page==nullptr) return End();//空树
+  BPlusTreeLeafPage* node=reinterpret_cast<BPlusTreeLeafPage*>(page->GetData());
   int index=node->KeyIndex(key,processor_);
-  return IndexIterator(page->GetPageId(),buffer_pool_manager_,index);
+  page_id_t page_id=page->GetPageId();
+  buffer_pool_manager_->UnpinPage(page_id,false);//iterator会自己再pin一次
+  return IndexIterator(page_id,buffer_pool_manager_,index);
 }
 
 /*
@@ -444,6 +517,7 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
   Page* page=this->buffer_pool_manager_->FetchPage(this->root_page_id_);//根
   auto bp_page=reinterpret_cast<BPlusTreePage*>(page->GetData());
   while(!bp_page->IsLeafPage()){
+    page->SetPageClass(PageClass::kIndexInternal);//上层节点尽量留在内存里
     auto internal_page=reinterpret_cast<BPlusTreeInternalPage*>(bp_page);
     page_id_t page_id;//next_page_id
     if(leftMost) page_id=internal_page->ValueAt(0);
@@ -452,6 +526,7 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
     page=this->buffer_pool_manager_->FetchPage(page_id);
     bp_page=reinterpret_cast<BPlusTreePage*>(page->GetData());
   }
+  page->SetPageClass(PageClass::kIndexLeaf);
   return page;//函数外记得Unpin
 }
 
@@ -465,9 +540,11 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
  */
 void BPlusTree::UpdateRootPageId(int insert_record) {
   Page* index_page=buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  index_page->SetPageClass(PageClass::kMeta);
   IndexRootsPage* index_roots_page=reinterpret_cast<IndexRootsPage*>(index_page->GetData());
   if(insert_record==0) index_roots_page->Update(index_id_,root_page_id_);
-  else index_roots_page->Insert(this->index_id_,this->root_page_id_);
+  else if(!index_roots_page->Insert(this->index_id_,this->root_page_id_))//删空过的树还留着记录，改掉它
+    index_roots_page->Update(index_id_,root_page_id_);
   buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID,true);
 }
 
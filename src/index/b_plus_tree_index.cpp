@@ -27,6 +27,57 @@ dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Transaction *t
   return DB_SUCCESS;
 }
 
+/** @return -1, 0 or 1 as the fields of lhs are less than, equal to or greater than those of rhs */
+static int CompareKeyRows(const Row &lhs, const Row &rhs) {
+  for (uint32_t i = 0; i < lhs.GetFieldCount(); i++) {
+    if (lhs.GetField(i)->CompareLessThan(*rhs.GetField(i)) == CmpBool::kTrue) return -1;
+    if (lhs.GetField(i)->CompareGreaterThan(*rhs.GetField(i)) == CmpBool::kTrue) return 1;
+  }
+  return 0;
+}
+
+dberr_t BPlusTreeIndex::InsertEntries(const std::vector<std::pair<Row, RowId>> &entries, Transaction *txn) {
+  if (entries.empty()) return DB_SUCCESS;
+  // 排序的是下标，Row本身不用搬
+  std::vector<size_t> order(entries.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&](size_t lhs, size_t rhs) { return CompareKeyRows(entries[lhs].first, entries[rhs].first) < 0; });
+  // 排好序后，重复的键一定相邻
+  for (size_t i = 1; i < order.size(); i++) {
+    if (CompareKeyRows(entries[order[i - 1]].first, entries[order[i]].first) == 0) return DB_FAILED;
+  }
+  if (container_.IsEmpty()) {
+    // 空树直接自底向上建，不用一个个插
+    size_t key_size = processor_.GetKeySize();
+    std::vector<char> keys(order.size() * key_size);
+    std::vector<RowId> values;
+    values.reserve(order.size());
+    GenericKey *index_key = processor_.InitKey();
+    for (size_t i = 0; i < order.size(); i++) {
+      processor_.SerializeFromKey(index_key, entries[order[i]].first, key_schema_);
+      memcpy(&keys[i * key_size], index_key, key_size);
+      values.push_back(entries[order[i]].second);
+    }
+    delete index_key;
+    return container_.BulkLoad(keys.data(), values) ? DB_SUCCESS : DB_FAILED;
+  }
+  GenericKey *index_key = processor_.InitKey();
+  size_t inserted = 0;
+  for (; inserted < order.size(); inserted++) {
+    processor_.SerializeFromKey(index_key, entries[order[inserted]].first, key_schema_);
+    if (!container_.Insert(index_key, entries[order[inserted]].second, txn)) break;
+  }
+  // 键已经在索引里，把这一批插进去的删掉
+  bool failed = inserted < order.size();
+  while (failed && inserted > 0) {
+    processor_.SerializeFromKey(index_key, entries[order[--inserted]].first, key_schema_);
+    container_.Remove(index_key, txn);
+  }
+  delete index_key;
+  return failed ? DB_FAILED : DB_SUCCESS;
+}
+
 dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Transaction *txn) {
   GenericKey *index_key = processor_.InitKey();
   processor_.SerializeFromKey(index_key, key, key_schema_);
@@ -3,13 +3,19 @@
 #include "index/basic_comparator.h"
 #include "index/generic_key.h"
 
+static page_id_t NextLeafPage(Page *page) {
+  return reinterpret_cast<BPlusTreeLeafPage *>(page->GetData())->GetNextPageId();
+}
+
 IndexIterator::IndexIterator() = default;
 
 IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index)
     : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm) {
-  if(page_id!=INVALID_PAGE_ID)
-    page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
-  else{
+  if(page_id!=INVALID_PAGE_ID) {
+    Page *leaf_page = buffer_pool_manager->FetchPage(current_page_id);
+    leaf_page->SetPageClass(PageClass::kIndexLeaf);
+    page = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+  } else{
     page= nullptr;
     index=0;//Invalid的话把index都设置为0方便比较
   }
@@ -33,9 +39,12 @@ IndexIterator &IndexIterator::operator++() {
     page_id_t pre_page_id=this->current_page_id;//原来的page_id
     this->current_page_id=page->GetNextPageId();
     buffer_pool_manager->UnpinPage(pre_page_id,false);
-    if(this->current_page_id!=INVALID_PAGE_ID)
-      page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id));
-    else page= nullptr;
+    if(this->current_page_id!=INVALID_PAGE_ID) {
+      Page *leaf_page = buffer_pool_manager->FetchPage(current_page_id);
+      leaf_page->SetPageClass(PageClass::kIndexLeaf);
+      page = reinterpret_cast<LeafPage *>(leaf_page->GetData());
+      read_ahead.OnNextPage(buffer_pool_manager, current_page_id, NextLeafPage);  // 顺序扫描叶子时预读
+    } else page= nullptr;
     this->item_index=0;
   }
   return *this;
@@ -1,5 +1,7 @@
 #include "page/bitmap_page.h"
 
+#include <cstring>
+
 #include "glog/logging.h"
 
 /**
@@ -7,20 +9,28 @@
  */
 template <size_t PageSize>
 bool BitmapPage<PageSize>::AllocatePage(uint32_t &page_offset) {
-  if(page_allocated_<this->GetMaxSupportedSize()){
-    page_offset=next_free_page_;//将空闲数据页的序号给offset
-    page_allocated_++;
-    //将标记设置为1
-    this->bytes[page_offset/8]|=((unsigned char)0x80)>>(page_offset%8);
-    //重新获得next_free_page_,从0开始找
-    next_free_page_=0;
-    while(next_free_page_<this->GetMaxSupportedSize()){
-      if(IsPageFreeLow(next_free_page_/8,next_free_page_%8)) break;
-      next_free_page_++;
-    }
-    return true;
+  if (page_allocated_ >= GetMaxSupportedSize()) return false;
+  // next_free_page_之前的页一般都已分配，从它开始找，找不到再从头找
+  page_offset = FindFreePage(next_free_page_ < GetMaxSupportedSize() ? next_free_page_ : 0);
+  if (page_offset == GetMaxSupportedSize()) page_offset = FindFreePage(0);
+  if (page_offset == GetMaxSupportedSize()) {
+    LOG(ERROR) << "Bitmap page counts " << page_allocated_ << " pages but has no free bit" << std::endl;
+    return false;
   }
-  return false;
+  page_allocated_++;
+  //将标记设置为1
+  this->bytes[page_offset/8]|=((unsigned char)0x80)>>(page_offset%8);
+  next_free_page_ = page_offset + 1;
+  return true;
+}
+
+template <size_t PageSize>
+bool BitmapPage<PageSize>::AllocatePageAt(uint32_t page_offset) {
+  if (!IsPageFree(page_offset)) return false;
+  page_allocated_++;
+  this->bytes[page_offset/8]|=((unsigned char)0x80)>>(page_offset%8);
+  if (page_offset == next_free_page_) next_free_page_ = page_offset + 1;
+  return true;
 }
 
 /**
@@ -30,9 +40,8 @@ template <size_t PageSize>
 bool BitmapPage<PageSize>::DeAllocatePage(uint32_t page_offset) {
   if(!this->IsPageFreeLow(page_offset/8,page_offset%8)){
     page_allocated_--;
-    next_free_page_=page_offset;//如果不满也可以不执行
-//    if(next_free_page_>=this->GetMaxSupportedSize())
-//      next_free_page_=page_offset;
+    // 保持next_free_page_之前的页都已分配
+    if (page_offset < next_free_page_) next_free_page_ = page_offset;
     //将标记设置为0
     this->bytes[page_offset/8]&=~(((unsigned char)0x80)>>(page_offset%8));
     return true;
@@ -53,6 +62,38 @@ bool BitmapPage<PageSize>::IsPageFreeLow(uint32_t byte_index, uint8_t bit_index)
   return ((this->bytes[byte_index]>>(7-bit_index))%2==0? true: false);
 }
 
+template <size_t PageSize>
+uint32_t BitmapPage<PageSize>::FindFreePage(uint32_t begin) const {
+  constexpr uint32_t WORD_BITS = 64;
+  for (uint32_t word_index = begin / WORD_BITS; word_index < MAX_CHARS / sizeof(uint64_t); word_index++) {
+    uint64_t word;
+    memcpy(&word, bytes + word_index * sizeof(uint64_t), sizeof(uint64_t));
+    // 按大端读出，第一个字节的最高位是第0页，前导零个数就是页号
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    uint64_t free_bits = ~word;
+    if (word_index == begin / WORD_BITS && begin % WORD_BITS != 0) free_bits &= ~0ULL >> (begin % WORD_BITS);
+    if (free_bits != 0) return word_index * WORD_BITS + __builtin_clzll(free_bits);
+  }
+  return GetMaxSupportedSize();
+}
+
+template <size_t PageSize>
+uint32_t BitmapPage<PageSize>::FindAllocatedEnd() const {
+  if (page_allocated_ == 0) return 0;
+  for (uint32_t word_index = MAX_CHARS / sizeof(uint64_t); word_index-- > 0;) {
+    uint64_t word;
+    memcpy(&word, bytes + word_index * sizeof(uint64_t), sizeof(uint64_t));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    // 大端读出后，最后一个已分配的页就是最低的1位
+    if (word != 0) return word_index * 64 + 64 - __builtin_ctzll(word);
+  }
+  return 0;
+}
+
 template class BitmapPage<64>;
 
 template class BitmapPage<128>;
@@ -65,4 +106,10 @@ template class BitmapPage<1024>;
 
 template class BitmapPage<2048>;
 
-template class BitmapPage<4096>;
\ No newline at end of file
+template class BitmapPage<4096>;
+
+template class BitmapPage<8192>;
+
+template class BitmapPage<16384>;
+
+template class BitmapPage<32768>;
@@ -0,0 +1,25 @@
+#include "page/free_space_map_page.h"
+
+#include "common/macros.h"
+
+void FreeSpaceMapPage::Append(page_id_t page_id, uint8_t category) {
+  ASSERT(!IsFull(), "Free space map page is full.");
+  page_ids_[count_] = page_id;
+  categories_[count_] = category;
+  count_++;
+}
+
+int FreeSpaceMapPage::FindSlot(uint8_t min_category) const {
+  for (uint32_t i = 0; i < count_; i++) {
+    if (categories_[i] >= min_category) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+uint8_t FreeSpaceMapPage::GetMaxCategory() const {
+  uint8_t max_category = 0;
+  for (uint32_t i = 0; i < count_; i++) {
+    max_category = std::max(max_category, categories_[i]);
+  }
+  return max_category;
+}
@@ -5,6 +5,7 @@ void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr,
   SetPrevPageId(prev_id);
   SetNextPageId(INVALID_PAGE_ID);
   SetFreeSpacePointer(PAGE_SIZE);
+  SetRowFormat(kRowFormatFixed);
   SetTupleCount(0);
 }
 
@@ -12,6 +13,7 @@ bool TablePage::InsertTuple(Row &row, Schema *schema, Transaction *txn, LockMana
                             LogManager *log_manager) {
   uint32_t serialized_size = row.GetSerializedSize(schema);
   ASSERT(serialized_size > 0, "Can not have empty row.");
+  UpgradeTuples(schema);
   if (GetFreeSpaceRemaining() < serialized_size + SIZE_TUPLE) {
     return false;
   }
@@ -66,6 +68,7 @@ int TablePage::UpdateTuple(const Row &new_row, Row *old_row, Schema *schema, Tra
   ASSERT(old_row != nullptr && old_row->GetRowId().Get() != INVALID_ROWID.Get(), "invalid old row.");
   uint32_t serialized_size = new_row.GetSerializedSize(schema);
   ASSERT(serialized_size > 0, "Can not have empty row.");
+  UpgradeTuples(schema);
   uint32_t slot_num = old_row->GetRowId().GetSlotNum();
   // If the slot number is invalid, abort.
   if (slot_num >= GetTupleCount()) {
@@ -164,6 +167,80 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Transaction *txn, LockManager
   return true;
 }
 
+uint32_t TablePage::GetTuples(std::vector<Row> *rows, Schema *schema) {
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    if (IsDeleted(tuple_size)) continue;
+    if (count == rows->size()) rows->emplace_back();
+    Row &row = (*rows)[count++];
+    row.destroy();
+    row.SetRowId(RowId(GetTablePageId(), i));
+    uint32_t __attribute__((unused)) read_bytes = row.DeserializeFrom(GetData() + GetTupleOffsetAtSlot(i), schema);
+    ASSERT(tuple_size == read_bytes, "Unexpected behavior in tuple deserialize.");
+  }
+  return count;
+}
+
+void TablePage::VisitTuples(Schema *schema, RowView *view, const std::function<void(const RowView &view)> &visit) {
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    if (IsDeleted(GetTupleSize(i))) continue;
+    view->Reset(GetData() + GetTupleOffsetAtSlot(i), schema, RowId(GetTablePageId(), i));
+    visit(*view);
+  }
+}
+
+bool TablePage::UpgradeTuples(Schema *schema) {
+  // 页头记着已经升级过，不用再看每个元组
+  if (GetRowFormat() == kRowFormatFixed) return true;
+  uint32_t tuple_count = GetTupleCount();
+  uint32_t i;
+  for (i = 0; i < tuple_count; i++) {
+    uint32_t tuple_size = UnsetDeletedFlag(GetTupleSize(i));
+    if (tuple_size > 0 && Row::GetFormat(GetData() + GetTupleOffsetAtSlot(i)) == kRowFormatLegacy) break;
+  }
+  if (i == tuple_count) {
+    SetRowFormat(kRowFormatFixed);
+    return true;
+  }
+  // 所有元组按新格式写到一块临时空间，放得下再整体写回；标了删除的也要转，回滚时还要读
+  std::vector<char> tuples;
+  std::vector<uint32_t> sizes(tuple_count);
+  Row row;
+  for (i = 0; i < tuple_count; i++) {
+    uint32_t tuple_size = UnsetDeletedFlag(GetTupleSize(i));
+    if (tuple_size == 0) continue;
+    const char *tuple = GetData() + GetTupleOffsetAtSlot(i);
+    size_t end = tuples.size();
+    if (Row::GetFormat(tuple) == kRowFormatLegacy) {
+      row.destroy();
+      row.DeserializeFrom(const_cast<char *>(tuple), schema);
+      tuple_size = row.GetSerializedSize(schema);
+      tuples.resize(end + tuple_size);
+      row.SerializeTo(&tuples[end], schema);
+    } else {
+      tuples.insert(tuples.end(), tuple, tuple + tuple_size);
+    }
+    sizes[i] = tuple_size;
+  }
+  if (SIZE_TABLE_PAGE_HEADER + SIZE_TUPLE * tuple_count + tuples.size() > PAGE_SIZE) {
+    return false;
+  }
+  uint32_t free_space_pointer = PAGE_SIZE;
+  size_t offset = 0;
+  for (i = 0; i < tuple_count; i++) {
+    if (sizes[i] == 0) continue;
+    free_space_pointer -= sizes[i];
+    memcpy(GetData() + free_space_pointer, &tuples[offset], sizes[i]);
+    offset += sizes[i];
+    SetTupleOffsetAtSlot(i, free_space_pointer);
+    SetTupleSize(i, IsDeleted(GetTupleSize(i)) ? SetDeletedFlag(sizes[i]) : sizes[i]);
+  }
+  SetFreeSpacePointer(free_space_pointer);
+  SetRowFormat(kRowFormatFixed);
+  return true;
+}
+
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); i++) {
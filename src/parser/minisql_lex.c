@@ -374,8 +374,8 @@ static void yy_fatal_error (yyconst char msg[]  );
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 56
-#define YY_END_OF_BUFFER 57
+#define YY_NUM_RULES 59
+#define YY_END_OF_BUFFER 60
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -383,27 +383,28 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[175] =
+static yyconst flex_int16_t yy_accept[182] =
     {   0,
-       41,   41,   57,   55,   54,   54,   55,   49,   52,   53,
-       47,   46,   41,   55,   41,   48,   50,   42,   51,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,    0,    1,
-        0,    0,   41,   40,   44,   43,   45,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       37,   39,   39,   39,   22,   35,   39,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   34,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       32,   29,   36,   39,   39,   39,   39,   39,   26,   39,
-
-       39,   39,   39,   14,   39,   39,   39,   39,   31,   39,
-       39,   39,   39,    3,   39,   39,   23,   39,   39,   25,
-       38,   39,   11,   39,   39,   13,   39,   39,   39,   39,
-       39,   39,    8,   39,   39,   39,   39,   39,   33,   20,
-       39,   39,   39,   39,   18,   39,   39,   15,   39,   24,
-        9,    2,   39,    6,   39,   39,    5,   39,   39,    4,
-       19,   30,    7,   27,   39,   39,   21,   28,   39,   16,
-       12,   10,   17,    0
+       44,   44,   60,   58,   57,   57,   58,   52,   55,   56,
+       50,   49,   44,   58,   51,   53,   45,   54,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,    0,    1,
+        0,    0,   44,   43,   47,   46,   48,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       37,   42,   42,   42,   42,   22,   35,   42,   42,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   34,   42,
+       42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+       42,   32,   29,   42,   36,   42,   42,   42,   42,   42,
+
+       26,   42,   42,   42,   42,   14,   42,   42,   42,   42,
+       42,   31,   42,   42,   41,   42,    3,   42,   42,   23,
+       42,   42,   25,   40,   38,   42,   11,   42,   42,   13,
+       42,   42,   42,   42,   42,   42,   42,    8,   42,   42,
+       42,   42,   42,   33,   20,   42,   42,   42,   42,   18,
+       42,   42,   15,   42,   42,   24,    9,    2,   42,    6,
+       42,   42,    5,   42,   42,    4,   19,   30,    7,   39,
+       27,   42,   42,   21,   28,   42,   16,   12,   10,   17,
+        0
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
@@ -441,124 +442,139 @@ static yyconst flex_int32_t yy_ec[256] =
 static yyconst flex_int32_t yy_meta[43] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    1,    1,    1,    2,    1,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+        1,    1
     } ;
 
-static yyconst flex_int16_t yy_base[177] =
+static yyconst flex_int16_t yy_base[182] =
     {   0,
-        0,    0,  188,  189,  189,  189,   39,  189,  189,  189,
-      189,  189,   33,  175,   35,  189,   33,  189,  171,    0,
-      154,  161,   24,   32,  142,   23,   29,  159,   30,   35,
-      146,  142,  147,   38,  159,   38,  158,  150,   59,  189,
-      172,  162,   42,  161,  189,  189,  189,    0,  150,  146,
-      151,  139,  145,  130,  137,  133,  141,  131,  130,   50,
-        0,  119,  123,  130,    0,    0,  131,  130,  127,   44,
-      123,  134,  126,  130,   52,  122,  127,    0,  122,  113,
-      117,  127,  126,  121,  110,  121,  122,  110,  116,  115,
-      105,    0,    0,  107,  105,   97,  104,  109,    0,   91,
-
-      101,   95,  109,    0,   96,   88,   90,   93,    0,   96,
-       85,  101,   83,    0,   95,   81,    0,   76,   81,    0,
-        0,   96,    0,   94,   92,    0,   89,   73,   73,   84,
-       85,   84,    0,   69,   82,   85,   80,   75,    0,   78,
-       63,   64,   79,   60,   60,   72,   71,    0,   57,    0,
-        0,    0,   56,    0,   62,   54,    0,   43,   63,    0,
-        0,    0,    0,    0,   60,   59,    0,    0,   52,   42,
-        0,    0,    0,  189,   87,   74
+        1,    1,    1,  253,  253,  253,   43,  253,  253,  253,
+      253,  253,  116,   76,  253,  114,  253,   75,   74,  101,
+      125,   91,   99,  108,   90,  100,  128,  120,  105,  109,
+      118,  116,  124,  119,  138,   56,  139,  133,   43,  253,
+      117,   76,  116,   76,  253,  253,  253,   74,  138,  136,
+      143,  133,  141,  128,  137,  135,  145,  137,  138,  102,
+       74,  129,  153,  136,  145,   74,   74,  148,  149,  148,
+      104,  146,  159,  153,  159,  123,  126,  159,   74,  156,
+      149,  155,  167,  168,  165,  156,  169,  172,  162,  170,
+      171,  163,   74,  174,   74,  168,  168,  162,  171,  178,
+
+       74,  162,  174,  170,  186,   74,  175,  169,  170,  174,
+      179,   74,  184,  175,  193,  177,   74,  191,  179,   74,
+      176,  183,   74,   74,   74,  200,   74,  200,  200,   74,
+      199,  185,  187,  200,  188,  204,  205,   74,  192,  207,
+      212,  209,  206,   74,  211,  198,  201,  218,  201,  203,
+      217,  218,   74,  212,  207,   74,   74,   74,  208,   74,
+      216,  210,   74,  205,  227,   74,   74,   74,   74,   74,
+       74,  226,  227,   74,   74,  223,  216,   74,   74,   74,
+      253
     } ;
 
-static yyconst flex_int16_t yy_def[177] =
+static yyconst flex_int16_t yy_def[182] =
     {   0,
-      174,    1,  174,  174,  174,  174,  175,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  175,  174,
-      175,  174,  174,  174,  174,  174,  174,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,    0,  174,  174
+      181,    1,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,    7,  181,
+        7,   14,   13,   14,  181,  181,  181,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+        0
     } ;
 
-static yyconst flex_int16_t yy_nxt[232] =
+static yyconst flex_int16_t yy_nxt[296] =
     {   0,
-        4,    5,    6,    7,    8,    9,   10,   11,   12,   13,
-       14,   15,   16,   17,   18,   19,   20,    4,   21,   22,
-       23,   24,   25,   26,   20,   20,   27,   28,   20,   20,
-       29,   30,   31,   32,   33,   34,   35,   36,   37,   38,
-       20,   20,   40,   42,   43,   42,   43,   45,   46,   51,
-       54,   58,   42,   43,   55,   52,   41,   59,   53,   60,
-       70,   63,   40,   71,   61,   65,   56,   64,   73,   66,
-       74,   89,   98,   75,  104,   48,   41,  173,  105,  172,
-       99,  171,  170,  169,  168,   90,   91,   39,   39,  167,
-      166,  165,  164,  163,  162,  161,  160,  159,  158,  157,
-
-      156,  155,  154,  153,  152,  151,  150,  149,  148,  147,
-      146,  145,  144,  143,  142,  141,  140,  139,  138,  137,
-      136,  135,  134,  133,  132,  131,  130,  129,  128,  127,
-      126,  125,  124,  123,  122,  121,  120,  119,  118,  117,
-      116,  115,  114,  113,  112,  111,  110,  109,  108,  107,
-      106,  103,  102,  101,  100,   97,   96,   95,   94,   93,
-       92,   88,   87,   86,   85,   84,   83,   82,   81,   80,
-       79,   78,   44,   44,  174,   77,   76,   72,   69,   68,
-       67,   62,   57,   50,   49,   47,   44,  174,    3,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174
+      181,    4,    5,    6,    7,    8,    9,   10,   11,   12,
+       13,   14,   13,   15,   16,   17,   18,   19,    4,   20,
+       21,   22,   23,   24,   25,   19,   19,   26,   27,   28,
+       19,   29,   30,   31,   32,   33,   34,   35,   36,   37,
+       38,   19,   19,   39,   39,   39,   40,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       41,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
+       39,   39,   39,   39,   39,   48,   74,   44,   75,   47,
+       48,   76,   48,   48,   48,   48,   48,   48,   48,   48,
+
+       48,   48,   48,   48,   48,   48,   48,   48,   48,   48,
+       48,   48,   48,   48,   48,   48,   51,   54,   58,  181,
+       39,   55,   52,   90,   59,   53,   42,   43,   45,   46,
+       60,   49,  100,   56,   39,   61,   64,   91,   92,   66,
+      101,   71,   65,   67,   72,  106,  108,   50,   57,  107,
+       62,   63,   68,   69,  109,   70,   73,   77,   78,   79,
+       80,   81,   82,   83,   84,   85,   86,   87,   88,   89,
+       93,   94,   95,   96,   97,   98,   99,  102,  103,  104,
+      105,  110,  111,  112,  113,  114,  115,  116,  117,  118,
+      119,  120,  121,  122,  123,  124,  125,  126,  127,  128,
+
+      129,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+      139,  140,  141,  142,  143,  144,  145,  146,  147,  148,
+      149,  150,  151,  152,  153,  154,  155,  156,  157,  158,
+      159,  160,  161,  162,  163,  164,  165,  166,  167,  168,
+      169,  170,  171,  172,  173,  174,  175,  176,  177,  178,
+      179,  180,    3,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181
     } ;
 
-static yyconst flex_int16_t yy_chk[232] =
+static yyconst flex_int16_t yy_chk[296] =
     {   0,
+        3,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    7,   13,   13,   15,   15,   17,   17,   23,
-       24,   26,   43,   43,   24,   23,    7,   26,   23,   27,
-       34,   29,   39,   34,   27,   30,   24,   29,   36,   30,
-       36,   60,   70,   36,   75,  176,   39,  170,   75,  169,
-       70,  166,  165,  159,  158,   60,   60,  175,  175,  156,
-      155,  153,  149,  147,  146,  145,  144,  143,  142,  141,
-
-      140,  138,  137,  136,  135,  134,  132,  131,  130,  129,
-      128,  127,  125,  124,  122,  119,  118,  116,  115,  113,
-      112,  111,  110,  108,  107,  106,  105,  103,  102,  101,
-      100,   98,   97,   96,   95,   94,   91,   90,   89,   88,
-       87,   86,   85,   84,   83,   82,   81,   80,   79,   77,
-       76,   74,   73,   72,   71,   69,   68,   67,   64,   63,
-       62,   59,   58,   57,   56,   55,   54,   53,   52,   51,
-       50,   49,   44,   42,   41,   38,   37,   35,   33,   32,
-       31,   28,   25,   22,   21,   19,   14,    3,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174
+        1,    1,    1,    7,    7,    7,    7,    7,    7,    7,
+        7,    7,    7,    7,    7,    7,    7,    7,    7,    7,
+        7,    7,    7,    7,    7,    7,    7,    7,    7,    7,
+        7,    7,    7,    7,    7,    7,    7,    7,    7,    7,
+        7,    7,    7,    7,    7,   19,   36,   14,   36,   18,
+       19,   36,   19,   19,   19,   19,   19,   19,   19,   19,
+
+       19,   19,   19,   19,   19,   19,   19,   19,   19,   19,
+       19,   19,   19,   19,   19,   19,   22,   23,   25,   41,
+       41,   23,   22,   60,   25,   22,   13,   13,   16,   16,
+       26,   20,   71,   23,   41,   26,   29,   60,   60,   30,
+       71,   34,   29,   30,   34,   76,   77,   21,   24,   76,
+       27,   28,   31,   32,   77,   33,   35,   37,   38,   49,
+       50,   51,   52,   53,   54,   55,   56,   57,   58,   59,
+       62,   63,   64,   65,   68,   69,   70,   72,   73,   74,
+       75,   78,   80,   81,   82,   83,   84,   85,   86,   87,
+       88,   89,   90,   91,   92,   94,   96,   97,   98,   99,
+
+      100,  102,  103,  104,  105,  107,  108,  109,  110,  111,
+      113,  114,  115,  116,  118,  119,  121,  122,  126,  128,
+      129,  131,  132,  133,  134,  135,  136,  137,  139,  140,
+      141,  142,  143,  145,  146,  147,  148,  149,  150,  151,
+      152,  154,  155,  159,  161,  162,  164,  165,  172,  173,
+      176,  177,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181,  181,  181,  181,  181,  181,
+      181,  181,  181,  181,  181
     } ;
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[57] =
+static yyconst flex_int32_t yy_rule_can_match_eol[60] =
     {   0,
 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,     };
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 
+        };
 
 static yy_state_type yy_last_accepting_state;
 static char *yy_last_accepting_cpos;
@@ -581,7 +597,7 @@ char *yytext;
     #include "parser/minisql_yacc.h"
     int yywrap();
     extern YYSTYPE yylval;
-#line 585 "../../parser/minisql_lex.c"
+#line 601 "../../parser/minisql_lex.c"
 
 #define INITIAL 0
 
@@ -766,7 +782,7 @@ YY_DECL
 #line 15 "minisql.l"
 
 
-#line 770 "../../parser/minisql_lex.c"
+#line 786 "../../parser/minisql_lex.c"
 
 	if ( !(yy_init) )
 		{
@@ -819,13 +835,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 175 )
+				if ( yy_current_state >= 182 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 189 );
+		while ( yy_base[yy_current_state] != 253 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -1171,7 +1187,7 @@ YY_RULE_SETUP
 {
   MinisqlParserMovePos(yylineno, yytext);
   yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-  return IDENTIFIER;
+  return VACUUM;
 }
 	YY_BREAK
 case 40:
@@ -1179,8 +1195,8 @@ YY_RULE_SETUP
 #line 214 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-  return NUMBER;
+  yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+  return LOAD;
 }
 	YY_BREAK
 case 41:
@@ -1188,8 +1204,8 @@ YY_RULE_SETUP
 #line 220 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-  return NUMBER;
+  yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+  return DATA;
 }
 	YY_BREAK
 case 42:
@@ -1197,120 +1213,147 @@ YY_RULE_SETUP
 #line 226 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return EQ;
+  yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+  return IDENTIFIER;
 }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 232 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return NE;
+  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+  return NUMBER;
 }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 238 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return LE;
+  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+  return NUMBER;
 }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 244 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return GE;
+  return EQ;
 }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 249 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (',');
+  return NE;
 }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 251 "minisql.l"
+#line 254 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('*');
+  return LE;
 }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
-#line 256 "minisql.l"
+#line 259 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (';');
+  return GE;
 }
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
-#line 261 "minisql.l"
+#line 264 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('\'');
+  return (',');
 }
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
-#line 266 "minisql.l"
+#line 269 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('<');
+  return ('*');
 }
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
-#line 271 "minisql.l"
+#line 274 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('>');
+  return (';');
 }
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
-#line 276 "minisql.l"
+#line 279 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('(');
+  return ('\'');
 }
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
-#line 281 "minisql.l"
+#line 284 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (')');
+  return ('<');
 }
 	YY_BREAK
 case 54:
-/* rule 54 can match eol */
 YY_RULE_SETUP
-#line 286 "minisql.l"
+#line 289 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
+  return ('>');
 }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 294 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return ('(');
+}
+	YY_BREAK
+case 56:
+YY_RULE_SETUP
+#line 299 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return (')');
+}
+	YY_BREAK
+case 57:
+/* rule 57 can match eol */
+YY_RULE_SETUP
+#line 304 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+}
+	YY_BREAK
+case 58:
+YY_RULE_SETUP
+#line 308 "minisql.l"
 {
   char str[128] = {0};
   sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
   MinisqlParserSetError(str);
 }
 	YY_BREAK
-case 56:
+case 59:
 YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 314 "minisql.l"
 ECHO;
 	YY_BREAK
-#line 1314 "../../parser/minisql_lex.c"
+#line 1357 "../../parser/minisql_lex.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1602,7 +1645,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 175 )
+			if ( yy_current_state >= 182 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1630,11 +1673,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 175 )
+		if ( yy_current_state >= 182 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 174);
+	yy_is_jam = (yy_current_state == 181);
 
 	return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2319,7 +2362,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 314 "minisql.l"
 
 
 int yywrap() {
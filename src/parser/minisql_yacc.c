@@ -80,36 +80,39 @@
      SHOW = 269,
      USE = 270,
      USING = 271,
-     DATABASE = 272,
-     DATABASES = 273,
-     TABLE = 274,
-     TABLES = 275,
-     INDEX = 276,
-     INDEXES = 277,
-     ON = 278,
-     FROM = 279,
-     WHERE = 280,
-     INTO = 281,
-     SET = 282,
-     VALUES = 283,
-     PRIMARY = 284,
-     KEY = 285,
-     UNIQUE = 286,
-     CHAR = 287,
-     INT = 288,
-     FLOAT = 289,
-     AND = 290,
-     OR = 291,
-     NOT = 292,
-     IS = 293,
-     FLAGNULL = 294,
-     IDENTIFIER = 295,
-     STRING = 296,
-     NUMBER = 297,
-     EQ = 298,
-     NE = 299,
-     LE = 300,
-     GE = 301
+     VACUUM = 272,
+     LOAD = 273,
+     DATA = 274,
+     DATABASE = 275,
+     DATABASES = 276,
+     TABLE = 277,
+     TABLES = 278,
+     INDEX = 279,
+     INDEXES = 280,
+     ON = 281,
+     FROM = 282,
+     WHERE = 283,
+     INTO = 284,
+     SET = 285,
+     VALUES = 286,
+     PRIMARY = 287,
+     KEY = 288,
+     UNIQUE = 289,
+     CHAR = 290,
+     INT = 291,
+     FLOAT = 292,
+     AND = 293,
+     OR = 294,
+     NOT = 295,
+     IS = 296,
+     FLAGNULL = 297,
+     IDENTIFIER = 298,
+     STRING = 299,
+     NUMBER = 300,
+     EQ = 301,
+     NE = 302,
+     LE = 303,
+     GE = 304
    };
 #endif
 /* Tokens.  */
@@ -127,36 +130,39 @@
 #define SHOW 269
 #define USE 270
 #define USING 271
-#define DATABASE 272
-#define DATABASES 273
-#define TABLE 274
-#define TABLES 275
-#define INDEX 276
-#define INDEXES 277
-#define ON 278
-#define FROM 279
-#define WHERE 280
-#define INTO 281
-#define SET 282
-#define VALUES 283
-#define PRIMARY 284
-#define KEY 285
-#define UNIQUE 286
-#define CHAR 287
-#define INT 288
-#define FLOAT 289
-#define AND 290
-#define OR 291
-#define NOT 292
-#define IS 293
-#define FLAGNULL 294
-#define IDENTIFIER 295
-#define STRING 296
-#define NUMBER 297
-#define EQ 298
-#define NE 299
-#define LE 300
-#define GE 301
+#define VACUUM 272
+#define LOAD 273
+#define DATA 274
+#define DATABASE 275
+#define DATABASES 276
+#define TABLE 277
+#define TABLES 278
+#define INDEX 279
+#define INDEXES 280
+#define ON 281
+#define FROM 282
+#define WHERE 283
+#define INTO 284
+#define SET 285
+#define VALUES 286
+#define PRIMARY 287
+#define KEY 288
+#define UNIQUE 289
+#define CHAR 290
+#define INT 291
+#define FLOAT 292
+#define AND 293
+#define OR 294
+#define NOT 295
+#define IS 296
+#define FLAGNULL 297
+#define IDENTIFIER 298
+#define STRING 299
+#define NUMBER 300
+#define EQ 301
+#define NE 302
+#define LE 303
+#define GE 304
 
 
 
@@ -197,7 +203,7 @@ typedef union YYSTYPE
 	pSyntaxNode syntax_node;
 }
 /* Line 193 of yacc.c.  */
-#line 201 "./minisql_yacc.c"
+#line 207 "./minisql_yacc.c"
 	YYSTYPE;
 # define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
@@ -210,7 +216,7 @@ typedef union YYSTYPE
 
 
 /* Line 216 of yacc.c.  */
-#line 214 "./minisql_yacc.c"
+#line 220 "./minisql_yacc.c"
 
 #ifdef short
 # undef short
@@ -423,22 +429,22 @@ union yyalloc
 #endif
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  53
+#define YYFINAL  63
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   106
+#define YYLAST   139
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  54
+#define YYNTOKENS  57
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  35
+#define YYNNTS  38
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  77
+#define YYNRULES  86
 /* YYNRULES -- Number of states.  */
-#define YYNSTATES  134
+#define YYNSTATES  147
 
 /* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
 #define YYUNDEFTOK  2
-#define YYMAXUTOK   301
+#define YYMAXUTOK   304
 
 #define YYTRANSLATE(YYX)						\
   ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
@@ -450,9 +456,9 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-      48,    49,    51,     2,    50,     2,     2,     2,     2,     2,
-       2,     2,     2,     2,     2,     2,     2,     2,     2,    47,
-      52,     2,    53,     2,     2,     2,     2,     2,     2,     2,
+      51,    52,    54,     2,    53,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,    50,
+      55,     2,    56,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -476,52 +482,55 @@ static const yytype_uint8 yytranslate[] =
       15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
       25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
-      45,    46
+      45,    46,    47,    48,    49
 };
 
 #if YYDEBUG
 /* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
    YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+static const yytype_uint16 yyprhs[] =
 {
        0,     0,     3,     6,     8,    10,    12,    14,    16,    18,
       20,    22,    24,    26,    28,    30,    32,    34,    36,    38,
-      40,    42,    44,    48,    52,    55,    58,    61,    68,    72,
-      74,    78,    80,    86,    90,    93,    95,    97,   102,   106,
-     115,   126,   130,   133,   138,   145,   147,   149,   153,   155,
-     157,   159,   163,   165,   167,   169,   171,   173,   175,   177,
-     179,   181,   183,   185,   193,   197,   199,   203,   209,   214,
-     221,   225,   227,   231,   233,   235,   237,   239
+      40,    42,    44,    46,    48,    52,    56,    59,    62,    65,
+      72,    76,    78,    82,    84,    90,    94,    97,    99,   101,
+     106,   110,   119,   130,   134,   137,   142,   149,   151,   153,
+     157,   159,   161,   163,   167,   169,   171,   173,   175,   177,
+     179,   181,   183,   185,   187,   189,   197,   201,   203,   207,
+     213,   218,   225,   229,   231,   235,   237,   239,   241,   243,
+     246,   248,   251,   257,   259,   261,   263
 };
 
 /* YYRHS -- A `-1'-separated list of the rules' RHS.  */
 static const yytype_int8 yyrhs[] =
 {
-      55,     0,    -1,    56,    47,    -1,    57,    -1,    58,    -1,
-      59,    -1,    60,    -1,    61,    -1,    62,    -1,    67,    -1,
-      68,    -1,    69,    -1,    70,    -1,    71,    -1,    78,    -1,
-      80,    -1,    81,    -1,    84,    -1,    85,    -1,    86,    -1,
-      87,    -1,    88,    -1,     3,    17,    40,    -1,     4,    17,
-      40,    -1,    14,    18,    -1,    15,    40,    -1,    14,    20,
-      -1,     3,    19,    40,    48,    64,    49,    -1,    40,    50,
-      63,    -1,    40,    -1,    65,    50,    64,    -1,    65,    -1,
-      29,    30,    48,    63,    49,    -1,    40,    66,    31,    -1,
-      40,    66,    -1,    33,    -1,    34,    -1,    32,    48,    42,
-      49,    -1,     4,    19,    40,    -1,     3,    21,    40,    23,
-      40,    48,    63,    49,    -1,     3,    21,    40,    23,    40,
-      48,    63,    49,    16,    40,    -1,     4,    21,    40,    -1,
-      14,    22,    -1,     5,    72,    24,    40,    -1,     5,    72,
-      24,    40,    25,    73,    -1,    51,    -1,    63,    -1,    73,
-      74,    75,    -1,    75,    -1,    35,    -1,    36,    -1,    40,
-      77,    76,    -1,    41,    -1,    42,    -1,    39,    -1,    43,
-      -1,    44,    -1,    45,    -1,    46,    -1,    52,    -1,    53,
-      -1,    38,    -1,    37,    -1,     6,    26,    40,    28,    48,
-      79,    49,    -1,    76,    50,    79,    -1,    76,    -1,     7,
-      24,    40,    -1,     7,    24,    40,    25,    73,    -1,     8,
-      40,    27,    82,    -1,     8,    40,    27,    82,    25,    73,
-      -1,    83,    50,    82,    -1,    83,    -1,    40,    43,    76,
-      -1,     9,    -1,    10,    -1,    11,    -1,    12,    -1,    13,
-      41,    -1
+      58,     0,    -1,    59,    50,    -1,    60,    -1,    61,    -1,
+      62,    -1,    63,    -1,    64,    -1,    65,    -1,    70,    -1,
+      71,    -1,    72,    -1,    73,    -1,    74,    -1,    81,    -1,
+      83,    -1,    84,    -1,    87,    -1,    88,    -1,    89,    -1,
+      90,    -1,    91,    -1,    92,    -1,    93,    -1,     3,    20,
+      94,    -1,     4,    20,    94,    -1,    14,    21,    -1,    15,
+      94,    -1,    14,    23,    -1,     3,    22,    94,    51,    67,
+      52,    -1,    94,    53,    66,    -1,    94,    -1,    68,    53,
+      67,    -1,    68,    -1,    32,    33,    51,    66,    52,    -1,
+      94,    69,    34,    -1,    94,    69,    -1,    36,    -1,    37,
+      -1,    35,    51,    45,    52,    -1,     4,    22,    94,    -1,
+       3,    24,    94,    26,    94,    51,    66,    52,    -1,     3,
+      24,    94,    26,    94,    51,    66,    52,    16,    94,    -1,
+       4,    24,    94,    -1,    14,    25,    -1,     5,    75,    27,
+      94,    -1,     5,    75,    27,    94,    28,    76,    -1,    54,
+      -1,    66,    -1,    76,    77,    78,    -1,    78,    -1,    38,
+      -1,    39,    -1,    94,    80,    79,    -1,    44,    -1,    45,
+      -1,    42,    -1,    46,    -1,    47,    -1,    48,    -1,    49,
+      -1,    55,    -1,    56,    -1,    41,    -1,    40,    -1,     6,
+      29,    94,    31,    51,    82,    52,    -1,    79,    53,    82,
+      -1,    79,    -1,     7,    27,    94,    -1,     7,    27,    94,
+      28,    76,    -1,     8,    94,    30,    85,    -1,     8,    94,
+      30,    85,    28,    76,    -1,    86,    53,    85,    -1,    86,
+      -1,    94,    46,    79,    -1,     9,    -1,    10,    -1,    11,
+      -1,    12,    -1,    13,    44,    -1,    17,    -1,    17,    94,
+      -1,    18,    19,    44,    29,    94,    -1,    43,    -1,    18,
+      -1,    19,    -1,    17,    -1
 };
 
 /* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
@@ -529,12 +538,13 @@ static const yytype_uint16 yyrline[] =
 {
        0,    35,    35,    42,    43,    44,    45,    46,    47,    48,
       49,    50,    51,    52,    53,    54,    55,    56,    57,    58,
-      59,    60,    64,    71,    78,    84,    91,    97,   107,   111,
-     117,   121,   124,   131,   136,   144,   147,   150,   157,   164,
-     172,   186,   193,   199,   204,   215,   218,   225,   230,   236,
-     239,   245,   253,   256,   259,   265,   268,   271,   274,   277,
-     280,   283,   286,   292,   302,   306,   312,   316,   326,   333,
-     348,   352,   358,   366,   372,   378,   384,   390
+      59,    60,    61,    62,    66,    73,    80,    86,    93,    99,
+     109,   113,   119,   123,   126,   133,   138,   146,   149,   152,
+     159,   166,   174,   188,   195,   201,   206,   217,   220,   227,
+     232,   238,   241,   247,   255,   258,   261,   267,   270,   273,
+     276,   279,   282,   285,   288,   294,   304,   308,   314,   318,
+     328,   335,   350,   354,   360,   368,   374,   380,   386,   392,
+     399,   402,   409,   417,   420,   423,   426
 };
 #endif
 
@@ -545,20 +555,21 @@ static const char *const yytname[] =
 {
   "$end", "error", "$undefined", "CREATE", "DROP", "SELECT", "INSERT",
   "DELETE", "UPDATE", "TRXBEGIN", "TRXCOMMIT", "TRXROLLBACK", "QUIT",
-  "EXECFILE", "SHOW", "USE", "USING", "DATABASE", "DATABASES", "TABLE",
-  "TABLES", "INDEX", "INDEXES", "ON", "FROM", "WHERE", "INTO", "SET",
-  "VALUES", "PRIMARY", "KEY", "UNIQUE", "CHAR", "INT", "FLOAT", "AND",
-  "OR", "NOT", "IS", "FLAGNULL", "IDENTIFIER", "STRING", "NUMBER", "EQ",
-  "NE", "LE", "GE", "';'", "'('", "')'", "','", "'*'", "'<'", "'>'",
-  "$accept", "start", "sql", "sql_create_database", "sql_drop_database",
-  "sql_show_databases", "sql_use_database", "sql_show_tables",
-  "sql_create_table", "column_list", "column_definition_list",
-  "column_definition", "column_type", "sql_drop_table", "sql_create_index",
-  "sql_drop_index", "sql_show_indexes", "sql_select", "select_columns",
-  "where_conditions", "connector", "where_condition", "column_value",
-  "operator", "sql_insert", "column_values", "sql_delete", "sql_update",
-  "update_values", "update_value", "sql_trx_begin", "sql_trx_commit",
-  "sql_trx_rollback", "sql_quit", "sql_exec_file", 0
+  "EXECFILE", "SHOW", "USE", "USING", "VACUUM", "LOAD", "DATA", "DATABASE",
+  "DATABASES", "TABLE", "TABLES", "INDEX", "INDEXES", "ON", "FROM",
+  "WHERE", "INTO", "SET", "VALUES", "PRIMARY", "KEY", "UNIQUE", "CHAR",
+  "INT", "FLOAT", "AND", "OR", "NOT", "IS", "FLAGNULL", "IDENTIFIER",
+  "STRING", "NUMBER", "EQ", "NE", "LE", "GE", "';'", "'('", "')'", "','",
+  "'*'", "'<'", "'>'", "$accept", "start", "sql", "sql_create_database",
+  "sql_drop_database", "sql_show_databases", "sql_use_database",
+  "sql_show_tables", "sql_create_table", "column_list",
+  "column_definition_list", "column_definition", "column_type",
+  "sql_drop_table", "sql_create_index", "sql_drop_index",
+  "sql_show_indexes", "sql_select", "select_columns", "where_conditions",
+  "connector", "where_condition", "column_value", "operator", "sql_insert",
+  "column_values", "sql_delete", "sql_update", "update_values",
+  "update_value", "sql_trx_begin", "sql_trx_commit", "sql_trx_rollback",
+  "sql_quit", "sql_exec_file", "sql_vacuum", "sql_load_data", "identifier", 0
 };
 #endif
 
@@ -571,22 +582,23 @@ static const yytype_uint16 yytoknum[] =
      265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
      275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
      285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,    59,    40,    41,
-      44,    42,    60,    62
+     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
+      59,    40,    41,    44,    42,    60,    62
 };
 # endif
 
 /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    54,    55,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    56,    56,    56,    56,    56,    56,    56,    56,
-      56,    56,    57,    58,    59,    60,    61,    62,    63,    63,
-      64,    64,    64,    65,    65,    66,    66,    66,    67,    68,
-      68,    69,    70,    71,    71,    72,    72,    73,    73,    74,
-      74,    75,    76,    76,    76,    77,    77,    77,    77,    77,
-      77,    77,    77,    78,    79,    79,    80,    80,    81,    81,
-      82,    82,    83,    84,    85,    86,    87,    88
+       0,    57,    58,    59,    59,    59,    59,    59,    59,    59,
+      59,    59,    59,    59,    59,    59,    59,    59,    59,    59,
+      59,    59,    59,    59,    60,    61,    62,    63,    64,    65,
+      66,    66,    67,    67,    67,    68,    68,    69,    69,    69,
+      70,    71,    71,    72,    73,    74,    74,    75,    75,    76,
+      76,    77,    77,    78,    79,    79,    79,    80,    80,    80,
+      80,    80,    80,    80,    80,    81,    82,    82,    83,    83,
+      84,    84,    85,    85,    86,    87,    88,    89,    90,    91,
+      92,    92,    93,    94,    94,    94,    94
 };
 
 /* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
@@ -594,12 +606,13 @@ static const yytype_uint8 yyr2[] =
 {
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     3,     3,     2,     2,     2,     6,     3,     1,
-       3,     1,     5,     3,     2,     1,     1,     4,     3,     8,
-      10,     3,     2,     4,     6,     1,     1,     3,     1,     1,
-       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     7,     3,     1,     3,     5,     4,     6,
-       3,     1,     3,     1,     1,     1,     1,     2
+       1,     1,     1,     1,     3,     3,     2,     2,     2,     6,
+       3,     1,     3,     1,     5,     3,     2,     1,     1,     4,
+       3,     8,    10,     3,     2,     4,     6,     1,     1,     3,
+       1,     1,     1,     3,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     7,     3,     1,     3,     5,
+       4,     6,     3,     1,     3,     1,     1,     1,     1,     2,
+       1,     2,     5,     1,     1,     1,     1
 };
 
 /* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
@@ -607,59 +620,61 @@ static const yytype_uint8 yyr2[] =
    means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,     0,    73,    74,    75,
-      76,     0,     0,     0,     0,     0,     3,     4,     5,     6,
-       7,     8,     9,    10,    11,    12,    13,    14,    15,    16,
-      17,    18,    19,    20,    21,     0,     0,     0,     0,     0,
-       0,    29,    45,    46,     0,     0,     0,     0,    77,    24,
-      26,    42,    25,     1,     2,    22,     0,     0,    23,    38,
-      41,     0,     0,     0,    66,     0,     0,     0,    28,    43,
-       0,     0,     0,    68,    71,     0,     0,     0,    31,     0,
-       0,     0,     0,    67,    48,     0,     0,     0,     0,     0,
-      35,    36,    34,    27,     0,     0,    44,    54,    52,    53,
-      65,     0,    62,    61,    55,    56,    57,    58,    59,    60,
-       0,    49,    50,     0,    72,    69,    70,     0,     0,    33,
-      30,     0,     0,    63,    51,    47,     0,     0,    39,    64,
-      32,    37,     0,    40
+       0,     0,     0,     0,     0,     0,     0,    75,    76,    77,
+      78,     0,     0,     0,    80,     0,     0,     0,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,     0,
+       0,     0,     0,     0,     0,    86,    84,    85,    83,    47,
+      48,     0,    31,     0,     0,     0,    79,    26,    28,    44,
+      27,    81,     0,     1,     2,    24,     0,     0,    25,    40,
+      43,     0,     0,     0,    68,     0,     0,     0,     0,    45,
+      30,     0,     0,    70,    73,     0,     0,     0,     0,    33,
+       0,     0,     0,     0,    69,    50,     0,     0,     0,     0,
+      82,     0,    29,     0,     0,    37,    38,    36,     0,    46,
+      56,    54,    55,    67,     0,    51,    52,     0,    64,    63,
+      57,    58,    59,    60,    61,    62,     0,    71,    72,    74,
+       0,    32,     0,    35,     0,     0,    65,    49,    53,     0,
+       0,    41,    66,    34,    39,     0,    42
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    14,    15,    16,    17,    18,    19,    20,    21,    43,
-      77,    78,    92,    22,    23,    24,    25,    26,    44,    83,
-     113,    84,   100,   110,    27,   101,    28,    29,    73,    74,
-      30,    31,    32,    33,    34
+      -1,    16,    17,    18,    19,    20,    21,    22,    23,    50,
+      88,    89,   107,    24,    25,    26,    27,    28,    51,    94,
+     117,    95,   113,   126,    29,   114,    30,    31,    83,    84,
+      32,    33,    34,    35,    36,    37,    38,    52
 };
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -85
+#define YYPACT_NINF -99
 static const yytype_int8 yypact[] =
 {
-      32,     2,     3,   -36,   -19,     8,    -7,   -85,   -85,   -85,
-     -85,    10,     7,    12,    53,    11,   -85,   -85,   -85,   -85,
-     -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,
-     -85,   -85,   -85,   -85,   -85,    14,    15,    17,    19,    20,
-      21,    13,   -85,   -85,    38,    24,    25,    39,   -85,   -85,
-     -85,   -85,   -85,   -85,   -85,   -85,    22,    44,   -85,   -85,
-     -85,    28,    29,    43,    47,    33,   -24,    34,   -85,    50,
-      30,    36,    37,    52,    31,    49,    16,    35,    40,    41,
-      36,   -11,   -35,   -22,   -85,   -11,    36,    33,    45,    46,
-     -85,   -85,    51,   -85,   -24,    28,   -22,   -85,   -85,   -85,
-      42,    48,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,
-     -11,   -85,   -85,    36,   -85,   -22,   -85,    28,    54,   -85,
-     -85,    55,   -11,   -85,   -85,   -85,    56,    57,    67,   -85,
-     -85,   -85,    58,   -85
+      95,   -11,     2,   -13,   -27,   -17,     0,   -99,   -99,   -99,
+     -99,   -32,    33,     0,     0,     8,    21,    -8,   -99,   -99,
+     -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,
+     -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,     0,
+       0,     0,     0,     0,     0,   -99,   -99,   -99,   -99,   -99,
+     -99,    -4,     9,     0,     0,    16,   -99,   -99,   -99,   -99,
+     -99,   -99,     5,   -99,   -99,   -99,     6,    29,   -99,   -99,
+     -99,     0,     0,    32,    40,     0,    41,    -3,     0,    49,
+     -99,    27,     0,    51,    28,    36,     0,    50,    35,    31,
+      38,    34,     0,    22,    -7,   -99,     4,     0,     0,    22,
+     -99,    37,   -99,    -3,    39,   -99,   -99,    55,     0,    -7,
+     -99,   -99,   -99,    42,    44,   -99,   -99,     0,   -99,   -99,
+     -99,   -99,   -99,   -99,   -99,   -99,    22,    -7,   -99,   -99,
+       0,   -99,    48,   -99,    62,    22,   -99,   -99,   -99,    63,
+      64,    78,   -99,   -99,   -99,     0,   -99
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-     -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -61,
-      -9,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -85,   -74,
-     -85,   -27,   -84,   -85,   -85,   -34,   -85,   -85,     0,   -85,
-     -85,   -85,   -85,   -85,   -85
+     -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -69,
+      14,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -99,   -72,
+     -99,     1,   -98,   -99,   -99,   -16,   -99,   -99,    23,   -99,
+     -99,   -99,   -99,   -99,   -99,   -99,   -99,    -6
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
@@ -669,32 +684,38 @@ static const yytype_int8 yypgoto[] =
 #define YYTABLE_NINF -1
 static const yytype_uint8 yytable[] =
 {
-      68,   114,   102,   103,    41,    75,    96,    45,   104,   105,
-     106,   107,   115,   111,   112,    42,    76,   108,   109,    35,
-      38,    36,    39,    37,    40,    49,   124,    50,    97,    51,
-      98,    99,    46,    47,   121,     1,     2,     3,     4,     5,
-       6,     7,     8,     9,    10,    11,    12,    13,    89,    90,
-      91,    48,    52,    53,    55,    56,   126,    57,    54,    58,
-      59,    60,    62,    61,    63,    64,    65,    67,    41,    69,
-      66,    70,    71,    72,    79,    80,    82,    86,    81,    88,
-      85,    87,   119,   132,    93,   120,   125,   116,   129,    95,
-      94,     0,   122,   117,   118,     0,   127,   123,   133,     0,
-       0,     0,     0,     0,   128,   130,   131
+      55,   129,    53,    80,    45,    46,    47,    60,    61,    39,
+      54,    40,    56,    41,    45,    46,    47,    45,    46,    47,
+     109,    63,    42,    71,    43,   127,    44,    62,   138,    87,
+      48,   115,   116,    65,    66,    67,    68,    69,    70,   134,
+      48,    49,    64,    48,   118,   119,    75,    73,    74,    76,
+     120,   121,   122,   123,    57,    78,    58,    77,    59,   124,
+     125,   139,    72,    81,   110,    79,   111,   112,    82,    85,
+      86,    90,    91,   104,   105,   106,    96,    92,    93,    97,
+     100,    98,    99,   101,   103,   108,    96,   102,   130,   133,
+     132,    96,    85,   140,   145,   135,   136,    90,     1,     2,
+       3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
+      13,    96,    14,    15,   141,   143,   144,   131,   137,   142,
+       0,   128,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,   146
 };
 
-static const yytype_int8 yycheck[] =
+static const yytype_int16 yycheck[] =
 {
-      61,    85,    37,    38,    40,    29,    80,    26,    43,    44,
-      45,    46,    86,    35,    36,    51,    40,    52,    53,    17,
-      17,    19,    19,    21,    21,    18,   110,    20,    39,    22,
-      41,    42,    24,    40,    95,     3,     4,     5,     6,     7,
-       8,     9,    10,    11,    12,    13,    14,    15,    32,    33,
-      34,    41,    40,     0,    40,    40,   117,    40,    47,    40,
-      40,    40,    24,    50,    40,    40,    27,    23,    40,    40,
-      48,    28,    25,    40,    40,    25,    40,    25,    48,    30,
-      43,    50,    31,    16,    49,    94,   113,    87,   122,    48,
-      50,    -1,    50,    48,    48,    -1,    42,    49,    40,    -1,
-      -1,    -1,    -1,    -1,    49,    49,    49
+       6,    99,    29,    72,    17,    18,    19,    13,    14,    20,
+      27,    22,    44,    24,    17,    18,    19,    17,    18,    19,
+      92,     0,    20,    27,    22,    97,    24,    19,   126,    32,
+      43,    38,    39,    39,    40,    41,    42,    43,    44,   108,
+      43,    54,    50,    43,    40,    41,    30,    53,    54,    44,
+      46,    47,    48,    49,    21,    26,    23,    51,    25,    55,
+      56,   130,    53,    31,    42,    71,    44,    45,    28,    75,
+      29,    77,    78,    35,    36,    37,    82,    28,    51,    28,
+      86,    53,    46,    33,    53,    51,    92,    52,    51,    34,
+      51,    97,    98,    45,    16,    53,    52,   103,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,   117,    17,    18,    52,    52,    52,   103,   117,   135,
+      -1,    98,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,   145
 };
 
 /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
@@ -702,19 +723,20 @@ static const yytype_int8 yycheck[] =
 static const yytype_uint8 yystos[] =
 {
        0,     3,     4,     5,     6,     7,     8,     9,    10,    11,
-      12,    13,    14,    15,    55,    56,    57,    58,    59,    60,
-      61,    62,    67,    68,    69,    70,    71,    78,    80,    81,
-      84,    85,    86,    87,    88,    17,    19,    21,    17,    19,
-      21,    40,    51,    63,    72,    26,    24,    40,    41,    18,
-      20,    22,    40,     0,    47,    40,    40,    40,    40,    40,
-      40,    50,    24,    40,    40,    27,    48,    23,    63,    40,
-      28,    25,    40,    82,    83,    29,    40,    64,    65,    40,
-      25,    48,    40,    73,    75,    43,    25,    50,    30,    32,
-      33,    34,    66,    49,    50,    48,    73,    39,    41,    42,
-      76,    79,    37,    38,    43,    44,    45,    46,    52,    53,
-      77,    35,    36,    74,    76,    73,    82,    48,    48,    31,
-      64,    63,    50,    49,    76,    75,    63,    42,    49,    79,
-      49,    49,    16,    40
+      12,    13,    14,    15,    17,    18,    58,    59,    60,    61,
+      62,    63,    64,    65,    70,    71,    72,    73,    74,    81,
+      83,    84,    87,    88,    89,    90,    91,    92,    93,    20,
+      22,    24,    20,    22,    24,    17,    18,    19,    43,    54,
+      66,    75,    94,    29,    27,    94,    44,    21,    23,    25,
+      94,    94,    19,     0,    50,    94,    94,    94,    94,    94,
+      94,    27,    53,    94,    94,    30,    44,    51,    26,    94,
+      66,    31,    28,    85,    86,    94,    29,    32,    67,    68,
+      94,    94,    28,    51,    76,    78,    94,    28,    53,    46,
+      94,    33,    52,    53,    35,    36,    37,    69,    51,    76,
+      42,    44,    45,    79,    82,    38,    39,    77,    40,    41,
+      46,    47,    48,    49,    55,    56,    80,    76,    85,    79,
+      51,    67,    51,    34,    66,    53,    52,    78,    79,    66,
+      45,    52,    82,    52,    52,    16,    94
 };
 
 #define yyerrok		(yyerrstatus = 0)
@@ -1632,45 +1654,55 @@ yyreduce:
     break;
 
   case 22:
-#line 64 "minisql.y"
+#line 61 "minisql.y"
+    { (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node); }
+    break;
+
+  case 23:
+#line 62 "minisql.y"
+    { (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node); }
+    break;
+
+  case 24:
+#line 66 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCreateDB, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 23:
-#line 71 "minisql.y"
+  case 25:
+#line 73 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeDropDB, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 24:
-#line 78 "minisql.y"
+  case 26:
+#line 80 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeShowDB, NULL);
   }
     break;
 
-  case 25:
-#line 84 "minisql.y"
+  case 27:
+#line 86 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeUseDB, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (2)].syntax_node));
   }
     break;
 
-  case 26:
-#line 91 "minisql.y"
+  case 28:
+#line 93 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeShowTables, NULL);
   }
     break;
 
-  case 27:
-#line 97 "minisql.y"
+  case 29:
+#line 99 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCreateTable, NULL);
     pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
@@ -1680,46 +1712,46 @@ yyreduce:
   }
     break;
 
-  case 28:
-#line 107 "minisql.y"
+  case 30:
+#line 109 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (3)].syntax_node);
     SyntaxNodeAddSibling((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 29:
-#line 111 "minisql.y"
+  case 31:
+#line 113 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 30:
-#line 117 "minisql.y"
+  case 32:
+#line 119 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (3)].syntax_node);
     SyntaxNodeAddSibling((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 31:
-#line 121 "minisql.y"
+  case 33:
+#line 123 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 32:
-#line 124 "minisql.y"
+  case 34:
+#line 126 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnList, "primary keys");
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(4) - (5)].syntax_node));
   }
     break;
 
-  case 33:
-#line 131 "minisql.y"
+  case 35:
+#line 133 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnDefinition, "unique");
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (3)].syntax_node));
@@ -1727,8 +1759,8 @@ yyreduce:
   }
     break;
 
-  case 34:
-#line 136 "minisql.y"
+  case 36:
+#line 138 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnDefinition, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (2)].syntax_node));
@@ -1736,38 +1768,38 @@ yyreduce:
   }
     break;
 
-  case 35:
-#line 144 "minisql.y"
+  case 37:
+#line 146 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnType, "int");
   }
     break;
 
-  case 36:
-#line 147 "minisql.y"
+  case 38:
+#line 149 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnType, "float");
   }
     break;
 
-  case 37:
-#line 150 "minisql.y"
+  case 39:
+#line 152 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnType, "char");
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (4)].syntax_node));
   }
     break;
 
-  case 38:
-#line 157 "minisql.y"
+  case 40:
+#line 159 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeDropTable, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 39:
-#line 164 "minisql.y"
+  case 41:
+#line 166 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCreateIndex, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (8)].syntax_node));
@@ -1778,8 +1810,8 @@ yyreduce:
   }
     break;
 
-  case 40:
-#line 172 "minisql.y"
+  case 42:
+#line 174 "minisql.y"
     {
       (yyval.syntax_node) = CreateSyntaxNode(kNodeCreateIndex, NULL);
       SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (10)].syntax_node));
@@ -1793,23 +1825,23 @@ yyreduce:
   }
     break;
 
-  case 41:
-#line 186 "minisql.y"
+  case 43:
+#line 188 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeDropIndex, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 42:
-#line 193 "minisql.y"
+  case 44:
+#line 195 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeShowIndexes, NULL);
   }
     break;
 
-  case 43:
-#line 199 "minisql.y"
+  case 45:
+#line 201 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (4)].syntax_node));
@@ -1817,8 +1849,8 @@ yyreduce:
   }
     break;
 
-  case 44:
-#line 204 "minisql.y"
+  case 46:
+#line 206 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeSelect, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (6)].syntax_node));
@@ -1829,23 +1861,23 @@ yyreduce:
   }
     break;
 
-  case 45:
-#line 215 "minisql.y"
+  case 47:
+#line 217 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeAllColumns, NULL);
   }
     break;
 
-  case 46:
-#line 218 "minisql.y"
+  case 48:
+#line 220 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeColumnList, "select columns");
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (1)].syntax_node));
   }
     break;
 
-  case 47:
-#line 225 "minisql.y"
+  case 49:
+#line 227 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(2) - (3)].syntax_node);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (3)].syntax_node));
@@ -1853,29 +1885,29 @@ yyreduce:
   }
     break;
 
-  case 48:
-#line 230 "minisql.y"
+  case 50:
+#line 232 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 49:
-#line 236 "minisql.y"
+  case 51:
+#line 238 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeConnector, "and");
   }
     break;
 
-  case 50:
-#line 239 "minisql.y"
+  case 52:
+#line 241 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeConnector, "or");
   }
     break;
 
-  case 51:
-#line 245 "minisql.y"
+  case 53:
+#line 247 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(2) - (3)].syntax_node);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (3)].syntax_node));
@@ -1883,85 +1915,85 @@ yyreduce:
   }
     break;
 
-  case 52:
-#line 253 "minisql.y"
+  case 54:
+#line 255 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 53:
-#line 256 "minisql.y"
+  case 55:
+#line 258 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 54:
-#line 259 "minisql.y"
+  case 56:
+#line 261 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeNull, NULL);
   }
     break;
 
-  case 55:
-#line 265 "minisql.y"
+  case 57:
+#line 267 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "=");
   }
     break;
 
-  case 56:
-#line 268 "minisql.y"
+  case 58:
+#line 270 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "<>");
   }
     break;
 
-  case 57:
-#line 271 "minisql.y"
+  case 59:
+#line 273 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "<=");
   }
     break;
 
-  case 58:
-#line 274 "minisql.y"
+  case 60:
+#line 276 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, ">=");
   }
     break;
 
-  case 59:
-#line 277 "minisql.y"
+  case 61:
+#line 279 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "<");
   }
     break;
 
-  case 60:
-#line 280 "minisql.y"
+  case 62:
+#line 282 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, ">");
   }
     break;
 
-  case 61:
-#line 283 "minisql.y"
+  case 63:
+#line 285 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "is");
   }
     break;
 
-  case 62:
-#line 286 "minisql.y"
+  case 64:
+#line 288 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeCompareOperator, "not");
   }
     break;
 
-  case 63:
-#line 292 "minisql.y"
+  case 65:
+#line 294 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeInsert, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (7)].syntax_node));
@@ -1971,31 +2003,31 @@ yyreduce:
   }
     break;
 
-  case 64:
-#line 302 "minisql.y"
+  case 66:
+#line 304 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (3)].syntax_node);
     SyntaxNodeAddSibling((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 65:
-#line 306 "minisql.y"
+  case 67:
+#line 308 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 66:
-#line 312 "minisql.y"
+  case 68:
+#line 314 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 67:
-#line 316 "minisql.y"
+  case 69:
+#line 318 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeDelete, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (5)].syntax_node));
@@ -2005,8 +2037,8 @@ yyreduce:
   }
     break;
 
-  case 68:
-#line 326 "minisql.y"
+  case 70:
+#line 328 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (4)].syntax_node));
@@ -2016,8 +2048,8 @@ yyreduce:
   }
     break;
 
-  case 69:
-#line 333 "minisql.y"
+  case 71:
+#line 335 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeUpdate, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (6)].syntax_node));
@@ -2032,23 +2064,23 @@ yyreduce:
   }
     break;
 
-  case 70:
-#line 348 "minisql.y"
+  case 72:
+#line 350 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (3)].syntax_node);
     SyntaxNodeAddSibling((yyval.syntax_node), (yyvsp[(3) - (3)].syntax_node));
   }
     break;
 
-  case 71:
-#line 352 "minisql.y"
+  case 73:
+#line 354 "minisql.y"
     {
     (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
   }
     break;
 
-  case 72:
-#line 358 "minisql.y"
+  case 74:
+#line 360 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeUpdateValue, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(1) - (3)].syntax_node));
@@ -2056,45 +2088,97 @@ yyreduce:
   }
     break;
 
-  case 73:
-#line 366 "minisql.y"
+  case 75:
+#line 368 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeTrxBegin, NULL);
   }
     break;
 
-  case 74:
-#line 372 "minisql.y"
+  case 76:
+#line 374 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeTrxCommit, NULL);
   }
     break;
 
-  case 75:
-#line 378 "minisql.y"
+  case 77:
+#line 380 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeTrxRollback, NULL);
   }
     break;
 
-  case 76:
-#line 384 "minisql.y"
+  case 78:
+#line 386 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeQuit, NULL);
   }
     break;
 
-  case 77:
-#line 390 "minisql.y"
+  case 79:
+#line 392 "minisql.y"
     {
     (yyval.syntax_node) = CreateSyntaxNode(kNodeExecFile, NULL);
     SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (2)].syntax_node));
   }
     break;
 
+  case 80:
+#line 399 "minisql.y"
+    {
+    (yyval.syntax_node) = CreateSyntaxNode(kNodeVacuum, NULL);
+  }
+    break;
+
+  case 81:
+#line 402 "minisql.y"
+    {
+    (yyval.syntax_node) = CreateSyntaxNode(kNodeVacuum, NULL);
+    SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(2) - (2)].syntax_node));
+  }
+    break;
+
+  case 82:
+#line 409 "minisql.y"
+    {
+    (yyval.syntax_node) = CreateSyntaxNode(kNodeLoadData, NULL);
+    SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(3) - (5)].syntax_node));
+    SyntaxNodeAddChildren((yyval.syntax_node), (yyvsp[(5) - (5)].syntax_node));
+  }
+    break;
+
+  case 83:
+#line 417 "minisql.y"
+    {
+    (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
+  }
+    break;
+
+  case 84:
+#line 420 "minisql.y"
+    {
+    (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
+  }
+    break;
+
+  case 85:
+#line 423 "minisql.y"
+    {
+    (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
+  }
+    break;
+
+  case 86:
+#line 426 "minisql.y"
+    {
+    (yyval.syntax_node) = (yyvsp[(1) - (1)].syntax_node);
+  }
+    break;
+
 
 /* Line 1267 of yacc.c.  */
-#line 2098 "./minisql_yacc.c"
+#line 2182 "./minisql_yacc.c"
       default: break;
     }
   YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
@@ -2308,7 +2392,7 @@ yyreturn:
 }
 
 
-#line 396 "minisql.y"
+#line 431 "minisql.y"
 
 int yyerror(char* error) {
 	MinisqlParserSetError(error);
@@ -169,6 +169,10 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeVacuum:
+      return "kNodeVacuum";
+    case kNodeLoadData:
+      return "kNodeLoadData";
     default:
       return "error type";
   }
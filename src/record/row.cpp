@@ -1,37 +1,62 @@
 #include "record/row.h"
 
+static_assert(PAGE_SIZE <= 65536, "CHAR offsets in a row are 2 bytes.");
+
 /**
  * TODO: Student Implement
  */
-uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
+uint32_t Row::SerializeTo(char *buf, Schema *schema, RowFormat format) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
   // replace with your code here
   uint32_t offset=0;
   uint32_t num=this->fields_.size();
   if(num==0) return offset;//如果num为0，直接返回，不要存
-//  //写rowId
-//  MACH_WRITE_INT32(buf+offset,rid_.GetPageId());
-//  offset+=sizeof(int32_t);
-//  MACH_WRITE_UINT32(buf+offset,rid_.GetSlotNum());
-//  offset==sizeof(uint32_t);
-  //1.存num
-  MACH_WRITE_UINT32(buf+offset,num);
+  if(format==kRowFormatLegacy){
+    //1.存num
+    MACH_WRITE_UINT32(buf+offset,num);
+    offset+=sizeof(uint32_t);
+    //2.存bitmap，长度可以不存，根据num推算出来；直接写在buf里
+    uint32_t n=(num-1)/8*8+1;
+    memset(buf+offset,0,n);
+    for(uint32_t i=0;i<num;i++){
+      if(!this->fields_[i]->IsNull()) buf[offset+i/8]|=(0x01<<(i%8));//非空的位设为1
+    }
+    offset+=n;
+    //3.存field
+    for(uint32_t i=0;i<num;i++){
+      offset+=this->fields_[i]->SerializeTo(buf+offset);
+    }
+    return offset;
+  }
+  //1.版本和num
+  MACH_WRITE_UINT32(buf,(static_cast<uint32_t>(format)<<24)|num);
   offset+=sizeof(uint32_t);
-  //算出需要多少bytes的bitmap
-  uint32_t n=(num-1)/8*8+1;
-  char* bitmap=new char[n];
+  //2.bitmap
+  uint32_t n=(num+7)/8;
+  memset(buf+offset,0,n);
   for(uint32_t i=0;i<num;i++){
-    if(this->fields_[i]->IsNull()) bitmap[i/8]&=~(0x01<<(i%8));//空的话设置位0
-    else bitmap[i/8]|=(0x01<<(i%8));
+    if(!this->fields_[i]->IsNull()) buf[offset+i/8]|=(0x01<<(i%8));
   }
-  //2.存bitmap，长度可以不存，根据num推算出来
-  memcpy(buf+offset,bitmap,n);
   offset+=n;
-  delete[] bitmap;
-  //3.存field
+  //3.定长区、偏移表，CHAR的数据跟在偏移表后面
+  char *fixed=buf+offset;
+  char *offsets=fixed+schema->GetFixedSize();
+  offset+=schema->GetFixedSize()+schema->GetCharCount()*sizeof(uint16_t);
   for(uint32_t i=0;i<num;i++){
-    offset+=this->fields_[i]->SerializeTo(buf+offset);
+    Field *field=this->fields_[i];
+    uint32_t slot=schema->GetFieldSlot(i);
+    if(schema->GetColumn(i)->GetType()==TypeId::kTypeChar){
+      if(!field->IsNull()){
+        memcpy(buf+offset,field->GetData(),field->GetLength());
+        offset+=field->GetLength();
+      }
+      MACH_WRITE_TO(uint16_t,offsets+slot*sizeof(uint16_t),offset);
+    }else if(field->IsNull()){
+      memset(fixed+slot,0,Type::GetTypeSize(schema->GetColumn(i)->GetType()));
+    }else{
+      field->SerializeTo(fixed+slot);
+    }
   }
   return offset;
 }
@@ -42,27 +67,51 @@ uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
   // replace with your code here
   //1.读取num,不用考虑num=0的情况，因为table_page在插入row时做了限制，num=0时不会插进去
   uint32_t offset=0;
-  uint32_t num=MACH_READ_UINT32(buf+offset);
+  uint32_t num=GetFieldCount(buf);
   offset+=sizeof(uint32_t);
   if(num==0) return sizeof(uint32_t);
-  //2.读取bitmap
-  uint32_t n=(num-1)/8*8+1;
-  char* bitmap=new char[n];
-  memcpy(bitmap,buf+offset,n);
-  offset+=n;
-  //3.读取field
+  //2.bitmap直接在buf里读
+  const char *bitmap=buf+offset;
+  if(GetFormat(buf)==kRowFormatLegacy){
+    offset+=(num-1)/8*8+1;
+    //3.读取field
+    for(uint32_t i=0;i<num;i++){
+      Field* f;
+      TypeId type=schema->GetColumn(i)->GetType();
+      bool is_null=(bitmap[i/8]&(0x01<<i%8))==0x00? true:false;
+      offset+=Field::DeserializeFrom(buf+offset,type,&f,is_null);
+      this->fields_.push_back(f);
+    }
+    return offset;
+  }
+  offset+=(num+7)/8;
+  char *fixed=buf+offset;
+  char *offsets=fixed+schema->GetFixedSize();
+  offset+=schema->GetFixedSize()+schema->GetCharCount()*sizeof(uint16_t);
   for(uint32_t i=0;i<num;i++){
     Field* f;
     TypeId type=schema->GetColumn(i)->GetType();
+    uint32_t slot=schema->GetFieldSlot(i);
     bool is_null=(bitmap[i/8]&(0x01<<i%8))==0x00? true:false;
-    offset+=Field::DeserializeFrom(buf+offset,type,&f,is_null);
+    if(is_null){
+      f=new Field(type);
+    }else if(type==TypeId::kTypeChar){
+      uint32_t begin=slot==0?offset:MACH_READ_FROM(uint16_t,offsets+(slot-1)*sizeof(uint16_t));
+      uint32_t end=MACH_READ_FROM(uint16_t,offsets+slot*sizeof(uint16_t));
+      f=new Field(type,buf+begin,end-begin,true);
+    }else{
+      Field::DeserializeFrom(fixed+slot,type,&f,false);
+    }
     this->fields_.push_back(f);
   }
-  delete[] bitmap;
+  //最后一个CHAR的结尾就是行尾
+  if(schema->GetCharCount()>0){
+    offset=MACH_READ_FROM(uint16_t,offsets+(schema->GetCharCount()-1)*sizeof(uint16_t));
+  }
   return offset;
 }
 
-uint32_t Row::GetSerializedSize(Schema *schema) const {
+uint32_t Row::GetSerializedSize(Schema *schema, RowFormat format) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
   // replace with your code here
@@ -70,10 +119,19 @@ uint32_t Row::GetSerializedSize(Schema *schema) const {
   uint32_t offset=0;
   if(num==0) return offset;//0直接返回0，不用返回sizeof(uint32_t)
   offset+=sizeof(uint32_t);
-  uint32_t n=(num-1)/8*8+1;
-  offset+=n;
+  if(format==kRowFormatLegacy){
+    uint32_t n=(num-1)/8*8+1;
+    offset+=n;
+    for(uint32_t i=0;i<num;i++){
+      offset+=this->fields_[i]->GetSerializedSize();
+    }
+    return offset;
+  }
+  offset+=(num+7)/8+schema->GetFixedSize()+schema->GetCharCount()*sizeof(uint16_t);
   for(uint32_t i=0;i<num;i++){
-    offset+=this->fields_[i]->GetSerializedSize();
+    if(schema->GetColumn(i)->GetType()==TypeId::kTypeChar&&!this->fields_[i]->IsNull()){
+      offset+=this->fields_[i]->GetLength();
+    }
   }
   return offset;
 }
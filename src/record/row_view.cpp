@@ -0,0 +1,109 @@
+#include "record/row_view.h"
+
+#include <stdexcept>
+
+void RowView::Reset(const char *data, Schema *schema, RowId rid) {
+  data_ = data;
+  schema_ = schema;
+  rid_ = rid;
+  legacy_offsets_.clear();
+  field_count_ = 0;
+  bitmap_ = fixed_ = offsets_ = nullptr;
+  if (data_ == nullptr) return;
+  // 格式见Row：版本和字段数 | 空值位图 | 各字段
+  field_count_ = Row::GetFieldCount(data_);
+  if (field_count_ == 0) return;
+  ASSERT(field_count_ == schema_->GetColumnCount(), "Fields size do not match schema's column size.");
+  format_ = Row::GetFormat(data_);
+  bitmap_ = data_ + sizeof(uint32_t);
+  if (format_ == kRowFormatLegacy) {
+    legacy_offsets_.push_back(sizeof(uint32_t) + (field_count_ - 1) / 8 * 8 + 1);
+  } else {
+    fixed_ = bitmap_ + (field_count_ + 7) / 8;
+    offsets_ = fixed_ + schema_->GetFixedSize();
+  }
+}
+
+bool RowView::IsNull(uint32_t idx) const {
+  ASSERT(idx < field_count_, "Failed to access field");
+  return (bitmap_[idx / 8] & (0x01 << idx % 8)) == 0x00;
+}
+
+uint32_t RowView::GetLegacyFieldOffset(uint32_t idx) const {
+  ASSERT(idx < field_count_, "Failed to access field");
+  while (legacy_offsets_.size() <= idx) {
+    uint32_t i = legacy_offsets_.size() - 1;
+    uint32_t offset = legacy_offsets_.back();
+    if (!IsNull(i)) {
+      TypeId type = schema_->GetColumn(i)->GetType();
+      if (type == TypeId::kTypeChar) {
+        offset += sizeof(uint32_t) + MACH_READ_UINT32(data_ + offset);
+      } else {
+        offset += Type::GetTypeSize(type);
+      }
+    }
+    legacy_offsets_.push_back(offset);
+  }
+  return legacy_offsets_[idx];
+}
+
+const char *RowView::GetFieldData(uint32_t idx, uint32_t *len) const {
+  bool is_char = schema_->GetColumn(idx)->GetType() == TypeId::kTypeChar;
+  if (format_ == kRowFormatLegacy) {
+    const char *field = data_ + GetLegacyFieldOffset(idx);
+    if (!is_char) return field;
+    *len = MACH_READ_UINT32(field);
+    return field + sizeof(uint32_t);
+  }
+  uint32_t slot = schema_->GetFieldSlot(idx);
+  if (!is_char) return fixed_ + slot;
+  // 数据从前一个CHAR的结尾开始，第一个紧跟在偏移表后面
+  uint32_t begin = slot == 0 ? offsets_ + schema_->GetCharCount() * sizeof(uint16_t) - data_
+                             : MACH_READ_FROM(uint16_t, offsets_ + (slot - 1) * sizeof(uint16_t));
+  *len = MACH_READ_FROM(uint16_t, offsets_ + slot * sizeof(uint16_t)) - begin;
+  return data_ + begin;
+}
+
+Field RowView::GetField(uint32_t idx) const {
+  TypeId type = schema_->GetColumn(idx)->GetType();
+  if (IsNull(idx)) {
+    return Field(type);
+  }
+  uint32_t len = 0;
+  const char *field = GetFieldData(idx, &len);
+  switch (type) {
+    case TypeId::kTypeInt:
+      return Field(type, MACH_READ_FROM(int32_t, field));
+    case TypeId::kTypeFloat:
+      return Field(type, MACH_READ_FROM(float, field));
+    case TypeId::kTypeChar:
+      return Field(type, const_cast<char *>(field), len, false);
+    default:
+      throw std::logic_error("Unsupported field type.");
+  }
+}
+
+void RowView::ToRow(Row *row) const {
+  row->destroy();
+  row->SetRowId(rid_);
+  if (data_ != nullptr) {
+    row->DeserializeFrom(const_cast<char *>(data_), schema_);
+  }
+}
+
+void RowView::ToRow(Row *row, const std::vector<uint32_t> &idxs) const {
+  row->destroy();
+  row->SetRowId(rid_);
+  auto &fields = row->GetFields();
+  for (auto idx : idxs) {
+    TypeId type = schema_->GetColumn(idx)->GetType();
+    if (type == TypeId::kTypeChar && !IsNull(idx)) {
+      // 视图里的CHAR指向页内，这里要拷一份出来
+      uint32_t len = 0;
+      const char *field = GetFieldData(idx, &len);
+      fields.push_back(new Field(type, const_cast<char *>(field), len, true));
+    } else {
+      fields.push_back(new Field(GetField(idx)));
+    }
+  }
+}
@@ -0,0 +1,306 @@
+#include "storage/async_io.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "glog/logging.h"
+
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define MINISQL_HAVE_IO_URING 1
+#endif
+
+/** Issue a vectored request with preadv/pwritev, retrying short transfers until the end of the file */
+static void ExecuteVectored(IORequest *request) {
+  std::vector<iovec> iov(request->iov_, request->iov_ + request->iovcnt_);
+  size_t first = 0;  // iov[first..] are not completely transferred yet
+  size_t done = 0;
+  while (first < iov.size()) {
+    int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+    off_t offset = static_cast<off_t>(request->offset_ + done);
+    ssize_t n = request->write_ ? pwritev(request->fd_, &iov[first], count, offset)
+                                : preadv(request->fd_, &iov[first], count, offset);
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) {
+      request->result_ = -errno;
+      return;
+    }
+    if (n == 0) break;
+    done += n;
+    // 跳过已经传输完的缓冲区，剩下的部分从中间继续
+    while (first < iov.size() && static_cast<size_t>(n) >= iov[first].iov_len) {
+      n -= iov[first++].iov_len;
+    }
+    if (n > 0) {
+      iov[first].iov_base = static_cast<char *>(iov[first].iov_base) + n;
+      iov[first].iov_len -= n;
+    }
+  }
+  request->result_ = static_cast<ssize_t>(done);
+}
+
+/** Issue a request with plain system calls, retrying short transfers until the end of the file */
+static void ExecuteSync(IORequest *request) {
+  if (request->iov_ != nullptr) {
+    ExecuteVectored(request);
+    return;
+  }
+  size_t done = 0;
+  while (done < request->size_) {
+    ssize_t n = request->write_ ? pwrite(request->fd_, request->buf_ + done, request->size_ - done,
+                                         static_cast<off_t>(request->offset_ + done))
+                                : pread(request->fd_, request->buf_ + done, request->size_ - done,
+                                        static_cast<off_t>(request->offset_ + done));
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) {
+      request->result_ = -errno;
+      return;
+    }
+    if (n == 0) break;
+    done += n;
+  }
+  request->result_ = static_cast<ssize_t>(done);
+}
+
+/**
+ * Fallback engine, a fixed pool of threads that take the requests of a batch one by one.
+ */
+class ThreadPoolAsyncIO : public AsyncIO {
+ public:
+  explicit ThreadPoolAsyncIO(size_t num_threads) {
+    for (size_t i = 0; i < num_threads; i++) {
+      workers_.emplace_back(&ThreadPoolAsyncIO::WorkerLoop, this);
+    }
+  }
+
+  ~ThreadPoolAsyncIO() override {
+    {
+      std::scoped_lock<std::mutex> lock(latch_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Execute(std::vector<IORequest> *requests) override {
+    std::unique_lock<std::mutex> lock(latch_);
+    size_t pending = requests->size();
+    for (auto &request : *requests) {
+      queue_.push_back({&request, &pending});
+    }
+    cv_.notify_all();
+    done_cv_.wait(lock, [&] { return pending == 0; });
+  }
+
+  const char *Name() const override { return "thread pool"; }
+
+ private:
+  struct Task {
+    IORequest *request_;
+    size_t *pending_;  // requests of the batch that are not done yet
+  };
+
+  void WorkerLoop() {
+    std::unique_lock<std::mutex> lock(latch_);
+    while (true) {
+      cv_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      Task task = queue_.front();
+      queue_.pop_front();
+      lock.unlock();
+      ExecuteSync(task.request_);
+      lock.lock();
+      if (--*task.pending_ == 0) done_cv_.notify_all();
+    }
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex latch_;
+  std::condition_variable cv_;
+  std::condition_variable done_cv_;
+  std::deque<Task> queue_;
+  bool stop_{false};
+};
+
+#ifdef MINISQL_HAVE_IO_URING
+/**
+ * io_uring engine without liburing. The rings are mapped once, the batch is fed into the submission ring as it
+ * drains and completions are reaped after every io_uring_enter. Should io_uring_enter fail with anything but a
+ * transient error, the requests still in flight are waited for and the engine switches to a thread pool for good.
+ */
+class IOUringAsyncIO : public AsyncIO {
+ public:
+  /** @return nullptr if the kernel refuses to set up a ring */
+  static std::unique_ptr<IOUringAsyncIO> Setup(unsigned entries) {
+    std::unique_ptr<IOUringAsyncIO> ring(new IOUringAsyncIO());
+    if (!ring->Init(entries)) return nullptr;
+    return ring;
+  }
+
+  ~IOUringAsyncIO() override {
+    if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+    if (sq_ptr_ != nullptr) munmap(sq_ptr_, sq_size_);
+    if (ring_fd_ >= 0) close(ring_fd_);
+  }
+
+  void Execute(std::vector<IORequest> *requests) override {
+    std::scoped_lock<std::mutex> lock(latch_);
+    if (fallback_ != nullptr) {
+      fallback_->Execute(requests);
+      return;
+    }
+    std::vector<iovec> iovecs(requests->size());
+    size_t submitted = 0;  // requests put into the submission ring
+    size_t completed = 0;
+    unsigned queued = 0;     // in the submission ring, not consumed by the kernel yet
+    unsigned in_kernel = 0;  // consumed by the kernel, not completed yet
+    while (completed < requests->size()) {
+      // 填满提交队列，在途的请求不超过队列深度
+      unsigned tail = *sq_tail_;
+      while (submitted < requests->size() && queued + in_kernel < entries_) {
+        IORequest &request = (*requests)[submitted];
+        iovecs[submitted] = {request.buf_, request.size_};
+        bool vectored = request.iov_ != nullptr;
+        unsigned index = tail & *sq_mask_;
+        io_uring_sqe *sqe = &sqes_[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = request.write_ ? IORING_OP_WRITEV : IORING_OP_READV;
+        sqe->fd = request.fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(vectored ? request.iov_ : &iovecs[submitted]);
+        sqe->len = vectored ? request.iovcnt_ : 1;
+        sqe->off = request.offset_;
+        sqe->user_data = submitted;
+        sq_array_[index] = index;
+        tail++;
+        queued++;
+        submitted++;
+      }
+      __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+      int ret = syscall(__NR_io_uring_enter, ring_fd_, queued, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (ret < 0) {
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+          // 内核不再接受请求：收回还没被取走的，等在途的完成，剩下的交给线程池
+          LOG(WARNING) << "io_uring_enter failed: " << strerror(errno) << ", using a thread pool for asynchronous I/O"
+                       << std::endl;
+          __atomic_store_n(sq_tail_, tail - queued, __ATOMIC_RELEASE);
+          while (in_kernel > 0) {
+            Reap(requests, &completed, &in_kernel);
+            if (in_kernel > 0) std::this_thread::yield();
+          }
+          FallBack(requests, submitted - queued);
+          return;
+        }
+        ret = 0;
+      }
+      queued -= ret;
+      in_kernel += ret;
+      Reap(requests, &completed, &in_kernel);
+    }
+  }
+
+  const char *Name() const override { return "io_uring"; }
+
+ private:
+  IOUringAsyncIO() = default;
+
+  bool Init(unsigned entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring_fd_ < 0) return false;
+    entries_ = params.sq_entries;
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    sq_ptr_ = Map(sq_size_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == nullptr) return false;
+    cq_ptr_ = single_mmap ? sq_ptr_ : Map(cq_size_, IORING_OFF_CQ_RING);
+    if (cq_ptr_ == nullptr) return false;
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+    if (sqes_ == nullptr) return false;
+    auto sq = static_cast<char *>(sq_ptr_);
+    auto cq = static_cast<char *>(cq_ptr_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  void *Map(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  /** Execute requests from first on, and every later batch, with a thread pool */
+  void FallBack(std::vector<IORequest> *requests, size_t first) {
+    fallback_ = std::make_unique<ThreadPoolAsyncIO>(std::min<unsigned>(entries_, ASYNC_IO_THREADS));
+    std::vector<IORequest> rest(requests->begin() + first, requests->end());
+    fallback_->Execute(&rest);
+    std::copy(rest.begin(), rest.end(), requests->begin() + first);
+  }
+
+  /** Take all available completions */
+  void Reap(std::vector<IORequest> *requests, size_t *completed, unsigned *in_kernel) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+      io_uring_cqe *cqe = &cqes_[head & *cq_mask_];
+      (*requests)[cqe->user_data].result_ = cqe->res;
+      (*completed)++;
+      (*in_kernel)--;
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+  }
+
+ private:
+  int ring_fd_{-1};
+  unsigned entries_{0};
+  void *sq_ptr_{nullptr};
+  void *cq_ptr_{nullptr};
+  size_t sq_size_{0};
+  size_t cq_size_{0};
+  io_uring_sqe *sqes_{nullptr};
+  size_t sqes_size_{0};
+  unsigned *sq_tail_{nullptr};
+  unsigned *sq_mask_{nullptr};
+  unsigned *sq_array_{nullptr};
+  unsigned *cq_head_{nullptr};
+  unsigned *cq_tail_{nullptr};
+  unsigned *cq_mask_{nullptr};
+  io_uring_cqe *cqes_{nullptr};
+  std::mutex latch_;  // one batch at a time owns the rings
+  std::unique_ptr<AsyncIO> fallback_;  // set once io_uring_enter failed for good
+};
+#endif
+
+std::unique_ptr<AsyncIO> AsyncIO::Create(size_t queue_depth, bool use_io_uring) {
+#ifdef MINISQL_HAVE_IO_URING
+  if (use_io_uring) {
+    auto ring = IOUringAsyncIO::Setup(static_cast<unsigned>(queue_depth));
+    if (ring != nullptr) return ring;
+    LOG(WARNING) << "io_uring is not available, using a thread pool for asynchronous I/O" << std::endl;
+  }
+#endif
+  return std::make_unique<ThreadPoolAsyncIO>(std::min<size_t>(queue_depth, ASYNC_IO_THREADS));
+}
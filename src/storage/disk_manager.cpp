@@ -1,39 +1,106 @@
 #include "storage/disk_manager.h"
 
-#include <sys/stat.h>
-#include <filesystem>
+#include <sys/uio.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 
 #include "glog/logging.h"
 #include "page/bitmap_page.h"
 
-DiskManager::DiskManager(const std::string &db_file) : file_name_(db_file) {
+static const char ZERO_PAGE[PAGE_SIZE] = {0};
+
+/**
+ * Open the backend of a database file.
+ * @param compressed whether a new file gets compressed pages
+ */
+static std::unique_ptr<StorageBackend> OpenFile(const std::string &db_file, bool direct_io, bool read_only,
+                                                bool compressed) {
+  // 先用普通I/O打开，看是不是压缩过的文件
+  auto file = std::make_unique<FileBackend>(db_file, false, read_only);
+  if (CompressedBackend::IsCompressed(file.get()) || (compressed && !read_only && file->Size() == 0)) {
+    return std::make_unique<CompressedBackend>(std::move(file));
+  }
+  if (direct_io) file = std::make_unique<FileBackend>(db_file, true, read_only);
+  return file;
+}
+
+DiskManager::DiskManager(const std::string &db_file, bool direct_io, bool read_only, bool compressed)
+    : DiskManager(OpenFile(db_file, direct_io, read_only, compressed), read_only) {}
+
+DiskManager::DiskManager(std::unique_ptr<StorageBackend> backend, bool read_only)
+    : backend_(std::move(backend)), read_only_(read_only) {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-  // directory or file does not exist
-  if (!db_io_.is_open()) {
-    db_io_.clear();
-    // create a new file
-    std::filesystem::path p = db_file;
-    if(p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
-    db_io_.open(db_file, std::ios::binary | std::ios::trunc | std::ios::out);
-    db_io_.close();
-    // reopen with original mode
-    db_io_.open(db_file, std::ios::binary | std::ios::in | std::ios::out);
-    if (!db_io_.is_open()) {
-      throw std::exception();
+  ASSERT(backend_->Alignment() <= DIRECT_IO_ALIGNMENT, "Bounce buffers are not aligned enough.");
+  file_size_ = backend_->Size();
+  if (read_only) {
+    mapping_ = backend_->Map();
+    if (mapping_ == nullptr && file_size_ > 0) {
+      throw std::runtime_error(std::string(backend_->Name()) + " can not be mapped into memory");
     }
+    mapping_size_ = mapping_ != nullptr ? file_size_.load() : 0;
   }
   ReadPhysicalPage(META_PAGE_ID, meta_data_);
+  if (!CheckFileHeader()) {
+    throw std::runtime_error(std::string(backend_->Name()) + " was not created with " + std::to_string(PAGE_SIZE) +
+                             "-byte pages");
+  }
+}
+
+bool DiskManager::CheckFileHeader() {
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  if (file_size_ == 0) {
+    // 新文件，写入文件头
+    meta_page->magic_ = DiskFileMetaPage::MAGIC;
+    meta_page->page_size_ = PAGE_SIZE;
+    meta_dirty_ = true;
+    return true;
+  }
+  if (meta_page->magic_ == DiskFileMetaPage::MAGIC) {
+    if (meta_page->page_size_ == PAGE_SIZE) return true;
+    LOG(ERROR) << backend_->Name() << " uses " << meta_page->page_size_ << "-byte pages, this build uses " << PAGE_SIZE;
+    return false;
+  }
+  // 没有文件头的旧文件，页大小一定是4KB，计数整体后移腾出文件头
+  const uint32_t legacy_page_size = 4096;
+  const uint32_t legacy_header_size = 2 * sizeof(uint32_t);
+  uint32_t num_extents = reinterpret_cast<uint32_t *>(meta_data_)[1];
+  if (PAGE_SIZE != legacy_page_size || num_extents > DiskFileMetaPage::MAX_EXTENTS) {
+    LOG(ERROR) << backend_->Name() << " is not a database file with " << PAGE_SIZE << "-byte pages";
+    return false;
+  }
+  memmove(meta_data_ + DiskFileMetaPage::HEADER_SIZE - legacy_header_size, meta_data_,
+          PAGE_SIZE - (DiskFileMetaPage::HEADER_SIZE - legacy_header_size));
+  meta_page->magic_ = DiskFileMetaPage::MAGIC;
+  meta_page->page_size_ = PAGE_SIZE;
+  meta_dirty_ = true;
+  return true;
+}
+
+bool DiskManager::Sync() {
+  if (read_only_) return true;
+  {
+    std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+    ReleaseRuns();
+    WriteAllocatorMetadata();
+    TruncateFile();
+  }
+  if (!backend_->Sync()) {
+    LOG(ERROR) << "I/O error while syncing " << backend_->Name();
+    return false;
+  }
+  return true;
 }
 
 void DiskManager::Close() {
   std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
-  WritePhysicalPage(META_PAGE_ID, meta_data_);
-  if (!closed) {
-    db_io_.close();
-    closed = true;
-  }
+  if (closed) return;
+  meta_dirty_ = true;
+  Sync();
+  // 后端留到析构时再释放，关闭之后的写页请求直接拒绝
+  closed = true;
 }
 
 void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
@@ -41,68 +108,237 @@ void DiskManager::ReadPage(page_id_t logical_page_id, char *page_data) {
   ReadPhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
+void DiskManager::ReadPages(page_id_t logical_page_id, size_t count, char *page_data) {
+  ASSERT(logical_page_id >= 0, "Invalid page id.");
+  while (count > 0) {
+    // 每个分区前有一个位图页，分区内的页在物理上是连续的
+    size_t extent_left = BITMAP_SIZE - logical_page_id % BITMAP_SIZE;
+    size_t run = std::min(count, extent_left);
+    ReadPhysicalPages(MapPageId(logical_page_id), run, page_data);
+    logical_page_id += run;
+    page_data += run * PAGE_SIZE;
+    count -= run;
+  }
+}
+
 void DiskManager::WritePage(page_id_t logical_page_id, const char *page_data) {
   ASSERT(logical_page_id >= 0, "Invalid page id.");
+  if (read_only_ || closed) {
+    LOG(ERROR) << "Page write rejected, " << backend_->Name() << (closed ? " is closed" : " is read-only");
+    return;
+  }
   WritePhysicalPage(MapPageId(logical_page_id), page_data);
 }
 
+void DiskManager::ReadPageBatch(const std::vector<std::pair<page_id_t, char *>> &pages) {
+  std::vector<IORequest> requests;
+  std::vector<char *> targets;  // where each request's page goes
+  size_t alignment = backend_->Alignment();
+  std::vector<std::unique_ptr<char, decltype(&free)>> bounces;
+  size_t file_size = file_size_.load();
+  for (auto &page : pages) {
+    ASSERT(page.first >= 0, "Invalid page id.");
+    size_t offset = static_cast<size_t>(MapPageId(page.first)) * PAGE_SIZE;
+    if (offset >= file_size) {
+      memset(page.second, 0, PAGE_SIZE);  // 文件末尾之后的页全是0
+      continue;
+    }
+    char *buf = page.second;
+    if (reinterpret_cast<uintptr_t>(buf) % alignment != 0) {
+      buf = static_cast<char *>(aligned_alloc(alignment, PAGE_SIZE));
+      bounces.emplace_back(buf, &free);
+    }
+    requests.push_back({-1, buf, PAGE_SIZE, offset, false});
+    targets.push_back(page.second);
+  }
+  if (requests.empty()) return;
+  backend_->Execute(&requests);
+  for (size_t i = 0; i < requests.size(); i++) {
+    IORequest &request = requests[i];
+    if (request.result_ < 0) {
+      LOG(ERROR) << "I/O error while reading";
+      request.result_ = 0;
+    }
+    if (request.buf_ != targets[i]) memcpy(targets[i], request.buf_, request.result_);
+    memset(targets[i] + request.result_, 0, PAGE_SIZE - request.result_);
+  }
+}
+
+bool DiskManager::WritePageBatch(const std::vector<std::pair<page_id_t, const char *>> &pages) {
+  if ((read_only_ || closed) && !pages.empty()) {
+    LOG(ERROR) << "Page write rejected, " << backend_->Name() << (closed ? " is closed" : " is read-only");
+    return false;
+  }
+  if (pages.empty()) return true;
+  // 按物理位置排序，相邻的页合并成一个pwritev
+  std::vector<std::pair<size_t, const char *>> writes;
+  writes.reserve(pages.size());
+  for (auto &page : pages) {
+    ASSERT(page.first >= 0, "Invalid page id.");
+    writes.emplace_back(static_cast<size_t>(MapPageId(page.first)) * PAGE_SIZE, page.second);
+  }
+  std::stable_sort(writes.begin(), writes.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+  // 同一页写了多次，只留最后一次
+  size_t unique = 0;
+  for (size_t i = 0; i < writes.size(); i++) {
+    if (unique > 0 && writes[unique - 1].first == writes[i].first) unique--;
+    writes[unique++] = writes[i];
+  }
+  writes.resize(unique);
+  std::vector<iovec> iovecs(writes.size());  // never reallocated, the requests point into it
+  size_t alignment = backend_->Alignment();
+  std::vector<IORequest> requests;
+  std::vector<std::unique_ptr<char, decltype(&free)>> bounces;
+  for (size_t i = 0; i < writes.size(); i++) {
+    // 请求只是读这块内存，去掉const不会修改它
+    char *buf = const_cast<char *>(writes[i].second);
+    if (reinterpret_cast<uintptr_t>(buf) % alignment != 0) {
+      buf = static_cast<char *>(aligned_alloc(alignment, PAGE_SIZE));
+      memcpy(buf, writes[i].second, PAGE_SIZE);
+      bounces.emplace_back(buf, &free);
+    }
+    iovecs[i] = {buf, PAGE_SIZE};
+    IORequest *last = requests.empty() ? nullptr : &requests.back();
+    if (last != nullptr && last->offset_ + last->size_ == writes[i].first && last->iovcnt_ < IOV_MAX) {
+      last->size_ += PAGE_SIZE;
+      last->iovcnt_++;
+    } else {
+      requests.push_back({-1, nullptr, PAGE_SIZE, writes[i].first, true, 0, &iovecs[i], 1});
+    }
+  }
+  backend_->Execute(&requests);
+  bool written = true;
+  for (auto &request : requests) {
+    if (request.result_ != static_cast<ssize_t>(request.size_)) written = false;
+  }
+  UpdateFileSize(writes.back().first + PAGE_SIZE);
+  if (!written) LOG(ERROR) << "I/O error while writing";
+  return written;
+}
+
+const char *DiskManager::GetMappedPage(page_id_t logical_page_id) {
+  ASSERT(read_only_, "Only a read-only file is mapped.");
+  size_t offset = static_cast<size_t>(MapPageId(logical_page_id)) * PAGE_SIZE;
+  return offset + PAGE_SIZE <= mapping_size_ ? mapping_ + offset : ZERO_PAGE;
+}
+
 /**
  * TODO: Student Implement
  */
 page_id_t DiskManager::AllocatePage() {
-  //ASSERT(false, "Not implemented yet.");
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  if (read_only_) return INVALID_PAGE_ID;  // 只读文件不能分配
   DiskFileMetaPage* metaPage=reinterpret_cast<DiskFileMetaPage *>(this->meta_data_);//获得metaPage
-  //寻找第一个没有满的分区
-  BitmapPage<PAGE_SIZE>* bitmap;
-  uint32_t extent=0;
+  //寻找第一个没有满的分区，free_extent_hint_之前的分区都是满的
+  uint32_t extent=std::min<uint32_t>(free_extent_hint_, metaPage->num_extents_);
   while(extent<metaPage->num_extents_){
     if(metaPage->extent_used_page_[extent]<BITMAP_SIZE) break;
     extent++;
   }
-  if(extent==metaPage->num_extents_){
-    if(metaPage->num_extents_<(PAGE_SIZE-8)/4){
-      metaPage->num_extents_++;
-      metaPage->extent_used_page_[extent]=0;
-      //创建位图
-      bitmap=new BitmapPage<PAGE_SIZE>();
-    }else
-      return false;//满了
-  }else{//获取位图
-    char page_data[PAGE_SIZE];
-    ReadPhysicalPage(1+extent*(BITMAP_SIZE+1),page_data);
-    bitmap=reinterpret_cast<BitmapPage<PAGE_SIZE>*>(page_data);
-  }
+  free_extent_hint_ = extent;
+  if(extent==metaPage->num_extents_&&!AddExtent()) return INVALID_PAGE_ID;//满了
+  BitmapPage<PAGE_SIZE>* bitmap=GetBitmap(extent);
   uint32_t offset;
   if(bitmap->AllocatePage(offset))
   {
-    //更新metaPage
+    //更新metaPage，位图和metaPage在Sync或Close时才写回
     metaPage->num_allocated_pages_++;
     metaPage->extent_used_page_[extent]++;
-    //if(extent>=metaPage->num_extents_) metaPage->num_extents_++;
-    this->WritePhysicalPage(0,this->meta_data_);
-    this->WritePhysicalPage(extent*(BITMAP_SIZE+1)+1,reinterpret_cast<char*>(bitmap));
+    bitmap_dirty_[extent] = true;
+    meta_dirty_ = true;
     return extent*BITMAP_SIZE+offset;//返回逻辑地址
   }
   LOG(ERROR) << "AllocatePage wrong" << std::endl;
   return INVALID_PAGE_ID;
 }
 
+page_id_t DiskManager::AllocatePage(page_id_t near_page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  if (near_page_id < 0 || read_only_) return AllocatePage();
+  auto run = FindRun(near_page_id);
+  if (run == runs_.end()) run = ReserveRun(near_page_id + 1);
+  // 附近没有空闲页，从第一个没满的分区开始新的一段
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  for (uint32_t extent = free_extent_hint_; run == runs_.end() && extent <= meta_page->num_extents_; extent++) {
+    run = ReserveRun(extent * BITMAP_SIZE);
+  }
+  if (run == runs_.end()) return INVALID_PAGE_ID;
+  page_id_t page_id = run->second.next_++;
+  if (run->second.next_ == run->second.end_) runs_.erase(run);
+  return page_id;
+}
+
+bool DiskManager::AddExtent() {
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  if (meta_page->num_extents_ >= DiskFileMetaPage::MAX_EXTENTS) return false;
+  uint32_t extent = meta_page->num_extents_++;
+  meta_page->extent_used_page_[extent] = 0;
+  memset(GetBitmap(extent), 0, PAGE_SIZE);  // 新分区的位图全是0
+  bitmap_dirty_[extent] = true;
+  meta_dirty_ = true;
+  return true;
+}
+
+std::map<page_id_t, DiskManager::PageRun>::iterator DiskManager::ReserveRun(page_id_t begin) {
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  uint32_t extent = begin / BITMAP_SIZE;
+  if (extent > meta_page->num_extents_) return runs_.end();
+  if (extent == meta_page->num_extents_ && !AddExtent()) return runs_.end();
+  BitmapPage<PAGE_SIZE> *bitmap = GetBitmap(extent);
+  uint32_t first = bitmap->FindFreePage(begin % BITMAP_SIZE);
+  uint32_t last = first;
+  while (last < BITMAP_SIZE && last - first < PAGE_RUN_SIZE && bitmap->AllocatePageAt(last)) {
+    last++;
+  }
+  if (last == first) return runs_.end();
+  meta_page->num_allocated_pages_ += last - first;
+  meta_page->extent_used_page_[extent] += last - first;
+  bitmap_dirty_[extent] = true;
+  meta_dirty_ = true;
+  page_id_t run_begin = extent * BITMAP_SIZE + first;
+  backend_->Preallocate(static_cast<size_t>(MapPageId(run_begin)) * PAGE_SIZE, (last - first) * PAGE_SIZE);
+  return runs_.emplace(run_begin, PageRun{run_begin, static_cast<page_id_t>(run_begin + (last - first))}).first;
+}
+
+std::map<page_id_t, DiskManager::PageRun>::iterator DiskManager::FindRun(page_id_t page_id) {
+  auto it = runs_.upper_bound(page_id);
+  if (it == runs_.begin()) return runs_.end();
+  --it;
+  return page_id < it->second.next_ ? it : runs_.end();
+}
+
+void DiskManager::ReleaseRuns() {
+  auto runs = std::move(runs_);
+  runs_.clear();
+  for (auto &run : runs) {
+    for (page_id_t page_id = run.second.next_; page_id < run.second.end_; page_id++) {
+      DeAllocatePage(page_id);
+    }
+  }
+}
+
 /**
  * TODO: Student Implement
  */
 void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
+  if (read_only_) {
+    LOG(ERROR) << "Page de-allocation rejected, " << backend_->Name() << " is read-only";
+    return;
+  }
   uint32_t extent=logical_page_id/BITMAP_SIZE;
   uint32_t offset=logical_page_id%BITMAP_SIZE;
-  char page_data[PAGE_SIZE];
-  ReadPhysicalPage(1+extent*(BITMAP_SIZE+1),page_data);
-  BitmapPage<PAGE_SIZE>* bitmap=reinterpret_cast<BitmapPage<PAGE_SIZE>*>(page_data);
-  if(bitmap->DeAllocatePage(offset)){
-    DiskFileMetaPage* metaPage=reinterpret_cast<DiskFileMetaPage *>(this->meta_data_);//获得metaPage
+  DiskFileMetaPage* metaPage=reinterpret_cast<DiskFileMetaPage *>(this->meta_data_);//获得metaPage
+  if(extent<metaPage->num_extents_&&GetBitmap(extent)->DeAllocatePage(offset)){
     metaPage->num_allocated_pages_--;
     metaPage->extent_used_page_[extent]--;
-    if(extent==metaPage->num_extents_-1&&metaPage->extent_used_page_[extent]==0) metaPage->num_extents_--;
-    WritePhysicalPage(1+extent*(BITMAP_SIZE+1),reinterpret_cast<char*>(bitmap));
-    WritePhysicalPage(0,reinterpret_cast<char*>(metaPage));
+    // 末尾的空分区都去掉，Sync时文件随之截短
+    while (metaPage->num_extents_ > 0 && metaPage->extent_used_page_[metaPage->num_extents_ - 1] == 0) {
+      metaPage->num_extents_--;
+    }
+    free_extent_hint_ = std::min(free_extent_hint_, extent);
+    bitmap_dirty_[extent] = true;
+    meta_dirty_ = true;
   }
   else LOG(WARNING) << "DeAllocatePage warning: the page is free originally" << std::endl;
 }
@@ -111,12 +347,37 @@ void DiskManager::DeAllocatePage(page_id_t logical_page_id) {
  * TODO: Student Implement
  */
 bool DiskManager::IsPageFree(page_id_t logical_page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(db_io_latch_);
   uint32_t extent=logical_page_id/BITMAP_SIZE;
   uint32_t offset=logical_page_id%BITMAP_SIZE;
-  char page_data[PAGE_SIZE];
-  ReadPhysicalPage(1+extent*(BITMAP_SIZE+1),page_data);
-  BitmapPage<PAGE_SIZE>* bitmap=reinterpret_cast<BitmapPage<PAGE_SIZE>*>(page_data);
-  return bitmap->IsPageFree(offset);
+  if (extent >= reinterpret_cast<DiskFileMetaPage *>(meta_data_)->num_extents_) return true;
+  return GetBitmap(extent)->IsPageFree(offset);
+}
+
+BitmapPage<PAGE_SIZE> *DiskManager::GetBitmap(uint32_t extent) {
+  if (extent >= bitmaps_.size()) {
+    bitmaps_.resize(extent + 1);
+    bitmap_dirty_.resize(extent + 1, false);
+  }
+  if (bitmaps_[extent] == nullptr) {
+    bitmaps_[extent] = std::make_unique<BitmapPage<PAGE_SIZE>>();
+    ReadPhysicalPage(BitmapPageId(extent), reinterpret_cast<char *>(bitmaps_[extent].get()));
+  }
+  return bitmaps_[extent].get();
+}
+
+void DiskManager::WriteAllocatorMetadata() {
+  uint32_t num_extents = reinterpret_cast<DiskFileMetaPage *>(meta_data_)->num_extents_;
+  for (size_t extent = 0; extent < bitmaps_.size(); extent++) {
+    if (!bitmap_dirty_[extent]) continue;
+    bitmap_dirty_[extent] = false;
+    if (extent >= num_extents) continue;  // 分区已经去掉，位图会被截掉
+    WritePhysicalPage(BitmapPageId(extent), reinterpret_cast<char *>(bitmaps_[extent].get()));
+  }
+  if (meta_dirty_) {
+    WritePhysicalPage(META_PAGE_ID, meta_data_);
+    meta_dirty_ = false;
+  }
 }
 
 /**
@@ -127,45 +388,61 @@ page_id_t DiskManager::MapPageId(page_id_t logical_page_id) {
   return logical_page_id+1+extent+1;
 }
 
-int DiskManager::GetFileSize(const std::string &file_name) {
-  struct stat stat_buf;
-  int rc = stat(file_name.c_str(), &stat_buf);
-  return rc == 0 ? stat_buf.st_size : -1;
+void DiskManager::TruncateFile() {
+  DiskFileMetaPage *meta_page = reinterpret_cast<DiskFileMetaPage *>(meta_data_);
+  size_t end = PAGE_SIZE;  // 没有分区时只剩meta page
+  if (meta_page->num_extents_ > 0) {
+    uint32_t extent = meta_page->num_extents_ - 1;
+    uint32_t allocated_end = GetBitmap(extent)->FindAllocatedEnd();
+    end = static_cast<size_t>(MapPageId(extent * BITMAP_SIZE + allocated_end)) * PAGE_SIZE;
+  }
+  // 预分配可能让文件比缓存的大小更长，以实际大小为准
+  if (backend_->Size() <= end || !backend_->Truncate(end)) return;
+  file_size_.store(end);
+}
+
+void DiskManager::UpdateFileSize(size_t end) {
+  size_t file_size = file_size_.load();
+  while (file_size < end && !file_size_.compare_exchange_weak(file_size, end)) {
+  }
 }
 
 void DiskManager::ReadPhysicalPage(page_id_t physical_page_id, char *page_data) {
-  int offset = physical_page_id * PAGE_SIZE;
-  // check if read beyond file length
-  if (offset >= GetFileSize(file_name_)) {
-#ifdef ENABLE_BPM_DEBUG
-    LOG(INFO) << "Read less than a page" << std::endl;
-#endif
-    memset(page_data, 0, PAGE_SIZE);
-  } else {
-    // set read cursor to offset
-    db_io_.seekp(offset);
-    db_io_.read(page_data, PAGE_SIZE);
-    // if file ends before reading PAGE_SIZE
-    int read_count = db_io_.gcount();
-    if (read_count < PAGE_SIZE) {
-#ifdef ENABLE_BPM_DEBUG
-      LOG(INFO) << "Read less than a page" << std::endl;
-#endif
-      memset(page_data + read_count, 0, PAGE_SIZE - read_count);
+  ReadPhysicalPages(physical_page_id, 1, page_data);
+}
+
+void DiskManager::ReadPhysicalPages(page_id_t physical_page_id, size_t count, char *page_data) {
+  size_t size = count * PAGE_SIZE;
+  size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
+  size_t read_count = 0;
+  if (offset >= file_size_.load()) {
+    // 文件末尾之后的页全是0，不用读
+  } else if (reinterpret_cast<uintptr_t>(page_data) % backend_->Alignment() != 0) {
+    // O_DIRECT要求缓冲区对齐，逐页经过对齐的缓冲区
+    alignas(DIRECT_IO_ALIGNMENT) char bounce[PAGE_SIZE];
+    for (size_t i = 0; i < count; i++) {
+      size_t n = backend_->Read(bounce, PAGE_SIZE, offset + i * PAGE_SIZE);
+      memcpy(page_data + i * PAGE_SIZE, bounce, n);
+      read_count += n;
+      if (n < PAGE_SIZE) break;
     }
+  } else {
+    read_count = backend_->Read(page_data, size, offset);
   }
+  // the part beyond the end of the file reads as zeros
+  memset(page_data + read_count, 0, size - read_count);
 }
 
 void DiskManager::WritePhysicalPage(page_id_t physical_page_id, const char *page_data) {
   size_t offset = static_cast<size_t>(physical_page_id) * PAGE_SIZE;
-  // set write cursor to offset
-  db_io_.seekp(offset);
-  db_io_.write(page_data, PAGE_SIZE);
-  // check for I/O error
-  if (db_io_.bad()) {
+  alignas(DIRECT_IO_ALIGNMENT) char bounce[PAGE_SIZE];
+  if (reinterpret_cast<uintptr_t>(page_data) % backend_->Alignment() != 0) {
+    memcpy(bounce, page_data, PAGE_SIZE);
+    page_data = bounce;
+  }
+  if (!backend_->Write(page_data, PAGE_SIZE, offset)) {
     LOG(ERROR) << "I/O error while writing";
     return;
   }
-  // needs to flush to keep disk file in sync
-  db_io_.flush();
-}
\ No newline at end of file
+  UpdateFileSize(offset + PAGE_SIZE);
+}
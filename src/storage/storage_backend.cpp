@@ -0,0 +1,452 @@
+#include "storage/storage_backend.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include "common/lz_codec.h"
+#include "glog/logging.h"
+
+void StorageBackend::Execute(std::vector<IORequest> *requests) {
+  for (auto &request : *requests) {
+    size_t done = 0;
+    bool failed = false;
+    // 向量请求的缓冲区在存储上首尾相连
+    size_t count = request.iov_ != nullptr ? request.iovcnt_ : 1;
+    for (size_t i = 0; i < count && !failed; i++) {
+      char *buf = request.iov_ != nullptr ? static_cast<char *>(request.iov_[i].iov_base) : request.buf_;
+      size_t size = request.iov_ != nullptr ? request.iov_[i].iov_len : request.size_;
+      if (request.write_) {
+        failed = !Write(buf, size, request.offset_ + done);
+        if (!failed) done += size;
+      } else {
+        size_t n = Read(buf, size, request.offset_ + done);
+        done += n;
+        if (n < size) break;
+      }
+    }
+    request.result_ = failed ? -EIO : static_cast<ssize_t>(done);
+  }
+}
+
+/**
+ * Read up to size bytes at offset, retrying short reads.
+ * @return the number of bytes read, less than size at the end of the file
+ */
+static size_t PRead(int fd, char *buf, size_t size, size_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = pread(fd, buf + done, size - done, static_cast<off_t>(offset + done));
+    if (n < 0 && errno == EINTR) continue;
+    if (n < 0) LOG(ERROR) << "I/O error while reading";
+    if (n <= 0) break;
+    done += n;
+  }
+  return done;
+}
+
+/**
+ * Write size bytes at offset, retrying short writes.
+ * @return false on an I/O error
+ */
+static bool PWrite(int fd, const char *buf, size_t size, size_t offset) {
+  size_t done = 0;
+  while (done < size) {
+    ssize_t n = pwrite(fd, buf + done, size - done, static_cast<off_t>(offset + done));
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    done += n;
+  }
+  return true;
+}
+
+FileBackend::FileBackend(const std::string &file_name, bool direct_io, bool read_only)
+    : file_name_(file_name), read_only_(read_only) {
+  // directory or file does not exist
+  std::filesystem::path p = file_name;
+  if (p.has_parent_path() && !read_only) std::filesystem::create_directories(p.parent_path());
+  fd_ = read_only ? open(file_name.c_str(), O_RDONLY) : open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    throw std::runtime_error("can not open " + file_name + ": " + strerror(errno));
+  }
+  if (direct_io && !read_only) {
+    direct_fd_ = open(file_name.c_str(), O_RDWR | O_DIRECT);
+    if (direct_fd_ < 0) {
+      LOG(WARNING) << "O_DIRECT is not supported for " << file_name << ", using buffered I/O" << std::endl;
+    }
+  }
+}
+
+FileBackend::~FileBackend() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_size_);
+  if (direct_fd_ >= 0) close(direct_fd_);
+  close(fd_);
+}
+
+size_t FileBackend::Read(char *buf, size_t size, size_t offset) { return PRead(IOFd(), buf, size, offset); }
+
+bool FileBackend::Write(const char *buf, size_t size, size_t offset) { return PWrite(IOFd(), buf, size, offset); }
+
+void FileBackend::Execute(std::vector<IORequest> *requests) {
+  if (requests->empty()) return;
+  std::call_once(async_io_once_, [&] { async_io_ = AsyncIO::Create(); });
+  for (auto &request : *requests) {
+    request.fd_ = IOFd();
+  }
+  async_io_->Execute(requests);
+}
+
+bool FileBackend::Sync() { return fdatasync(fd_) == 0; }
+
+size_t FileBackend::Size() {
+  struct stat stat_buf;
+  return fstat(fd_, &stat_buf) == 0 ? stat_buf.st_size : 0;
+}
+
+bool FileBackend::Truncate(size_t size) {
+  if (ftruncate(fd_, size) == 0) return true;
+  LOG(WARNING) << "ftruncate failed: " << strerror(errno);
+  return false;
+}
+
+void FileBackend::Preallocate(size_t offset, size_t size) {
+  // 预先分配磁盘空间，文件系统就能把这一段放在一起；不支持也没关系
+  if (fallocate(fd_, 0, offset, size) != 0 && errno != EOPNOTSUPP) {
+    LOG(WARNING) << "fallocate failed: " << strerror(errno);
+  }
+}
+
+const char *FileBackend::Map() {
+  if (!read_only_) return nullptr;  // 可写的文件会变长，不映射
+  std::call_once(map_once_, [&] {
+    mapping_size_ = Size();
+    if (mapping_size_ == 0) return;
+    void *mapping = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+      LOG(ERROR) << "can not map " << file_name_ << ": " << strerror(errno);
+      mapping_size_ = 0;
+      return;
+    }
+    mapping_ = static_cast<char *>(mapping);
+  });
+  return mapping_;
+}
+
+size_t MemoryBackend::Read(char *buf, size_t size, size_t offset) {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  if (offset >= data_.size()) return 0;
+  size_t n = std::min(size, data_.size() - offset);
+  memcpy(buf, data_.data() + offset, n);
+  return n;
+}
+
+bool MemoryBackend::Write(const char *buf, size_t size, size_t offset) {
+  {
+    std::shared_lock<std::shared_mutex> lock(latch_);
+    if (offset + size <= data_.size()) {
+      memcpy(data_.data() + offset, buf, size);
+      return true;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(latch_);
+  if (offset + size > data_.size()) data_.resize(offset + size);
+  memcpy(data_.data() + offset, buf, size);
+  return true;
+}
+
+size_t MemoryBackend::Size() {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  return data_.size();
+}
+
+bool MemoryBackend::Truncate(size_t size) {
+  std::unique_lock<std::shared_mutex> lock(latch_);
+  data_.resize(size);
+  data_.shrink_to_fit();
+  return true;
+}
+
+/** @return the time the channel needs for size bytes */
+static std::chrono::nanoseconds TransferTime(size_t size, size_t bandwidth) {
+  if (bandwidth == 0) return std::chrono::nanoseconds(0);
+  return std::chrono::nanoseconds(static_cast<int64_t>(size * 1e9 / bandwidth));
+}
+
+std::chrono::steady_clock::time_point ThrottledBackend::Schedule(std::chrono::nanoseconds transfer,
+                                                                 std::chrono::nanoseconds latency) {
+  auto now = std::chrono::steady_clock::now();
+  std::scoped_lock<std::mutex> lock(latch_);
+  channel_free_ = std::max(channel_free_, now) + transfer;
+  return channel_free_ + latency;
+}
+
+size_t ThrottledBackend::Read(char *buf, size_t size, size_t offset) {
+  auto done = Schedule(TransferTime(size, options_.read_bandwidth_), options_.read_latency_);
+  size_t n = backend_->Read(buf, size, offset);
+  std::this_thread::sleep_until(done);
+  return n;
+}
+
+bool ThrottledBackend::Write(const char *buf, size_t size, size_t offset) {
+  auto done = Schedule(TransferTime(size, options_.write_bandwidth_), options_.write_latency_);
+  bool res = backend_->Write(buf, size, offset);
+  std::this_thread::sleep_until(done);
+  return res;
+}
+
+void ThrottledBackend::Execute(std::vector<IORequest> *requests) {
+  if (requests->empty()) return;
+  std::chrono::nanoseconds transfer(0);
+  std::chrono::microseconds latency(0);
+  for (auto &request : *requests) {
+    if (request.write_) {
+      transfer += TransferTime(request.size_, options_.write_bandwidth_);
+      latency = std::max(latency, options_.write_latency_);
+    } else {
+      transfer += TransferTime(request.size_, options_.read_bandwidth_);
+      latency = std::max(latency, options_.read_latency_);
+    }
+  }
+  // 一批请求每次有queue_depth个同时在途，等待时间只算轮数
+  size_t queue_depth = std::max<size_t>(options_.queue_depth_, 1);
+  size_t rounds = (requests->size() + queue_depth - 1) / queue_depth;
+  auto done = Schedule(transfer, latency * rounds);
+  backend_->Execute(requests);
+  std::this_thread::sleep_until(done);
+}
+
+bool ThrottledBackend::Sync() {
+  auto done = Schedule(std::chrono::nanoseconds(0), options_.sync_latency_);
+  bool res = backend_->Sync();
+  std::this_thread::sleep_until(done);
+  return res;
+}
+
+CompressedBackend::CompressedBackend(std::unique_ptr<StorageBackend> backend) : backend_(std::move(backend)) {
+  if (backend_->Size() == 0) return;
+  Header header;
+  if (backend_->Read(reinterpret_cast<char *>(&header), sizeof(header), 0) != sizeof(header) ||
+      header.magic_ != MAGIC) {
+    throw std::runtime_error(std::string(Name()) + " does not hold compressed pages");
+  }
+  if (header.page_size_ != PAGE_SIZE || header.slot_size_ != SLOT_SIZE) {
+    throw std::runtime_error(std::string(Name()) + " was compressed with " + std::to_string(header.page_size_) +
+                             "-byte pages");
+  }
+  entries_.resize(header.num_pages_);
+  size_t table_size = entries_.size() * sizeof(Entry);
+  if (backend_->Read(reinterpret_cast<char *>(entries_.data()), table_size,
+                     static_cast<size_t>(header.table_slot_) * SLOT_SIZE) != table_size) {
+    throw std::runtime_error(std::string(Name()) + " has a truncated page table");
+  }
+  table_ = {header.table_slot_, static_cast<uint32_t>(table_size)};
+  // 没有被头、页表和页引用的槽都是空闲的
+  std::vector<std::pair<uint32_t, uint32_t>> used = {{0, 1}, {table_.slot_, SlotCount(table_.size_)}};
+  for (auto &entry : entries_) {
+    if (entry.size_ > 0) used.emplace_back(entry.slot_, SlotCount(entry.size_));
+  }
+  std::sort(used.begin(), used.end());
+  end_slot_ = 0;
+  for (auto &run : used) {
+    if (run.first > end_slot_) free_.emplace(end_slot_, run.first - end_slot_);
+    end_slot_ = std::max(end_slot_, run.first + run.second);
+  }
+}
+
+bool CompressedBackend::IsCompressed(StorageBackend *backend) {
+  uint64_t magic = 0;
+  return backend->Read(reinterpret_cast<char *>(&magic), sizeof(magic), 0) == sizeof(magic) && magic == MAGIC;
+}
+
+uint32_t CompressedBackend::Encode(const char *page, char *out) {
+  static const char zero_page[PAGE_SIZE] = {0};
+  if (memcmp(page, zero_page, PAGE_SIZE) == 0) return 0;
+  // 至少省下一个槽才值得压缩
+  size_t size = LZCodec::Compress(page, PAGE_SIZE, out, PAGE_SIZE - SLOT_SIZE);
+  if (size > 0) return size;
+  memcpy(out, page, PAGE_SIZE);
+  return PAGE_SIZE;
+}
+
+bool CompressedBackend::ReadPage(size_t page_no, char *page_data) {
+  const Entry &entry = entries_[page_no];
+  size_t offset = static_cast<size_t>(entry.slot_) * SLOT_SIZE;
+  if (entry.size_ == 0) {
+    memset(page_data, 0, PAGE_SIZE);
+    return true;
+  }
+  if (entry.size_ == PAGE_SIZE) return backend_->Read(page_data, PAGE_SIZE, offset) == PAGE_SIZE;
+  char compressed[PAGE_SIZE];
+  if (backend_->Read(compressed, entry.size_, offset) == entry.size_ &&
+      LZCodec::Decompress(compressed, entry.size_, page_data, PAGE_SIZE) == PAGE_SIZE) {
+    return true;
+  }
+  LOG(ERROR) << "Compressed page " << page_no << " of " << Name() << " is corrupt";
+  return false;
+}
+
+size_t CompressedBackend::Read(char *buf, size_t size, size_t offset) {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  size_t done = 0;
+  char page_data[PAGE_SIZE];
+  while (done < size) {
+    size_t page_no = (offset + done) / PAGE_SIZE;
+    size_t page_offset = (offset + done) % PAGE_SIZE;
+    size_t n = std::min(size - done, PAGE_SIZE - page_offset);
+    if (page_no >= entries_.size()) break;
+    // 整页直接解压到调用者的缓冲区
+    char *dst = n == PAGE_SIZE ? buf + done : page_data;
+    if (!ReadPage(page_no, dst)) break;
+    if (dst == page_data) memcpy(buf + done, page_data + page_offset, n);
+    done += n;
+  }
+  return done;
+}
+
+bool CompressedBackend::Write(const char *buf, size_t size, size_t offset) {
+  size_t done = 0;
+  char page_data[PAGE_SIZE];
+  char encoded[PAGE_SIZE];
+  while (done < size) {
+    size_t page_no = (offset + done) / PAGE_SIZE;
+    size_t page_offset = (offset + done) % PAGE_SIZE;
+    size_t n = std::min(size - done, PAGE_SIZE - page_offset);
+    if (n == PAGE_SIZE) {
+      uint32_t encoded_size = Encode(buf + done, encoded);
+      std::unique_lock<std::shared_mutex> lock(latch_);
+      if (!StorePage(page_no, encoded, encoded_size)) return false;
+    } else {
+      // 不足一页时读出整页再改，整个过程都持有latch_
+      std::unique_lock<std::shared_mutex> lock(latch_);
+      if (page_no < entries_.size()) {
+        if (!ReadPage(page_no, page_data)) return false;
+      } else {
+        memset(page_data, 0, PAGE_SIZE);
+      }
+      memcpy(page_data + page_offset, buf + done, n);
+      if (!StorePage(page_no, encoded, Encode(page_data, encoded))) return false;
+    }
+    done += n;
+  }
+  return true;
+}
+
+bool CompressedBackend::StorePage(size_t page_no, const char *data, uint32_t size) {
+  if (page_no >= entries_.size()) entries_.resize(page_no + 1);
+  Entry &entry = entries_[page_no];
+  // 总是写到新的槽里，磁盘上的页表指向的旧槽和旧长度在下次Sync之前都保持有效
+  uint32_t new_slots = SlotCount(size);
+  uint32_t slot = 0;
+  if (new_slots > 0) {
+    slot = AllocateSlots(new_slots);
+    if (!backend_->Write(data, size, static_cast<size_t>(slot) * SLOT_SIZE)) {
+      FreeSlots(slot, new_slots);
+      return false;
+    }
+  }
+  if (!unsynced_pages_.insert(page_no).second) {
+    // 旧槽是上次Sync之后才分的，磁盘上的页表不会指向它
+    if (entry.size_ > 0) FreeSlots(entry.slot_, SlotCount(entry.size_));
+  } else {
+    ReleaseSlots(entry.slot_, SlotCount(entry.size_));
+  }
+  entry = {slot, size};
+  return true;
+}
+
+uint32_t CompressedBackend::AllocateSlots(uint32_t count) {
+  for (auto it = free_.begin(); it != free_.end(); ++it) {
+    if (it->second < count) continue;
+    uint32_t slot = it->first;
+    if (it->second > count) free_.emplace(slot + count, it->second - count);
+    free_.erase(it);
+    return slot;
+  }
+  uint32_t slot = end_slot_;
+  end_slot_ += count;
+  return slot;
+}
+
+void CompressedBackend::FreeSlots(uint32_t slot, uint32_t count) {
+  auto next = free_.lower_bound(slot);
+  if (next != free_.end() && slot + count == next->first) {
+    count += next->second;
+    next = free_.erase(next);
+  }
+  if (next != free_.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == slot) {
+      prev->second += count;
+      return;
+    }
+  }
+  free_.emplace(slot, count);
+}
+
+bool CompressedBackend::Sync() {
+  std::unique_lock<std::shared_mutex> lock(latch_);
+  // 新页表写进空闲的槽，页表与页数据落盘后才让文件头指向它
+  uint32_t table_size = entries_.size() * sizeof(Entry);
+  uint32_t table_slots = SlotCount(table_size);
+  uint32_t table_slot = table_slots > 0 ? AllocateSlots(table_slots) : 0;
+  Header header{MAGIC, PAGE_SIZE, SLOT_SIZE, table_slot, static_cast<uint32_t>(entries_.size())};
+  if (!backend_->Write(reinterpret_cast<const char *>(entries_.data()), table_size,
+                       static_cast<size_t>(table_slot) * SLOT_SIZE) ||
+      !backend_->Sync() || !backend_->Write(reinterpret_cast<const char *>(&header), sizeof(header), 0) ||
+      !backend_->Sync()) {
+    if (table_slots > 0) FreeSlots(table_slot, table_slots);
+    return false;
+  }
+  ReleaseSlots(table_.slot_, SlotCount(table_.size_));
+  table_ = {table_slot, table_size};
+  for (auto &run : pending_free_) {
+    FreeSlots(run.first, run.second);
+  }
+  pending_free_.clear();
+  unsynced_pages_.clear();
+  // 末尾的空闲槽不再占用存储
+  if (!free_.empty()) {
+    auto last = std::prev(free_.end());
+    if (last->first + last->second == end_slot_) {
+      end_slot_ = last->first;
+      free_.erase(last);
+    }
+  }
+  if (backend_->Size() > static_cast<size_t>(end_slot_) * SLOT_SIZE) {
+    backend_->Truncate(static_cast<size_t>(end_slot_) * SLOT_SIZE);
+  }
+  return true;
+}
+
+size_t CompressedBackend::Size() {
+  std::shared_lock<std::shared_mutex> lock(latch_);
+  return entries_.size() * PAGE_SIZE;
+}
+
+bool CompressedBackend::Truncate(size_t size) {
+  std::unique_lock<std::shared_mutex> lock(latch_);
+  size_t num_pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+  for (size_t i = num_pages; i < entries_.size(); i++) {
+    ReleaseSlots(entries_[i].slot_, SlotCount(entries_[i].size_));
+    unsynced_pages_.erase(i);
+  }
+  if (num_pages < entries_.size()) entries_.resize(num_pages);
+  return true;
+}
+
+const char *CompressedBackend::Map() {
+  std::call_once(map_once_, [&] {
+    // 读不出的页保持为0
+    mapping_.resize(Size());
+    Read(mapping_.data(), mapping_.size(), 0);
+  });
+  return mapping_.empty() ? nullptr : mapping_.data();
+}
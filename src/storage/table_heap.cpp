@@ -1,45 +1,105 @@
 #include "storage/table_heap.h"
 
+#include <algorithm>
+
 /**
  * TODO: Student Implement
  */
 bool TableHeap::InsertTuple(Row &row, Transaction *txn) {
   //If the tuple is too large (>= page_size), return false.
-  if(row.GetSerializedSize(this->schema_)>TablePage::SIZE_MAX_ROW) return false;
-  auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(this->first_page_id_));
-  page_id_t next_page_id;
-  while(1) {
+  uint32_t size=row.GetSerializedSize(this->schema_);
+  if(size>TablePage::SIZE_MAX_ROW) return false;
+  if(buffer_pool_manager_->IsReadOnly()) return false;//只读数据库
+  std::unique_lock<std::mutex> lock(fsm_latch_);
+  LoadFreeSpaceMap();
+  //空闲空间表里找一页放得下的，放不下说明表里记的旧了，更新后再找
+  for(page_id_t page_id=FindPageWithSpace(size);page_id!=INVALID_PAGE_ID;page_id=FindPageWithSpace(size)){
+    lock.unlock();
+    auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(page_id));
     if (page == nullptr) return false;  // If the page could not be found, then abort the transaction.
     page->WLatch();
-    if(page->InsertTuple(row,this->schema_,txn,this->lock_manager_,this->log_manager_)){
-      page->WUnlatch();
-      this->buffer_pool_manager_->UnpinPage(page->GetTablePageId(),true);
-      return true;
-    };
+    bool inserted=page->InsertTuple(row,this->schema_,txn,this->lock_manager_,this->log_manager_);
+    uint32_t free_space=page->GetFreeSpaceForInsert();
     page->WUnlatch();
-    page_id_t page_id=page->GetPageId();
-    next_page_id= page->GetNextPageId();
-    if(next_page_id==INVALID_PAGE_ID){//说明是最后的page
-      break;
-    }else page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(next_page_id));
-    this->buffer_pool_manager_->UnpinPage(page_id,true);//失败也要Unpin，因为Fetch成功就会Pin
-  }
-  auto new_page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->NewPage(next_page_id));
-  if(new_page==nullptr) return false;//申请不到
+    this->buffer_pool_manager_->UnpinPage(page_id,inserted);
+    UpdateFreeSpace(page_id,free_space);
+    if(inserted) return true;
+    lock.lock();
+  }
+  //都放不下，在链尾加一页；持有fsm_latch_，不会有两个线程同时加页
+  auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(last_page_id_));
+  if(page==nullptr) return false;
+  //新页尽量紧跟在最后一页后面，顺序扫描时就是连续读
+  page_id_t next_page_id;
+  auto new_page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->NewPage(next_page_id,last_page_id_));
+  if(new_page==nullptr){//申请不到
+    this->buffer_pool_manager_->UnpinPage(last_page_id_,false);
+    return false;
+  }
   new_page->WLatch();
-  new_page->Init(next_page_id,page->GetPageId(),this->log_manager_,txn);
+  new_page->Init(next_page_id,last_page_id_,this->log_manager_,txn);
   new_page->InsertTuple(row,this->schema_,txn,this->lock_manager_,log_manager_);
+  uint32_t free_space=new_page->GetFreeSpaceForInsert();
   new_page->WUnlatch();
   this->buffer_pool_manager_->UnpinPage(next_page_id,true);
   page->WLatch();
   page->SetNextPageId(next_page_id);
   page->WUnlatch();
-  this->buffer_pool_manager_->UnpinPage(page->GetPageId(),true);
+  this->buffer_pool_manager_->UnpinPage(last_page_id_,true);
+  AppendToFreeSpaceMap(next_page_id,free_space);
   return true;
 
 }
 
+size_t TableHeap::BulkInsert(std::vector<Row> &rows, Transaction *txn) {
+  if (rows.empty() || buffer_pool_manager_->IsReadOnly()) return 0;
+  // 整批插完才放开fsm_latch_，别的插入不会往这几页里插，也不会同时在链尾加页
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  LoadFreeSpaceMap();
+  page_id_t page_id = last_page_id_;
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) return 0;
+  page->WLatch();
+  bool is_new = false;  // 当前页是这一批新加的，还不在空闲空间表里
+  bool dirty = false;
+  // 当前页写完了，记下它剩的空间
+  auto finish_page = [&] {
+    uint32_t free_space = page->GetFreeSpaceForInsert();
+    page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, dirty);
+    if (is_new) {
+      AppendToFreeSpaceMap(page_id, free_space);
+    } else {
+      SetFreeSpace(page_id, free_space);
+    }
+  };
+  size_t inserted = 0;
+  while (inserted < rows.size()) {
+    if (rows[inserted].GetSerializedSize(schema_) > TablePage::SIZE_MAX_ROW) break;
+    if (page->InsertTuple(rows[inserted], schema_, txn, lock_manager_, log_manager_)) {
+      inserted++;
+      dirty = true;
+      continue;
+    }
+    // 这一页满了，紧跟在后面接一页新的
+    page_id_t next_page_id;
+    auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(next_page_id, page_id));
+    if (new_page == nullptr) break;
+    new_page->WLatch();
+    new_page->Init(next_page_id, page_id, log_manager_, txn);
+    page->SetNextPageId(next_page_id);
+    dirty = true;
+    finish_page();
+    page = new_page;
+    page_id = next_page_id;
+    is_new = true;
+  }
+  finish_page();
+  return inserted;
+}
+
 bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
+  if (buffer_pool_manager_->IsReadOnly()) return false;
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   // If the page could not be found, then abort the transaction.
@@ -58,18 +118,21 @@ bool TableHeap::MarkDelete(const RowId &rid, Transaction *txn) {
  * TODO: Student Implement
  */
 bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Transaction *txn) {
+  if(buffer_pool_manager_->IsReadOnly()) return false;//只读数据库
   auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(rid.GetPageId()));
   if(page== nullptr) return false;//没找到
   Row old_row(rid);
   if(this->GetTuple(&old_row,txn)){
     page->WLatch();
     int type=page->UpdateTuple(row,&old_row,schema_,txn,lock_manager_,log_manager_);
+    uint32_t free_space=page->GetFreeSpaceForInsert();
     page->WUnlatch();
     switch(type){
       case 1:
       case 2:break;
       case 0:
         this->buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+        UpdateFreeSpace(rid.GetPageId(),free_space);
         row.SetRowId(rid);//设置rowid
         return true;
       case 3:
@@ -94,8 +157,11 @@ void TableHeap::ApplyDelete(const RowId &rid, Transaction *txn) {
   // Step2: Delete the tuple from the page.
   page->WLatch();
   page->ApplyDelete(rid,txn,log_manager_);
+  uint32_t free_space=page->GetFreeSpaceForInsert();
   page->WUnlatch();
   this->buffer_pool_manager_->UnpinPage(page->GetPageId(),true);
+  // Step3: Record the space it freed.
+  UpdateFreeSpace(rid.GetPageId(),free_space);
 }
 
 void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
@@ -112,8 +178,8 @@ void TableHeap::RollbackDelete(const RowId &rid, Transaction *txn) {
 /**
  * TODO: Student Implement
  */
-bool TableHeap::GetTuple(Row *row, Transaction *txn) {
-  auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
+bool TableHeap::GetTuple(Row *row, Transaction *txn, BufferRing *ring) {
+  auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId(),ring));
   if(page==nullptr) return false;
   page->RLatch();
   if(page->GetTuple(row,schema_,txn,lock_manager_)){
@@ -126,29 +192,306 @@ bool TableHeap::GetTuple(Row *row, Transaction *txn) {
   return false;
 }
 
+page_id_t TableHeap::ScanPage(page_id_t page_id, const std::function<void(const RowView &view)> &visit,
+                              BufferRing *ring, ReadAheadTracker *read_ahead) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, ring));
+  ASSERT(page != nullptr, "Can not fetch the table page to scan.");  // 不能当作链尾，否则扫描结果会被截断
+  RowView view;  // 整页共用一个视图，解码过的字段偏移也复用
+  page->RLatch();
+  page->VisitTuples(schema_, &view, visit);
+  page_id_t next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  if (read_ahead != nullptr) {  // 顺序读时预读后面的页
+    read_ahead->OnNextPage(buffer_pool_manager_, page_id,
+                           [](Page *page) { return reinterpret_cast<TablePage *>(page)->GetNextPageId(); });
+  }
+  return next_page_id;
+}
+
 void TableHeap::DeleteTable(page_id_t page_id) {
-  if (page_id != INVALID_PAGE_ID) {
-    auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));  // 删除table_heap
-    if (temp_table_page->GetNextPageId() != INVALID_PAGE_ID)
-      DeleteTable(temp_table_page->GetNextPageId());
+  if (page_id == INVALID_PAGE_ID) page_id = first_page_id_;
+  bool delete_map = page_id == first_page_id_;
+  BufferRing ring;  // 删除table_heap只需读一遍每页
+  while (page_id != INVALID_PAGE_ID) {
+    auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, &ring));
+    auto next_page_id = temp_table_page->GetNextPageId();
     buffer_pool_manager_->UnpinPage(page_id, false);
     buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+  if (delete_map) DeleteFreeSpaceMap();
+}
+
+size_t TableHeap::Vacuum(Transaction *txn, const std::function<void(const Row &, const RowId &)> &on_move) {
+  if (buffer_pool_manager_->IsReadOnly()) return 0;
+  // 整个整理过程持有fsm_latch_，插入不会往正在搬的页里插，也不会同时在链尾加页
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  std::vector<page_id_t> page_ids;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) return 0;
+    page_ids.push_back(page_id);
+    page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_ids.back(), false);
+  }
+  if (page_ids.empty()) return 0;
+  // 从链尾往前搬，搬到链头第一个放得下的页，两边相遇就停
+  size_t dst = 0;
+  size_t src = page_ids.size() - 1;
+  bool stuck = false;  // 有元组搬不走，src页不能释放
+  while (dst < src && !stuck) {
+    auto src_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_ids[src]));
+    if (src_page == nullptr) break;
+    bool moved = false;
+    RowId old_rid;
+    while (!stuck) {
+      Row row;
+      src_page->RLatch();
+      bool found = src_page->GetFirstTupleRid(&old_rid);
+      if (found) {
+        row.SetRowId(old_rid);
+        src_page->GetTuple(&row, schema_, txn, lock_manager_);
+      }
+      src_page->RUnlatch();
+      if (!found) break;
+      bool inserted = false;
+      while (dst < src && !inserted) {
+        auto dst_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_ids[dst]));
+        if (dst_page == nullptr) break;
+        dst_page->WLatch();
+        inserted = dst_page->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+        dst_page->WUnlatch();
+        buffer_pool_manager_->UnpinPage(page_ids[dst], inserted);
+        if (!inserted) dst++;
+      }
+      if (!inserted) {
+        stuck = true;
+        break;
+      }
+      src_page->WLatch();
+      src_page->ApplyDelete(old_rid, txn, log_manager_);
+      src_page->WUnlatch();
+      moved = true;
+      on_move(row, old_rid);
+    }
+    // 打了删除标记还没提交的元组不能搬，这一页不能释放
+    src_page->RLatch();
+    if (!src_page->IsEmpty()) stuck = true;
+    src_page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_ids[src], moved);
+    if (!stuck && dst < src) src--;
+  }
+  // src之后的页都空了，从链上摘下来释放
+  size_t freed = 0;
+  auto last_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_ids[src]));
+  if (src + 1 < page_ids.size() && last_page != nullptr) {
+    last_page->WLatch();
+    last_page->SetNextPageId(INVALID_PAGE_ID);
+    last_page->WUnlatch();
+    for (size_t i = src + 1; i < page_ids.size(); i++) {
+      buffer_pool_manager_->DeletePage(page_ids[i]);
+    }
+    freed = page_ids.size() - src - 1;
+  }
+  if (last_page != nullptr) buffer_pool_manager_->UnpinPage(page_ids[src], freed > 0);
+  // 每页的空闲空间都变了，重建空闲空间表
+  BuildFreeSpaceMap();
+  return freed;
+}
+
+page_id_t TableHeap::GetFreeSpaceMapPageId() {
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  LoadFreeSpaceMap();
+  return fsm_page_id_;
+}
+
+void TableHeap::LoadFreeSpaceMap() {
+  if (fsm_loaded_) return;
+  if (fsm_page_id_ == INVALID_PAGE_ID) {
+    if (!buffer_pool_manager_->IsReadOnly()) BuildFreeSpaceMap();
+    return;
+  }
+  fsm_loaded_ = true;
+  last_page_id_ = first_page_id_;
+  for (page_id_t page_id = fsm_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) break;
+    page->SetPageClass(PageClass::kMeta);
+    auto map_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    for (uint32_t i = 0; i < map_page->GetCount(); i++) {
+      fsm_entries_[map_page->GetPageId(i)] = fsm_pages_.size() * FreeSpaceMapPage::CAPACITY + i;
+      last_page_id_ = map_page->GetPageId(i);
+    }
+    fsm_pages_.push_back(page_id);
+    fsm_max_categories_.push_back(map_page->GetMaxCategory());
+    page_id = map_page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(fsm_pages_.back(), false);
+  }
+  // 表里最后一页不一定是链尾：加页之后表还没写回就崩溃的话，后面几页不在表里。顺着链找到链尾，把这些页补进表里
+  if (buffer_pool_manager_->IsPageFree(last_page_id_)) last_page_id_ = first_page_id_;
+  for (page_id_t page_id = last_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) break;
+    page->RLatch();
+    page_id_t next_page_id = page->GetNextPageId();
+    uint32_t free_space = page->GetFreeSpaceForInsert();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (fsm_entries_.find(page_id) == fsm_entries_.end() && !buffer_pool_manager_->IsReadOnly()) {
+      AppendToFreeSpaceMap(page_id, free_space);
+    }
+    last_page_id_ = page_id;
+    page_id = next_page_id;
+  }
+}
+
+void TableHeap::RebuildFreeSpaceMap() {
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  BuildFreeSpaceMap();
+}
+
+void TableHeap::BuildFreeSpaceMap() {
+  // 沿着链读出每页的空闲空间
+  std::vector<std::pair<page_id_t, uint32_t>> free_spaces;
+  BufferRing ring;
+  for (page_id_t page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id, &ring));
+    if (page == nullptr) break;
+    page->RLatch();
+    free_spaces.emplace_back(page_id, page->GetFreeSpaceForInsert());
+    page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(free_spaces.back().first, false);
+  }
+  // 第一页的id记在表的元数据里，保留它，其余的页释放后重新分配
+  std::vector<page_id_t> old_pages = GetFreeSpaceMapPages();
+  fsm_loaded_ = true;
+  fsm_pages_.clear();
+  fsm_max_categories_.clear();
+  fsm_entries_.clear();
+  last_page_id_ = first_page_id_;
+  for (size_t i = 1; i < old_pages.size(); i++) {
+    buffer_pool_manager_->DeletePage(old_pages[i]);
+  }
+  auto page = old_pages.empty() ? nullptr : buffer_pool_manager_->FetchPage(old_pages[0]);
+  if (page != nullptr) {
+    reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->Init();
+    buffer_pool_manager_->UnpinPage(old_pages[0], true);
+    fsm_pages_.push_back(old_pages[0]);
+    fsm_max_categories_.push_back(0);
+  }
+  for (auto &page_free_space : free_spaces) {
+    if (!AppendToFreeSpaceMap(page_free_space.first, page_free_space.second)) break;
+  }
+}
+
+bool TableHeap::AppendToFreeSpaceMap(page_id_t page_id, uint32_t free_space) {
+  Page *page = nullptr;
+  size_t position = fsm_entries_.size();
+  if (position == fsm_pages_.size() * FreeSpaceMapPage::CAPACITY) {
+    // 最后一页满了，接一页新的
+    page_id_t map_page_id;
+    page = buffer_pool_manager_->NewPage(map_page_id);
+    if (page == nullptr) return false;
+    page->SetPageClass(PageClass::kMeta);
+    reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->Init();
+    if (fsm_pages_.empty()) {
+      fsm_page_id_ = map_page_id;
+    } else {
+      auto last = buffer_pool_manager_->FetchPage(fsm_pages_.back());
+      if (last == nullptr) {
+        buffer_pool_manager_->UnpinPage(map_page_id, false);
+        buffer_pool_manager_->DeletePage(map_page_id);
+        return false;
+      }
+      reinterpret_cast<FreeSpaceMapPage *>(last->GetData())->SetNextPageId(map_page_id);
+      buffer_pool_manager_->UnpinPage(fsm_pages_.back(), true);
+    }
+    fsm_pages_.push_back(map_page_id);
+    fsm_max_categories_.push_back(0);
   } else {
-    DeleteTable(first_page_id_);
+    page = buffer_pool_manager_->FetchPage(fsm_pages_.back());
+    if (page == nullptr) return false;
+  }
+  uint8_t category = FreeSpaceMapPage::ToCategory(free_space);
+  reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->Append(page_id, category);
+  buffer_pool_manager_->UnpinPage(fsm_pages_.back(), true);
+  fsm_entries_[page_id] = position;
+  fsm_max_categories_.back() = std::max(fsm_max_categories_.back(), category);
+  last_page_id_ = page_id;
+  return true;
+}
+
+page_id_t TableHeap::FindPageWithSpace(uint32_t size) {
+  uint8_t min_category = FreeSpaceMapPage::MinCategory(size);
+  for (size_t i = 0; i < fsm_pages_.size(); i++) {
+    if (fsm_max_categories_[i] < min_category) continue;
+    auto page = buffer_pool_manager_->FetchPage(fsm_pages_[i]);
+    if (page == nullptr) return INVALID_PAGE_ID;
+    auto map_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+    int slot = map_page->FindSlot(min_category);
+    page_id_t page_id = slot < 0 ? INVALID_PAGE_ID : map_page->GetPageId(slot);
+    // 这一页没有放得下的，记下它真正的最大值，下次直接跳过
+    if (slot < 0) fsm_max_categories_[i] = map_page->GetMaxCategory();
+    buffer_pool_manager_->UnpinPage(fsm_pages_[i], false);
+    if (page_id != INVALID_PAGE_ID) return page_id;
+  }
+  return INVALID_PAGE_ID;
+}
+
+void TableHeap::UpdateFreeSpace(page_id_t page_id, uint32_t free_space) {
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  LoadFreeSpaceMap();
+  SetFreeSpace(page_id, free_space);
+}
+
+void TableHeap::SetFreeSpace(page_id_t page_id, uint32_t free_space) {
+  auto it = fsm_entries_.find(page_id);
+  if (it == fsm_entries_.end()) return;
+  size_t index = it->second / FreeSpaceMapPage::CAPACITY;
+  uint32_t slot = it->second % FreeSpaceMapPage::CAPACITY;
+  auto page = buffer_pool_manager_->FetchPage(fsm_pages_[index]);
+  if (page == nullptr) return;
+  auto map_page = reinterpret_cast<FreeSpaceMapPage *>(page->GetData());
+  uint8_t category = FreeSpaceMapPage::ToCategory(free_space);
+  bool changed = map_page->GetCategory(slot) != category;
+  map_page->SetCategory(slot, category);
+  buffer_pool_manager_->UnpinPage(fsm_pages_[index], changed);
+  fsm_max_categories_[index] = std::max(fsm_max_categories_[index], category);
+}
+
+std::vector<page_id_t> TableHeap::GetFreeSpaceMapPages() {
+  if (fsm_loaded_) return fsm_pages_;
+  std::vector<page_id_t> pages;
+  for (page_id_t page_id = fsm_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    if (page == nullptr) break;
+    pages.push_back(page_id);
+    page_id = reinterpret_cast<FreeSpaceMapPage *>(page->GetData())->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(pages.back(), false);
+  }
+  return pages;
+}
+
+void TableHeap::DeleteFreeSpaceMap() {
+  std::scoped_lock<std::mutex> lock(fsm_latch_);
+  for (auto page_id : GetFreeSpaceMapPages()) {
+    buffer_pool_manager_->DeletePage(page_id);
   }
+  fsm_page_id_ = INVALID_PAGE_ID;
+  fsm_loaded_ = false;
+  fsm_pages_.clear();
+  fsm_max_categories_.clear();
+  fsm_entries_.clear();
 }
 
 /**
  * TODO: Student Implement
  */
-TableIterator TableHeap::Begin(Transaction *txn) {
-  RowId rid=INVALID_ROWID;
-  if(this->first_page_id_!=INVALID_PAGE_ID){
-    auto page=reinterpret_cast<TablePage*>(this->buffer_pool_manager_->FetchPage(first_page_id_));
-    ASSERT(page!= nullptr,"can't fetch page from disk");
-    page->GetFirstTupleRid(&rid);//获取成功会改变rid，否则rid还是会被设置为INVALID_ROWID
-  }
-  return TableIterator(this,rid);
+TableIterator TableHeap::Begin([[maybe_unused]] Transaction *txn, BufferRing *ring) {
+  //迭代器自己找第一页上第一个元组，第一页空了就往后找
+  return TableIterator(this,RowId(first_page_id_,0),ring);
 }
 
 /**
@@ -3,30 +3,35 @@
 #include "common/macros.h"
 #include "storage/table_heap.h"
 
+static page_id_t NextTablePage(Page *page) { return reinterpret_cast<TablePage *>(page)->GetNextPageId(); }
+
 /**
  * TODO: Student Implement
  */
-TableIterator::TableIterator(TableHeap* tableHeap,RowId rid) {
+TableIterator::TableIterator(TableHeap* tableHeap,RowId rid,BufferRing *ring) {
   this->table_heap_ = tableHeap;
-  //  this->row=new Row(rid);
-  if (rid.GetPageId() != INVALID_PAGE_ID){  // 有效则读取数据
-    this->row=new Row(rid);
-    this->table_heap_->GetTuple(this->row, nullptr);
-  }else
-    this->row=new Row(INVALID_ROWID);
+  this->ring_ = ring;
+  if (rid.GetPageId() != INVALID_PAGE_ID){  // 有效则读取这一页，停在rid或它后面第一个元组上
+    LoadPage(rid.GetPageId());
+    while (cursor_ < count_ && rows_[cursor_].GetRowId().GetSlotNum() < rid.GetSlotNum()) cursor_++;
+    SkipEmptyPages();
+  }
 }
 
 TableIterator::TableIterator(const TableIterator &other) {
   this->table_heap_=other.table_heap_;
-  this->row=new Row(*other.row);
+  this->ring_=other.ring_;
+  this->read_ahead_=other.read_ahead_;
+  this->rows_.assign(other.rows_.begin(),other.rows_.begin()+other.count_);
+  this->count_=other.count_;
+  this->cursor_=other.cursor_;
+  this->next_page_id_=other.next_page_id_;
 }
 
-TableIterator::~TableIterator() {
-  delete row;
-}
+TableIterator::~TableIterator() = default;
 
 bool TableIterator::operator==(const TableIterator &itr) const {
-  if(this->table_heap_==itr.table_heap_&&this->row->GetRowId()==itr.row->GetRowId())
+  if(this->table_heap_==itr.table_heap_&&this->GetRowId()==itr.GetRowId())
     return true;
   return false;
 }
@@ -37,56 +42,64 @@ bool TableIterator::operator!=(const TableIterator &itr) const {
 
 const Row &TableIterator::operator*() {
 //  ASSERT(false, "Not implemented yet.");
-  return *row;
+  return cursor_ < count_ ? rows_[cursor_] : end_row_;
 }
 
 Row *TableIterator::operator->() {
-  return row;
+  return cursor_ < count_ ? &rows_[cursor_] : &end_row_;
 }
 
 TableIterator &TableIterator::operator=(const TableIterator &itr) noexcept {
 //  ASSERT(false, "Not implemented yet.");
+  if(this==&itr) return *this;
   this->table_heap_=itr.table_heap_;
-  this->row=new Row(*itr.row);
+  this->ring_=itr.ring_;
+  this->read_ahead_=itr.read_ahead_;
+  this->rows_.assign(itr.rows_.begin(),itr.rows_.begin()+itr.count_);
+  this->count_=itr.count_;
+  this->cursor_=itr.cursor_;
+  this->next_page_id_=itr.next_page_id_;
+  return *this;
 }
 
 // ++iter
 TableIterator &TableIterator::operator++() {
-  if(this->row->GetRowId().GetPageId()!=INVALID_PAGE_ID) {//当前不是无效的page
-    auto page=reinterpret_cast<TablePage *>(this->table_heap_->buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
-    RowId new_rid;
-    page->RLatch();
-    if(page->GetNextTupleRid(row->GetRowId(),&new_rid)){//此page有next 元组
-      page->RUnlatch();
-      delete this->row;
-      this->row=new Row(new_rid);
-      this->table_heap_->GetTuple(row,nullptr);
-    }else{//没有next 元组
-      auto next_page_id=page->GetNextPageId();
-      page->RUnlatch();
-      if(next_page_id==INVALID_PAGE_ID){//当前是最后的page，下一页为无效
-        delete this->row;
-        this->row=new Row(INVALID_ROWID);
-
-      }else{
-        auto next_page=reinterpret_cast<TablePage *>(this->table_heap_->buffer_pool_manager_->FetchPage(next_page_id));
-        next_page->RLatch();
-        next_page->GetFirstTupleRid(&new_rid);
-        next_page->RUnlatch();
-        delete this->row;
-        row=new Row(new_rid);
-        this->table_heap_->GetTuple(row, nullptr);
-      }
-      table_heap_->buffer_pool_manager_->UnpinPage(next_page_id,false);
-    }
-    this->table_heap_->buffer_pool_manager_->UnpinPage(page->GetPageId(),false);
+  if(cursor_<count_){//当前不是end
+    cursor_++;
+    SkipEmptyPages();
   }
   return *this;
 }
 
 // iter++
 TableIterator TableIterator::operator++(int) {
-  RowId rid=this->row->GetRowId();
+  TableIterator old(*this);
   this->operator++();
-  return TableIterator(this->table_heap_,rid);
+  return old;
+}
+
+void TableIterator::LoadPage(page_id_t page_id) {
+  count_=0;
+  cursor_=0;
+  next_page_id_=INVALID_PAGE_ID;
+  auto page=reinterpret_cast<TablePage *>(table_heap_->buffer_pool_manager_->FetchPage(page_id,ring_));
+  ASSERT(page!=nullptr,"Can not fetch the table page to scan.");//不能当作链尾，否则扫描结果会被截断
+  //一次pin住，整页解码完再放开
+  page->RLatch();
+  count_=page->GetTuples(&rows_,table_heap_->schema_);
+  next_page_id_=page->GetNextPageId();
+  page->RUnlatch();
+  table_heap_->buffer_pool_manager_->UnpinPage(page_id,false);
+}
+
+void TableIterator::SkipEmptyPages() {
+  while(cursor_>=count_&&next_page_id_!=INVALID_PAGE_ID){
+    page_id_t page_id=next_page_id_;
+    LoadPage(page_id);
+    read_ahead_.OnNextPage(table_heap_->buffer_pool_manager_,page_id,NextTablePage);//顺序读时预读后面的页
+  }
+  if(cursor_>=count_){//到头了
+    count_=0;
+    cursor_=0;
+  }
 }
@@ -0,0 +1,69 @@
+#include "buffer/buffer_pool_budget.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+
+TEST(BufferPoolBudgetTest, RebalanceTest) {
+  const std::string db_name = "bpm_budget_test.db";
+  const size_t total_frames = 64;
+  const size_t min_frames = 8;
+  const size_t num_pages = 48;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  // the pools start with their minimum, the budget raises their max pool size as it grants them frames
+  auto *busy = new BufferPoolManagerInstance(min_frames, disk_manager, ReplacerType::kLRU);
+  auto *idle = new BufferPoolManagerInstance(min_frames, disk_manager, ReplacerType::kLRU);
+  BufferPoolBudget budget(total_frames);
+
+  // Scenario: without any load the budget is split evenly.
+  EXPECT_EQ(total_frames, budget.GetInitialFrames(min_frames));
+  budget.Register(busy, min_frames);
+  EXPECT_EQ(total_frames, busy->GetPoolSize());
+  EXPECT_EQ(total_frames / 2, budget.GetInitialFrames(min_frames));
+  budget.Register(idle, min_frames);
+  EXPECT_EQ(total_frames / 2, busy->GetPoolSize());
+  EXPECT_EQ(total_frames / 2, idle->GetPoolSize());
+
+  // Scenario: a skipped rebalance changes nothing.
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, busy->NewPage(page_id));
+    busy->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+  for (int round = 0; round < 2; round++) {
+    for (auto page_id : page_ids) {
+      ASSERT_NE(nullptr, busy->FetchPage(page_id));
+      busy->UnpinPage(page_id, false);
+    }
+  }
+  EXPECT_FALSE(budget.Rebalance());
+  EXPECT_EQ(total_frames / 2, busy->GetPoolSize());
+
+  // Scenario: the busy pool takes over the spare frames, the idle one keeps its minimum.
+  for (int round = 0; round < 4; round++) {
+    for (auto page_id : page_ids) {
+      ASSERT_NE(nullptr, busy->FetchPage(page_id));
+      busy->UnpinPage(page_id, false);
+    }
+    EXPECT_TRUE(budget.Rebalance(true));
+  }
+  EXPECT_EQ(min_frames, idle->GetPoolSize());
+  EXPECT_LE(busy->GetPoolSize() + idle->GetPoolSize(), total_frames);
+  EXPECT_GE(busy->GetPoolSize(), total_frames - min_frames - total_frames / 32);
+
+  // Scenario: once the busy pool is gone, its frames go to the remaining one.
+  budget.Unregister(busy);
+  EXPECT_EQ(total_frames, idle->GetPoolSize());
+
+  delete busy;
+  delete idle;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
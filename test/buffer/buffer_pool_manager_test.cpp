@@ -1,10 +1,16 @@
-#include "buffer/buffer_pool_manager.h"
+#include "buffer/buffer_pool_manager_instance.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "storage/storage_backend.h"
 
 TEST(BufferPoolManagerTest, BinaryDataTest) {
   const std::string db_name = "bpm_test.db";
@@ -16,7 +22,7 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   remove(db_name.c_str());
   auto *disk_manager = new DiskManager(db_name);
-  auto *bpm = new BufferPoolManager(buffer_pool_size, disk_manager);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
 
   page_id_t page_id_temp;
   auto *page0 = bpm->NewPage(page_id_temp);
@@ -71,4 +77,771 @@ TEST(BufferPoolManagerTest, BinaryDataTest) {
 
   delete bpm;
   delete disk_manager;
-}
\ No newline at end of file
+}
+/**
+ * Point lookups on a small hot set interleaved with large sequential scans, reported as the buffer pool hit ratio.
+ */
+static double MeasureHitRatio(ReplacerType replacer_type, DiskManager *disk_manager,
+                              const std::vector<page_id_t> &page_ids, size_t pool_size, size_t hot_pages) {
+  BufferPoolManagerInstance bpm(pool_size, disk_manager, replacer_type);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<size_t> hot_dist(0, hot_pages - 1);
+  for (int round = 0; round < 20; round++) {
+    for (int i = 0; i < 500; i++) {
+      page_id_t page_id = page_ids[hot_dist(rng)];
+      EXPECT_NE(nullptr, bpm.FetchPage(page_id));
+      bpm.UnpinPage(page_id, false);
+    }
+    for (size_t i = hot_pages; i < page_ids.size(); i++) {
+      EXPECT_NE(nullptr, bpm.FetchPage(page_ids[i]));
+      bpm.UnpinPage(page_ids[i], false);
+    }
+  }
+  EXPECT_TRUE(bpm.CheckAllUnpinned());
+  return static_cast<double>(bpm.GetHitCount()) / (bpm.GetHitCount() + bpm.GetMissCount());
+}
+
+TEST(BufferPoolManagerTest, ReplacerHitRatioTest) {
+  const std::string db_name = "bpm_hit_ratio_test.db";
+  const size_t pool_size = 64;
+  const size_t hot_pages = 32;
+  const size_t num_pages = 512;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    BufferPoolManagerInstance loader(pool_size, disk_manager);
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      ASSERT_NE(nullptr, loader.NewPage(page_id));
+      loader.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  double lru = MeasureHitRatio(ReplacerType::kLRU, disk_manager, page_ids, pool_size, hot_pages);
+  double lru_k = MeasureHitRatio(ReplacerType::kLRUK, disk_manager, page_ids, pool_size, hot_pages);
+  // the scans flush the hot set out of an LRU pool, LRU-K keeps it
+  EXPECT_GT(lru_k, lru);
+
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, DISABLED_ReplacerHitRatioBenchmark) {
+  const std::string db_name = "bpm_hit_ratio.db";
+  const size_t pool_size = 64;
+  const size_t hot_pages = 32;
+  const size_t num_pages = 512;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    BufferPoolManagerInstance loader(pool_size, disk_manager);
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      ASSERT_NE(nullptr, loader.NewPage(page_id));
+      loader.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  double lru = MeasureHitRatio(ReplacerType::kLRU, disk_manager, page_ids, pool_size, hot_pages);
+  double lru_k = MeasureHitRatio(ReplacerType::kLRUK, disk_manager, page_ids, pool_size, hot_pages);
+  double clock = MeasureHitRatio(ReplacerType::kClock, disk_manager, page_ids, pool_size, hot_pages);
+  printf("%-8s %10s\n", "policy", "hit ratio");
+  printf("%-8s %10.3f\n", "LRU", lru);
+  printf("%-8s %10.3f\n", "LRU-K", lru_k);
+  printf("%-8s %10.3f\n", "CLOCK", clock);
+  // the scans flush the hot set out of an LRU pool, LRU-K keeps it
+  EXPECT_GT(lru_k, lru);
+
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, BufferRingTest) {
+  const std::string db_name = "bpm_ring_test.db";
+  const size_t buffer_pool_size = 16;
+  const size_t hot_pages = 8;
+  const size_t num_pages = 100;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    snprintf(bpm->FetchPage(page_id)->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+  // Scenario: warm the hot set.
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i]));
+    bpm->UnpinPage(page_ids[i], false);
+  }
+
+  // Scenario: scan the cold pages through a ring of 4 frames, the content must be intact.
+  BufferRing ring(4);
+  char expected[PAGE_SIZE];
+  for (size_t i = hot_pages; i < num_pages; i++) {
+    Page *page = bpm->FetchPage(page_ids[i], &ring);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_ids[i]);
+    EXPECT_STREQ(expected, page->GetData());
+    bpm->UnpinPage(page_ids[i], false);
+  }
+
+  // Scenario: the scan recycled its own frames, so the hot set is still cached.
+  size_t misses = bpm->GetMissCount();
+  for (size_t i = 0; i < hot_pages; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i]));
+    bpm->UnpinPage(page_ids[i], false);
+  }
+  EXPECT_EQ(misses, bpm->GetMissCount());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, BackgroundWriterTest) {
+  const std::string db_name = "bpm_bg_writer_test.db";
+  const size_t buffer_pool_size = 10;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: fill the pool with dirty unpinned pages.
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+
+  // Scenario: the background writer cleans the whole pool.
+  bpm->StartBackgroundWriter(buffer_pool_size, std::chrono::milliseconds(1));
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriteCount() < buffer_pool_size; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(buffer_pool_size, bpm->GetBackgroundWriteCount());
+
+  // Scenario: replacing every frame needs no write on the critical path, and the old content is on disk.
+  bpm->StopBackgroundWriter();
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, false);
+  }
+  EXPECT_EQ(0, bpm->GetSyncWriteCount());
+  char expected[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_STREQ(expected, page->GetData());
+    bpm->UnpinPage(page_id, true);
+  }
+
+  // Scenario: a checkpoint writes every dirty page as one batch, the disk copies match without a write back.
+  bpm->FlushAllPages();
+  char data[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    disk_manager->ReadPage(page_id, data);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_STREQ(expected, data);
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+/** Memory storage whose writes fail while fail_ is set */
+class FailingBackend : public MemoryBackend {
+ public:
+  bool Write(const char *buf, size_t size, size_t offset) override {
+    return !fail_ && MemoryBackend::Write(buf, size, offset);
+  }
+
+  std::atomic<bool> fail_{false};
+};
+
+TEST(BufferPoolManagerTest, WriteErrorTest) {
+  const size_t buffer_pool_size = 10;
+  auto backend = std::make_unique<FailingBackend>();
+  auto *storage = backend.get();
+  auto *disk_manager = new DiskManager(std::move(backend));
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+
+  // Scenario: a failed checkpoint is reported and the pages stay dirty.
+  storage->fail_ = true;
+  EXPECT_FALSE(bpm->FlushAllPages());
+
+  // Scenario: the background writer fails on the same pages.
+  bpm->StartBackgroundWriter(buffer_pool_size, std::chrono::milliseconds(1));
+  for (int i = 0; i < 1000 && bpm->GetBackgroundWriteCount() < buffer_pool_size; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  bpm->StopBackgroundWriter();
+  EXPECT_EQ(buffer_pool_size, bpm->GetBackgroundWriteCount());
+
+  // Scenario: once the storage recovers the next checkpoint writes every page.
+  storage->fail_ = false;
+  EXPECT_TRUE(bpm->FlushAllPages());
+  char expected[PAGE_SIZE];
+  char data[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    disk_manager->ReadPage(page_id, data);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_STREQ(expected, data);
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+/** Memory storage whose writes block while block_ is set */
+class BlockingBackend : public MemoryBackend {
+ public:
+  bool Write(const char *buf, size_t size, size_t offset) override {
+    blocked_++;
+    while (block_) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return MemoryBackend::Write(buf, size, offset);
+  }
+
+  std::atomic<bool> block_{false};
+  std::atomic<size_t> blocked_{0};
+};
+
+TEST(BufferPoolManagerTest, InFlightEvictionTest) {
+  const size_t buffer_pool_size = 3;
+  auto backend = std::make_unique<BlockingBackend>();
+  auto *storage = backend.get();
+  auto *disk_manager = new DiskManager(std::move(backend));
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+
+  // Scenario: the background writer copies every page and hangs in the write.
+  storage->block_ = true;
+  bpm->StartBackgroundWriter(buffer_pool_size, std::chrono::milliseconds(1));
+  while (storage->blocked_ == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Scenario: pages in flight are evicted and read back without waiting for the write or writing them again.
+  page_id_t new_page_id;
+  ASSERT_NE(nullptr, bpm->NewPage(new_page_id));
+  bpm->UnpinPage(new_page_id, false);
+  char expected[PAGE_SIZE];
+  for (size_t i = 0; i < 2; i++) {
+    Page *page = bpm->FetchPage(page_ids[i]);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_ids[i]);
+    EXPECT_STREQ(expected, page->GetData());
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d-v2", page_ids[i]);
+    bpm->UnpinPage(page_ids[i], true);
+  }
+  EXPECT_EQ(0, bpm->GetSyncWriteCount());
+
+  // Scenario: once the write finishes, a checkpoint puts the newest version of every page on disk.
+  storage->block_ = false;
+  bpm->StopBackgroundWriter();
+  EXPECT_TRUE(bpm->FlushAllPages());
+  char data[PAGE_SIZE];
+  for (size_t i = 0; i < page_ids.size(); i++) {
+    disk_manager->ReadPage(page_ids[i], data);
+    snprintf(expected, PAGE_SIZE, i < 2 ? "page-%d-v2" : "page-%d", page_ids[i]);
+    EXPECT_STREQ(expected, data);
+  }
+
+  delete bpm;
+  delete disk_manager;
+}
+
+TEST(BufferPoolManagerTest, FlushAllPagesTest) {
+  const std::string db_name = "bpm_flush_test.db";
+  const size_t buffer_pool_size = 512;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+  bpm->FlushAllPages();
+  auto dirty_all = [&](int round) {
+    for (auto page_id : page_ids) {
+      Page *page = bpm->FetchPage(page_id);
+      snprintf(page->GetData(), PAGE_SIZE, "round-%d-page-%d", round, page_id);
+      bpm->UnpinPage(page_id, true);
+    }
+  };
+
+  // Scenario: page by page in random order, with a sync at the end, as the shutdown path used to do.
+  dirty_all(1);
+  std::shuffle(page_ids.begin(), page_ids.end(), std::mt19937(0));
+  for (auto page_id : page_ids) {
+    EXPECT_TRUE(bpm->FlushPage(page_id));
+  }
+  EXPECT_TRUE(disk_manager->Sync());
+
+  // Scenario: one sorted batch of merged writes and a single sync.
+  dirty_all(2);
+  EXPECT_TRUE(bpm->FlushAllPages());
+
+  char data[PAGE_SIZE];
+  char expected[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    disk_manager->ReadPage(page_id, data);
+    snprintf(expected, PAGE_SIZE, "round-2-page-%d", page_id);
+    ASSERT_STREQ(expected, data);
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, DISABLED_FlushAllPagesBenchmark) {
+  const std::string db_name = "bpm_flush_bench.db";
+  const size_t buffer_pool_size = 4096;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+  bpm->FlushAllPages();
+  auto dirty_all = [&](int round) {
+    for (auto page_id : page_ids) {
+      Page *page = bpm->FetchPage(page_id);
+      snprintf(page->GetData(), PAGE_SIZE, "round-%d-page-%d", round, page_id);
+      bpm->UnpinPage(page_id, true);
+    }
+  };
+
+  // Scenario: page by page in page table order, with a sync at the end, as the shutdown path used to do.
+  dirty_all(1);
+  std::shuffle(page_ids.begin(), page_ids.end(), std::mt19937(0));
+  auto begin = std::chrono::steady_clock::now();
+  for (auto page_id : page_ids) {
+    bpm->FlushPage(page_id);
+  }
+  disk_manager->Sync();
+  std::chrono::duration<double, std::milli> per_page = std::chrono::steady_clock::now() - begin;
+
+  // Scenario: one sorted batch of merged writes and a single sync.
+  dirty_all(2);
+  begin = std::chrono::steady_clock::now();
+  bpm->FlushAllPages();
+  std::chrono::duration<double, std::milli> batched = std::chrono::steady_clock::now() - begin;
+  printf("flush %zu dirty pages: page by page %.1f ms, FlushAllPages %.1f ms\n", buffer_pool_size, per_page.count(),
+         batched.count());
+
+  char data[PAGE_SIZE];
+  char expected[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    disk_manager->ReadPage(page_id, data);
+    snprintf(expected, PAGE_SIZE, "round-2-page-%d", page_id);
+    ASSERT_STREQ(expected, data);
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+static page_id_t NextChainPage(Page *page) { return *reinterpret_cast<page_id_t *>(page->GetData()); }
+
+TEST(BufferPoolManagerTest, ReadAheadTest) {
+  const std::string db_name = "bpm_read_ahead_test.db";
+  const size_t buffer_pool_size = 64;
+  const size_t chain_length = 12;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    // Scenario: build a chain of pages, every page stores the id of its successor in the first bytes.
+    BufferPoolManagerInstance loader(buffer_pool_size, disk_manager);
+    for (size_t i = 0; i < chain_length; i++) {
+      page_id_t page_id;
+      ASSERT_NE(nullptr, loader.NewPage(page_id));
+      page_ids.push_back(page_id);
+    }
+    for (size_t i = 0; i < chain_length; i++) {
+      page_id_t next_page_id = i + 1 < chain_length ? page_ids[i + 1] : INVALID_PAGE_ID;
+      memcpy(loader.FetchPage(page_ids[i])->GetData(), &next_page_id, sizeof(page_id_t));
+      loader.UnpinPage(page_ids[i], true);
+      loader.UnpinPage(page_ids[i], true);
+    }
+  }
+
+  // Scenario: batch fetch pins every page and keeps the order of the request.
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+  std::vector<page_id_t> batch = {page_ids[2], page_ids[0], page_ids[1]};
+  std::vector<page_id_t> successors = {page_ids[3], page_ids[1], page_ids[2]};
+  auto pages = bpm->FetchPages(batch);
+  ASSERT_EQ(batch.size(), pages.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    ASSERT_NE(nullptr, pages[i]);
+    EXPECT_EQ(batch[i], pages[i]->GetPageId());
+    EXPECT_EQ(successors[i], NextChainPage(pages[i]));
+    EXPECT_TRUE(bpm->UnpinPage(batch[i], false));
+  }
+  EXPECT_EQ(3, bpm->GetMissCount());
+
+  // Scenario: read-ahead from page 2 brings in the rest of the chain, and stops at its end.
+  bpm->ReadAhead(page_ids[2], NextChainPage, chain_length);
+  for (int i = 0; i < 1000 && (bpm->GetMissCount() < chain_length || !bpm->CheckAllUnpinned()); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(chain_length, bpm->GetMissCount());
+  for (auto page_id : page_ids) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_id));
+    bpm->UnpinPage(page_id, false);
+  }
+  EXPECT_EQ(chain_length, bpm->GetMissCount());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: a read-ahead that follows the chain into a deleted page must not shadow the page reusing its id.
+  page_id_t last_page_id = page_ids[chain_length - 1];
+  EXPECT_TRUE(bpm->DeletePage(last_page_id));
+  bpm->ReadAhead(page_ids[chain_length - 2], NextChainPage, 1);
+  for (int i = 0; i < 1000 && (bpm->GetMissCount() < chain_length + 1 || !bpm->CheckAllUnpinned()); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(chain_length + 1, bpm->GetMissCount());
+  page_id_t new_page_id;
+  Page *new_page = bpm->NewPage(new_page_id);
+  ASSERT_NE(nullptr, new_page);
+  EXPECT_EQ(last_page_id, new_page_id);
+  memcpy(new_page->GetData(), "reused", 7);
+  EXPECT_TRUE(bpm->UnpinPage(new_page_id, true));
+  Page *page = bpm->FetchPage(new_page_id);
+  ASSERT_EQ(new_page, page);
+  EXPECT_EQ(0, strcmp("reused", page->GetData()));
+  bpm->UnpinPage(new_page_id, false);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, FrameAlignmentTest) {
+  const std::string db_name = "bpm_alignment_test.db";
+  const size_t buffer_pool_size = 8;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager);
+
+  // Scenario: every frame is page aligned and frames do not overlap.
+  std::vector<char *> frames;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(page->GetData()) % PAGE_SIZE);
+    memset(page->GetData(), static_cast<int>(i), PAGE_SIZE);
+    frames.push_back(page->GetData());
+  }
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    EXPECT_EQ(static_cast<char>(i), frames[i][0]);
+    EXPECT_EQ(static_cast<char>(i), frames[i][PAGE_SIZE - 1]);
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, WarmStartTest) {
+  const std::string db_name = "bpm_warm_start_test.db";
+  const std::string warm_file = db_name + WARM_START_FILE_SUFFIX;
+  const size_t buffer_pool_size = 4;
+
+  remove(db_name.c_str());
+  remove(warm_file.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    // Scenario: pages 1-4 are resident at shutdown, least recently used first.
+    BufferPoolManagerInstance bpm(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+    EXPECT_EQ(0, bpm.EnableWarmStart(warm_file));
+    for (size_t i = 0; i < buffer_pool_size + 1; i++) {
+      page_id_t page_id;
+      Page *page = bpm.NewPage(page_id);
+      ASSERT_NE(nullptr, page);
+      snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+      bpm.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  // Scenario: the next start reloads them without a single miss.
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+  EXPECT_EQ(buffer_pool_size, bpm->EnableWarmStart(warm_file));
+  char expected[PAGE_SIZE];
+  for (size_t i = 1; i < page_ids.size(); i++) {
+    Page *page = bpm->FetchPage(page_ids[i]);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_ids[i]);
+    EXPECT_STREQ(expected, page->GetData());
+    bpm->UnpinPage(page_ids[i], false);
+  }
+  EXPECT_EQ(0, bpm->GetMissCount());
+
+  // Scenario: the replacement order survives, page 1 has been used least recently.
+  delete bpm;
+  bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+  EXPECT_EQ(buffer_pool_size, bpm->EnableWarmStart(warm_file));
+  ASSERT_NE(nullptr, bpm->FetchPage(page_ids[0]));
+  bpm->UnpinPage(page_ids[0], false);
+  for (size_t i = 2; i < page_ids.size(); i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i]));
+    bpm->UnpinPage(page_ids[i], false);
+  }
+  EXPECT_EQ(1, bpm->GetMissCount());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+  remove(warm_file.c_str());
+}
+
+TEST(BufferPoolManagerTest, ResizeTest) {
+  const std::string db_name = "bpm_resize_test.db";
+  const size_t buffer_pool_size = 8;
+  const size_t max_pool_size = 16;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU, max_pool_size);
+  EXPECT_EQ(max_pool_size, bpm->GetMaxPoolSize());
+
+  // Scenario: fill the pool.
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+
+  // Scenario: grow the pool, the new frames are free so nothing is evicted. The last new page stays pinned.
+  EXPECT_EQ(max_pool_size, bpm->Resize(max_pool_size * 2));
+  EXPECT_EQ(max_pool_size, bpm->GetPoolSize());
+  for (size_t i = buffer_pool_size; i < max_pool_size; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    if (i + 1 < max_pool_size) bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+  for (size_t i = 0; i < buffer_pool_size; i++) {
+    ASSERT_NE(nullptr, bpm->FetchPage(page_ids[i]));
+    bpm->UnpinPage(page_ids[i], false);
+  }
+  EXPECT_EQ(0, bpm->GetMissCount());
+
+  // Scenario: shrink to two frames. The pinned page keeps its frame beyond the new size but does not count.
+  EXPECT_EQ(2, bpm->Resize(2));
+  EXPECT_EQ(2, bpm->GetPoolSize());
+  page_id_t page_id;
+  ASSERT_NE(nullptr, bpm->FetchPage(page_ids[0]));
+  ASSERT_NE(nullptr, bpm->FetchPage(page_ids[1]));
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  bpm->UnpinPage(page_ids[0], false);
+  bpm->UnpinPage(page_ids[1], false);
+
+  // Scenario: the dirty pages evicted by the shrink were written back.
+  char expected[PAGE_SIZE];
+  for (size_t i = 0; i + 1 < page_ids.size(); i++) {
+    Page *page = bpm->FetchPage(page_ids[i]);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_ids[i]);
+    EXPECT_STREQ(expected, page->GetData());
+    bpm->UnpinPage(page_ids[i], false);
+  }
+
+  // Scenario: the pinned page is written back and its frame released once it is unpinned.
+  bpm->UnpinPage(page_ids.back(), true);
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+  size_t misses = bpm->GetMissCount();
+  Page *page = bpm->FetchPage(page_ids.back());
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(misses + 1, bpm->GetMissCount());
+  snprintf(expected, PAGE_SIZE, "page-%d", page_ids.back());
+  EXPECT_STREQ(expected, page->GetData());
+  bpm->UnpinPage(page_ids.back(), false);
+
+  // Scenario: growing again makes the released frames usable.
+  EXPECT_EQ(max_pool_size, bpm->Resize(max_pool_size));
+  for (auto id : page_ids) {
+    ASSERT_NE(nullptr, bpm->FetchPage(id));
+  }
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  for (auto id : page_ids) {
+    bpm->UnpinPage(id, false);
+  }
+
+  // Scenario: raising the max pool size lets the pool grow past the frames it was created with.
+  bpm->SetMaxPoolSize(max_pool_size * 2);
+  EXPECT_EQ(max_pool_size * 2, bpm->Resize(max_pool_size * 2));
+  misses = bpm->GetMissCount();
+  for (size_t i = 0; i < max_pool_size; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  for (auto id : page_ids) {
+    ASSERT_NE(nullptr, bpm->FetchPage(id));
+    bpm->UnpinPage(id, false);
+  }
+  EXPECT_EQ(misses, bpm->GetMissCount());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, PageClassTest) {
+  const std::string db_name = "bpm_page_class_test.db";
+  const size_t buffer_pool_size = 8;
+  const size_t num_internal_pages = 2;
+  const size_t num_heap_pages = 32;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+
+  // Scenario: two pages are tagged as index internal pages.
+  std::vector<page_id_t> internal_page_ids;
+  for (size_t i = 0; i < num_internal_pages; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    page->SetPageClass(PageClass::kIndexInternal);
+    bpm->UnpinPage(page_id, true);
+    internal_page_ids.push_back(page_id);
+  }
+
+  // Scenario: a scan over many more untagged pages than frames does not push them out.
+  for (size_t i = 0; i < num_heap_pages; i++) {
+    page_id_t page_id;
+    ASSERT_NE(nullptr, bpm->NewPage(page_id));
+    bpm->UnpinPage(page_id, true);
+  }
+  EXPECT_EQ(num_internal_pages, bpm->GetResidentPageCount(PageClass::kIndexInternal));
+  EXPECT_EQ(buffer_pool_size - num_internal_pages, bpm->GetResidentPageCount(PageClass::kHeap));
+  EXPECT_EQ(num_heap_pages - (buffer_pool_size - num_internal_pages), bpm->GetEvictionCount(PageClass::kHeap));
+  EXPECT_EQ(0, bpm->GetEvictionCount(PageClass::kIndexInternal));
+  for (auto page_id : internal_page_ids) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ(PageClass::kIndexInternal, page->GetPageClass());
+    bpm->UnpinPage(page_id, false);
+  }
+  EXPECT_EQ(0, bpm->GetMissCount());
+
+  // Scenario: a deleted page no longer counts.
+  EXPECT_TRUE(bpm->DeletePage(internal_page_ids[0]));
+  EXPECT_EQ(num_internal_pages - 1, bpm->GetResidentPageCount(PageClass::kIndexInternal));
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(BufferPoolManagerTest, CompressedCacheTest) {
+  const std::string db_name = "bpm_compressed_cache_test.db";
+  const size_t buffer_pool_size = 8;
+  const size_t num_pages = 64;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new BufferPoolManagerInstance(buffer_pool_size, disk_manager, ReplacerType::kLRU);
+  bpm->EnableCompressedCache(num_pages * PAGE_SIZE / 2);
+
+  // Scenario: half-empty pages of character data, many more than the pool holds.
+  std::vector<page_id_t> page_ids;
+  for (size_t i = 0; i < num_pages; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    for (int offset = 0; offset < PAGE_SIZE / 2; offset += 32) {
+      snprintf(page->GetData() + offset, 32, "row %d of page %d", offset / 32, page_id);
+    }
+    bpm->UnpinPage(page_id, true);
+    page_ids.push_back(page_id);
+  }
+
+  // Scenario: fetching them again is served by the compressed cache, the data is intact.
+  char expected[32];
+  for (int round = 0; round < 2; round++) {
+    for (auto page_id : page_ids) {
+      Page *page = bpm->FetchPage(page_id);
+      ASSERT_NE(nullptr, page);
+      snprintf(expected, sizeof(expected), "row 7 of page %d", page_id);
+      EXPECT_STREQ(expected, page->GetData() + 7 * 32);
+      bpm->UnpinPage(page_id, false);
+    }
+  }
+  CompressedCacheStats stats = bpm->GetCompressedCacheStats();
+  EXPECT_EQ(2 * num_pages, stats.hits_ + stats.misses_);
+  EXPECT_EQ(2 * num_pages, stats.hits_);
+  EXPECT_GT(stats.CompressionRatio(), 2);
+
+  // Scenario: a deleted page is dropped from the cache as well.
+  EXPECT_TRUE(bpm->DeletePage(page_ids[0]));
+  EXPECT_EQ(num_pages - buffer_pool_size - 1, bpm->GetCompressedCacheStats().pages_);
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
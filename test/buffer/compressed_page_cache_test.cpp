@@ -0,0 +1,84 @@
+#include "buffer/compressed_page_cache.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/lz_codec.h"
+#include "gtest/gtest.h"
+
+static void ExpectRoundTrip(const std::string &input) {
+  std::vector<char> compressed(input.size() * 2 + 16);
+  size_t size = LZCodec::Compress(input.data(), input.size(), compressed.data(), compressed.size());
+  ASSERT_TRUE(input.empty() || size > 0);
+  std::vector<char> output(input.size() + 1);
+  EXPECT_EQ(input.size(), LZCodec::Decompress(compressed.data(), size, output.data(), output.size()));
+  EXPECT_EQ(0, memcmp(input.data(), output.data(), input.size()));
+}
+
+TEST(CompressedPageCacheTest, CodecTest) {
+  std::mt19937 rng(0);
+  // Scenario: inputs without matches, with long runs and with short and overlapping repeats round-trip.
+  ExpectRoundTrip("");
+  ExpectRoundTrip("abc");
+  ExpectRoundTrip(std::string(PAGE_SIZE, '\0'));
+  ExpectRoundTrip(std::string(300, 'a') + "xyz" + std::string(1000, 'b'));
+  std::string random(PAGE_SIZE, '\0');
+  for (auto &c : random) c = static_cast<char>(rng());
+  ExpectRoundTrip(random);
+  std::string text;
+  while (text.size() < PAGE_SIZE) text += "name-" + std::to_string(rng() % 100) + ";";
+  ExpectRoundTrip(text);
+
+  // Scenario: compressible data shrinks, random data does not fit a smaller buffer.
+  char buffer[PAGE_SIZE];
+  EXPECT_LT(LZCodec::Compress(text.data(), text.size(), buffer, PAGE_SIZE), text.size() / 2);
+  EXPECT_EQ(0, LZCodec::Compress(random.data(), random.size(), buffer, PAGE_SIZE - 1));
+
+  // Scenario: a distance pointing before the start of the output is rejected.
+  const char corrupt[] = {0x10, 'a', 0x05, 0x00};
+  EXPECT_EQ(0, LZCodec::Decompress(corrupt, sizeof(corrupt), buffer, PAGE_SIZE));
+}
+
+TEST(CompressedPageCacheTest, SampleTest) {
+  char page[PAGE_SIZE] = {0};
+  char output[PAGE_SIZE];
+  // a mostly empty page compresses to about PAGE_SIZE / 256 bytes
+  const size_t capacity = PAGE_SIZE / 16;
+  CompressedPageCache cache(capacity);
+
+  // Scenario: mostly empty pages are stored, a page of random bytes is not.
+  for (page_id_t page_id = 0; page_id < 4; page_id++) {
+    snprintf(page, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_TRUE(cache.Put(page_id, page));
+  }
+  std::mt19937 rng(0);
+  char random[PAGE_SIZE];
+  for (auto &c : random) c = static_cast<char>(rng());
+  EXPECT_FALSE(cache.Put(4, random));
+  CompressedCacheStats stats = cache.GetStats();
+  EXPECT_EQ(4, stats.pages_);
+  EXPECT_EQ(1, stats.rejected_);
+  EXPECT_GT(stats.CompressionRatio(), 8);
+
+  // Scenario: a cached page is taken out on lookup.
+  EXPECT_TRUE(cache.Get(2, output));
+  EXPECT_STREQ("page-2", output);
+  EXPECT_FALSE(cache.Get(2, output));
+  EXPECT_FALSE(cache.Get(4, output));
+
+  // Scenario: the oldest pages make room once the capacity is reached.
+  for (page_id_t page_id = 10; page_id < 30; page_id++) {
+    snprintf(page, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_TRUE(cache.Put(page_id, page));
+  }
+  EXPECT_FALSE(cache.Get(0, output));
+  EXPECT_TRUE(cache.Get(29, output));
+  EXPECT_STREQ("page-29", output);
+  stats = cache.GetStats();
+  EXPECT_LE(stats.compressed_bytes_, capacity);
+  EXPECT_EQ(2, stats.hits_);
+  EXPECT_EQ(3, stats.misses_);
+  EXPECT_DOUBLE_EQ(0.4, stats.HitRate());
+}
@@ -0,0 +1,63 @@
+#include "buffer/lru_k_replacer.h"
+#include "gtest/gtest.h"
+
+TEST(LRUKReplacerTest, SampleTest) {
+  LRUKReplacer lru_k_replacer(7, 2);
+
+  // Scenario: frames 1-5 are pinned once, frame 1 and 2 are pinned again, then all of them are unpinned.
+  for (frame_id_t frame = 1; frame <= 5; frame++) {
+    lru_k_replacer.Pin(frame);
+  }
+  lru_k_replacer.Pin(1);
+  lru_k_replacer.Pin(2);
+  for (frame_id_t frame = 1; frame <= 5; frame++) {
+    lru_k_replacer.Unpin(frame);
+  }
+  EXPECT_EQ(5, lru_k_replacer.Size());
+
+  // Scenario: frames with a single access have an infinite K-distance and go first, oldest access first.
+  int value;
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(3, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(4, value);
+
+  // Scenario: a pinned frame is not evictable, unpinning it again keeps its history.
+  lru_k_replacer.Pin(5);
+  EXPECT_EQ(2, lru_k_replacer.Size());
+  lru_k_replacer.Unpin(5);
+  EXPECT_EQ(3, lru_k_replacer.Size());
+
+  // Scenario: frame 5 now has two accesses as well, the largest backward K-distance goes first.
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(2, value);
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(5, value);
+  EXPECT_EQ(0, lru_k_replacer.Size());
+  EXPECT_FALSE(lru_k_replacer.Victim(&value));
+}
+
+TEST(LRUKReplacerTest, ScanResistanceTest) {
+  LRUKReplacer lru_k_replacer(16, 2);
+
+  // Scenario: frame 0 is looked up repeatedly, frames 1-9 are touched once by a scan afterwards.
+  lru_k_replacer.Pin(0);
+  lru_k_replacer.Unpin(0);
+  lru_k_replacer.Pin(0);
+  lru_k_replacer.Unpin(0);
+  for (frame_id_t frame = 1; frame < 10; frame++) {
+    lru_k_replacer.Pin(frame);
+    lru_k_replacer.Unpin(frame);
+  }
+
+  // Scenario: every scanned frame is evicted before the hot one.
+  int value;
+  for (frame_id_t frame = 1; frame < 10; frame++) {
+    ASSERT_TRUE(lru_k_replacer.Victim(&value));
+    EXPECT_EQ(frame, value);
+  }
+  ASSERT_TRUE(lru_k_replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+}
@@ -0,0 +1,78 @@
+#include "buffer/mapped_buffer_pool_manager.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+
+TEST(MappedBufferPoolManagerTest, ReadOnlyTest) {
+  const std::string db_name = "mapped_bpm_test.db";
+  const size_t num_pages = 100;
+
+  remove(db_name.c_str());
+  std::vector<page_id_t> page_ids;
+  {
+    DiskManager disk_manager(db_name);
+    BufferPoolManagerInstance bpm(16, &disk_manager);
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      Page *page = bpm.NewPage(page_id);
+      ASSERT_NE(nullptr, page);
+      snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+      bpm.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  auto *disk_manager = new DiskManager(db_name, false, true);
+  auto *bpm = new MappedBufferPoolManager(disk_manager);
+
+  // Scenario: pages are served straight from the mapping, the same Page every time, without frames or pins.
+  char expected[PAGE_SIZE];
+  for (auto page_id : page_ids) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+    EXPECT_STREQ(expected, page->GetData());
+    EXPECT_EQ(page_id, page->GetPageId());
+    EXPECT_EQ(disk_manager->GetMappedPage(page_id), page->GetData());
+    EXPECT_EQ(page, bpm->FetchPage(page_id));
+    EXPECT_TRUE(bpm->UnpinPage(page_id, false));
+  }
+  auto pages = bpm->FetchPages({page_ids[3], page_ids[1]});
+  EXPECT_EQ(bpm->FetchPage(page_ids[3]), pages[0]);
+  EXPECT_EQ(bpm->FetchPage(page_ids[1]), pages[1]);
+  EXPECT_EQ(0, bpm->GetMissCount());
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: a page that was never written reads as zeros, a page id beyond the file does not exist.
+  Page *unused = bpm->FetchPage(num_pages + 10);
+  ASSERT_NE(nullptr, unused);
+  EXPECT_EQ(0, unused->GetData()[0]);
+  EXPECT_EQ(nullptr, bpm->FetchPage(-1));
+  EXPECT_EQ(nullptr, bpm->FetchPage(DiskManager::BITMAP_SIZE));
+
+  // Scenario: every kind of write is rejected and the file stays as it was.
+  page_id_t page_id;
+  EXPECT_EQ(nullptr, bpm->NewPage(page_id));
+  EXPECT_EQ(INVALID_PAGE_ID, page_id);
+  EXPECT_FALSE(bpm->UnpinPage(page_ids[0], true));
+  EXPECT_FALSE(bpm->DeletePage(page_ids[0]));
+  EXPECT_EQ(INVALID_PAGE_ID, disk_manager->AllocatePage());
+  disk_manager->WritePage(page_ids[0], expected);
+  disk_manager->DeAllocatePage(page_ids[0]);
+  delete bpm;
+  delete disk_manager;
+
+  DiskManager reopened(db_name);
+  char data[PAGE_SIZE];
+  reopened.ReadPage(page_ids[0], data);
+  snprintf(expected, PAGE_SIZE, "page-%d", page_ids[0]);
+  EXPECT_STREQ(expected, data);
+  EXPECT_FALSE(reopened.IsPageFree(page_ids[0]));
+  EXPECT_EQ(num_pages, reopened.AllocatePage());
+  reopened.Close();
+  remove(db_name.c_str());
+}
@@ -0,0 +1,57 @@
+#include "buffer/page_class_replacer.h"
+#include "gtest/gtest.h"
+
+TEST(PageClassReplacerTest, SampleTest) {
+  PageClassReplacer replacer(ReplacerType::kLRU, 8);
+
+  // Scenario: frames 0-1 hold internal pages, 2 a leaf, 3-5 heap pages, all unpinned in that order.
+  for (frame_id_t frame_id = 0; frame_id < 6; frame_id++) {
+    replacer.Pin(frame_id);
+  }
+  replacer.SetFrameClass(0, PageClass::kIndexInternal);
+  replacer.SetFrameClass(1, PageClass::kIndexInternal);
+  replacer.SetFrameClass(2, PageClass::kIndexLeaf);
+  for (frame_id_t frame_id = 0; frame_id < 6; frame_id++) {
+    replacer.Unpin(frame_id);
+  }
+  EXPECT_EQ(6, replacer.Size());
+  EXPECT_EQ(2, replacer.GetResidentCount(PageClass::kIndexInternal));
+  EXPECT_EQ(1, replacer.GetResidentCount(PageClass::kIndexLeaf));
+  EXPECT_EQ(3, replacer.GetResidentCount(PageClass::kHeap));
+
+  // Scenario: the candidates follow the class order, heap pages first.
+  std::vector<frame_id_t> candidates;
+  replacer.GetVictimCandidates(6, &candidates);
+  EXPECT_EQ((std::vector<frame_id_t>{3, 4, 5, 2, 0, 1}), candidates);
+
+  // Scenario: heap pages go first although they were used more recently.
+  int value;
+  for (frame_id_t expected : {3, 4, 5, 2}) {
+    ASSERT_TRUE(replacer.Victim(&value));
+    EXPECT_EQ(expected, value);
+  }
+  EXPECT_EQ(3, replacer.GetEvictionCount(PageClass::kHeap));
+  EXPECT_EQ(1, replacer.GetEvictionCount(PageClass::kIndexLeaf));
+  EXPECT_EQ(0, replacer.GetResidentCount(PageClass::kHeap));
+
+  // Scenario: internal pages beyond half of the pool lose their protection.
+  for (frame_id_t frame_id = 2; frame_id < 6; frame_id++) {
+    replacer.Pin(frame_id);
+    replacer.SetFrameClass(frame_id, PageClass::kIndexInternal);
+  }
+  replacer.Pin(6);
+  replacer.Unpin(6);
+  EXPECT_EQ(6, replacer.GetResidentCount(PageClass::kIndexInternal));
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(0, value);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(1, value);
+  ASSERT_TRUE(replacer.Victim(&value));
+  EXPECT_EQ(6, value);
+  EXPECT_FALSE(replacer.Victim(&value));
+
+  // Scenario: removed frames are forgotten with their class.
+  replacer.Remove(2);
+  EXPECT_EQ(3, replacer.GetResidentCount(PageClass::kIndexInternal));
+  EXPECT_EQ(0, replacer.Size());
+}
@@ -0,0 +1,269 @@
+#include "buffer/parallel_buffer_pool_manager.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/instance.h"
+#include "gtest/gtest.h"
+
+TEST(ParallelBufferPoolManagerTest, ConcurrentNewFetchTest) {
+  const std::string db_name = "parallel_bpm_test.db";
+  const size_t num_instances = 4;
+  const size_t instance_pool_size = 16;
+  const int num_threads = 8;
+  const int pages_per_thread = 50;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *bpm = new ParallelBufferPoolManager(num_instances, instance_pool_size, disk_manager);
+  EXPECT_EQ(num_instances * instance_pool_size, bpm->GetPoolSize());
+
+  // Scenario: every thread creates its own pages and stamps them with the page id.
+  std::vector<std::vector<page_id_t>> thread_pages(num_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < pages_per_thread; i++) {
+        page_id_t page_id;
+        Page *page = bpm->NewPage(page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+        thread_pages[t].push_back(page_id);
+        ASSERT_TRUE(bpm->UnpinPage(page_id, true));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // Scenario: all page ids are distinct and the content survives eviction.
+  std::vector<bool> seen(num_threads * pages_per_thread + 2, false);
+  for (auto &pages : thread_pages) {
+    for (auto page_id : pages) {
+      ASSERT_FALSE(seen[page_id]);
+      seen[page_id] = true;
+    }
+  }
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      char expected[PAGE_SIZE];
+      for (auto page_id : thread_pages[(t + 1) % num_threads]) {
+        Page *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+        EXPECT_STREQ(expected, page->GetData());
+        ASSERT_TRUE(bpm->UnpinPage(page_id, false));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(bpm->CheckAllUnpinned());
+
+  // Scenario: a checkpoint writes the dirty pages of every instance in one batch.
+  bpm->FlushAllPages();
+  char expected[PAGE_SIZE];
+  char data[PAGE_SIZE];
+  for (auto &pages : thread_pages) {
+    for (auto page_id : pages) {
+      disk_manager->ReadPage(page_id, data);
+      snprintf(expected, PAGE_SIZE, "page-%d", page_id);
+      ASSERT_STREQ(expected, data);
+    }
+  }
+
+  delete bpm;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, FewerFramesThanInstancesTest) {
+  const std::string db_name = "parallel_bpm_small_test.db";
+  const uint32_t pool_size = 3;
+  const uint32_t num_instances = 8;
+
+  // Scenario: the engine opens fewer instances rather than leaving some of them without a frame.
+  auto *engine = new DBStorageEngine(db_name, true, pool_size, num_instances);
+  BufferPoolManager *bpm = engine->bpm_;
+  EXPECT_EQ(pool_size, bpm->GetPoolSize());
+  std::vector<page_id_t> page_ids;
+  for (int i = 0; i < 20; i++) {
+    page_id_t page_id;
+    Page *page = bpm->NewPage(page_id);
+    ASSERT_NE(nullptr, page);
+    snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+    page_ids.push_back(page_id);
+    ASSERT_TRUE(bpm->UnpinPage(page_id, true));
+  }
+  for (auto page_id : page_ids) {
+    Page *page = bpm->FetchPage(page_id);
+    ASSERT_NE(nullptr, page);
+    EXPECT_EQ("page-" + std::to_string(page_id), std::string(page->GetData()));
+    bpm->UnpinPage(page_id, false);
+  }
+
+  delete engine;
+  remove(("./databases/" + db_name).c_str());
+  remove(("./databases/" + db_name + WARM_START_FILE_SUFFIX).c_str());
+
+  // Scenario: shrinking below one frame per instance keeps a frame in every instance.
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  auto *parallel = new ParallelBufferPoolManager(4, 2, disk_manager, ReplacerType::kLRU, 2);
+  EXPECT_EQ(4, parallel->Resize(2));
+  EXPECT_EQ(4, parallel->GetPoolSize());
+  delete parallel;
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+/**
+ * Fetch/unpin throughput with a fully cached working set, so the numbers only reflect latch contention.
+ */
+static double MeasureFetchThroughput(BufferPoolManager *bpm, const std::vector<page_id_t> &page_ids, int num_threads,
+                                     int ops_per_thread) {
+  std::vector<std::thread> threads;
+  std::atomic<bool> start{false};
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<size_t> dist(0, page_ids.size() - 1);
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < ops_per_thread; i++) {
+        page_id_t page_id = page_ids[dist(rng)];
+        bpm->FetchPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  return num_threads * ops_per_thread / elapsed.count();
+}
+
+/**
+ * Fetch and unpin random pages of a fully cached working set from num_threads threads at once, every page must hold
+ * "page-<page id>".
+ */
+static void FetchConcurrently(BufferPoolManager *bpm, const std::vector<page_id_t> &page_ids, int num_threads,
+                              int ops_per_thread) {
+  std::vector<std::thread> threads;
+  std::atomic<bool> start{false};
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      std::uniform_int_distribution<size_t> dist(0, page_ids.size() - 1);
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      for (int i = 0; i < ops_per_thread; i++) {
+        page_id_t page_id = page_ids[dist(rng)];
+        Page *page = bpm->FetchPage(page_id);
+        ASSERT_NE(nullptr, page);
+        EXPECT_EQ("page-" + std::to_string(page_id), std::string(page->GetData()));
+        bpm->UnpinPage(page_id, false);
+      }
+    });
+  }
+  start.store(true);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(ParallelBufferPoolManagerTest, ConcurrentFetchUnpinTest) {
+  const std::string db_name = "parallel_bpm_fetch_test.db";
+  const size_t total_frames = 256;
+  const size_t num_pages = 128;
+  const int ops_per_thread = 2000;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    BufferPoolManagerInstance loader(total_frames, disk_manager);
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      Page *page = loader.NewPage(page_id);
+      ASSERT_NE(nullptr, page);
+      snprintf(page->GetData(), PAGE_SIZE, "page-%d", page_id);
+      loader.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  // Scenario: once the working set is cached, concurrent fetches of a single and a partitioned pool are all hits.
+  for (int num_threads : {1, 8}) {
+    BufferPoolManagerInstance single(total_frames, disk_manager);
+    ParallelBufferPoolManager parallel(16, total_frames / 16, disk_manager);
+    BufferPoolManager *pools[] = {&single, &parallel};
+    for (auto bpm : pools) {
+      for (auto page_id : page_ids) {
+        bpm->FetchPage(page_id);
+        bpm->UnpinPage(page_id, false);
+      }
+      FetchConcurrently(bpm, page_ids, num_threads, ops_per_thread);
+      EXPECT_EQ(num_pages, bpm->GetMissCount());
+      EXPECT_EQ(num_threads * ops_per_thread, bpm->GetHitCount());
+      EXPECT_TRUE(bpm->CheckAllUnpinned());
+    }
+  }
+
+  delete disk_manager;
+  remove(db_name.c_str());
+}
+
+TEST(ParallelBufferPoolManagerTest, DISABLED_FetchUnpinThroughputBenchmark) {
+  const std::string db_name = "parallel_bpm_bench.db";
+  const size_t total_frames = 1024;
+  const size_t num_pages = 512;
+  const int ops_per_thread = 20000;
+
+  remove(db_name.c_str());
+  auto *disk_manager = new DiskManager(db_name);
+  std::vector<page_id_t> page_ids;
+  {
+    BufferPoolManagerInstance loader(total_frames, disk_manager);
+    for (size_t i = 0; i < num_pages; i++) {
+      page_id_t page_id;
+      ASSERT_NE(nullptr, loader.NewPage(page_id));
+      loader.UnpinPage(page_id, true);
+      page_ids.push_back(page_id);
+    }
+  }
+
+  printf("%-8s %18s %18s\n", "threads", "single (ops/s)", "16 instances (ops/s)");
+  for (int num_threads : {1, 2, 4, 8, 16}) {
+    BufferPoolManagerInstance single(total_frames, disk_manager);
+    ParallelBufferPoolManager parallel(16, total_frames / 16, disk_manager);
+    // warm both pools so that the measurement does not include disk reads
+    for (auto page_id : page_ids) {
+      single.FetchPage(page_id);
+      single.UnpinPage(page_id, false);
+      parallel.FetchPage(page_id);
+      parallel.UnpinPage(page_id, false);
+    }
+    double single_ops = MeasureFetchThroughput(&single, page_ids, num_threads, ops_per_thread);
+    double parallel_ops = MeasureFetchThroughput(&parallel, page_ids, num_threads, ops_per_thread);
+    printf("%-8d %18.0f %18.0f\n", num_threads, single_ops, parallel_ops);
+    EXPECT_TRUE(single.CheckAllUnpinned());
+    EXPECT_TRUE(parallel.CheckAllUnpinned());
+  }
+
+  delete disk_manager;
+  remove(db_name.c_str());
+}
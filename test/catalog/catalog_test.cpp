@@ -1,5 +1,9 @@
 #include "catalog/catalog.h"
 
+#include <algorithm>
+#include <chrono>
+#include <set>
+
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "utils/utils.h"
@@ -58,6 +62,8 @@ TEST(CatalogTest, CatalogTableTest) {
   ASSERT_EQ(table_info, table_info_02);
   auto *table_heap = table_info->GetTableHeap();
   ASSERT_TRUE(table_heap != nullptr);
+  page_id_t fsm_page_id = table_heap->GetFreeSpaceMapPageId();
+  ASSERT_NE(INVALID_PAGE_ID, fsm_page_id);
   delete db_01;
   /** Stage 2: Testing catalog loading */
   auto db_02 = new DBStorageEngine(db_file_name, false);
@@ -65,6 +71,8 @@ TEST(CatalogTest, CatalogTableTest) {
   TableInfo *table_info_03 = nullptr;
   ASSERT_EQ(DB_TABLE_NOT_EXIST, catalog_02->GetTable("table-2", table_info_03));
   ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("table-1", table_info_03));
+  // the free space map is loaded, not built again
+  EXPECT_EQ(fsm_page_id, table_info_03->GetTableHeap()->GetFreeSpaceMapPageId());
   delete db_02;
 }
 
@@ -127,4 +135,272 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+TEST(CatalogTest, ReadOnlyTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = new Schema(columns);
+  Transaction txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", schema, &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+  const int row_nums = 2000;
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(row, row.GetRowId(), &txn));
+  }
+  delete db_01;
+
+  // Scenario: a read-only engine loads the catalog and scans the table from the mapping of the file.
+  auto db_02 = new DBStorageEngine(db_file_name, false, DEFAULT_BUFFER_POOL_SIZE, DEFAULT_BUFFER_POOL_INSTANCES,
+                                   ReplacerType::kLRUK, 0, true);
+  ASSERT_EQ(DB_SUCCESS, db_02->catalog_mgr_->GetTable("table-1", table_info));
+  auto *table_heap = table_info->GetTableHeap();
+  int expected = 0;
+  for (auto it = table_heap->Begin(&txn); it != table_heap->End(); ++it) {
+    ASSERT_EQ(std::to_string(expected++), it->GetField(0)->toString());
+  }
+  EXPECT_EQ(row_nums, expected);
+  ASSERT_EQ(DB_SUCCESS, db_02->catalog_mgr_->GetIndex("table-1", "index-1", index_info));
+  std::vector<RowId> result;
+  std::vector<Field> key_fields{Field(TypeId::kTypeInt, row_nums / 2)};
+  Row key(key_fields);
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, result, &txn));
+  ASSERT_EQ(1, result.size());
+
+  // Scenario: writes fail instead of changing the file.
+  std::vector<Field> fields{Field(TypeId::kTypeInt, row_nums)};
+  Row row(fields);
+  EXPECT_FALSE(table_heap->InsertTuple(row, &txn));
+  EXPECT_EQ(DB_FAILED, index_info->GetIndex()->InsertEntry(row, RowId(0, 0), &txn));
+  EXPECT_FALSE(table_heap->MarkDelete(table_heap->Begin(&txn)->GetRowId(), &txn));
+  EXPECT_EQ(DB_FAILED, db_02->catalog_mgr_->DropTable("table-1"));
+  delete db_02;
+}
+
+TEST(CatalogTest, VacuumTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 200, 1, true, false)};
+  auto schema = new Schema(columns);
+  Transaction txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", schema, &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+  auto *table_heap = table_info->GetTableHeap();
+  auto count_pages = [&] {
+    std::set<page_id_t> page_ids;
+    for (auto it = table_heap->Begin(&txn); it != table_heap->End(); ++it) page_ids.insert(it->GetRowId().GetPageId());
+    return page_ids.size();
+  };
+  const int row_nums = 3000;
+  char name[200];
+  memset(name, 'x', sizeof(name));
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, &txn));
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, i)};
+    Row key(key_fields);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key, row.GetRowId(), &txn));
+    rids.push_back(row.GetRowId());
+  }
+  size_t pages_before = count_pages();
+
+  // Scenario: after deleting nine rows out of ten, the survivors are packed into about a tenth of the pages.
+  for (int i = 0; i < row_nums; i++) {
+    if (i % 10 == 0) continue;
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, i)};
+    Row key(key_fields);
+    ASSERT_TRUE(table_heap->MarkDelete(rids[i], &txn));
+    table_heap->ApplyDelete(rids[i], &txn);
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->RemoveEntry(key, rids[i], &txn));
+  }
+  size_t freed_pages = 0;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->VacuumTable("table-1", &txn, &freed_pages));
+  size_t pages_after = count_pages();
+  EXPECT_EQ(pages_before, pages_after + freed_pages);
+  EXPECT_LE(pages_after, pages_before / 10 + 1);
+
+  // Scenario: every surviving row is still found through the index at its new place.
+  int rows = 0;
+  for (auto it = table_heap->Begin(&txn); it != table_heap->End(); ++it) {
+    int id = std::stoi(it->GetField(0)->toString());
+    ASSERT_EQ(0, id % 10);
+    std::vector<Field> key_fields{Field(TypeId::kTypeInt, id)};
+    Row key(key_fields);
+    std::vector<RowId> result;
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, result, &txn));
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(it->GetRowId(), result[0]);
+    rows++;
+  }
+  EXPECT_EQ(row_nums / 10, rows);
+
+  // Scenario: a compact table has nothing left to free, an unknown table is reported.
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->VacuumTable("table-1", &txn, &freed_pages));
+  EXPECT_EQ(0, freed_pages);
+  EXPECT_EQ(DB_TABLE_NOT_EXIST, db_01->catalog_mgr_->VacuumTable("table-2", &txn));
+  delete db_01;
+}
+
+TEST(CatalogTest, BulkInsertTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, false, false)};
+  auto schema = new Schema(columns);
+  Transaction txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", schema, &txn, table_info));
+  IndexInfo *id_index = nullptr, *name_index = nullptr;
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, id_index, "bptree"));
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-2", {"name"}, &txn, name_index, "bptree"));
+  auto make_row = [](int id, int name) {
+    std::string str = "name-" + std::to_string(name);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id),
+                              Field(TypeId::kTypeChar, const_cast<char *>(str.c_str()), str.size(), true)};
+    return Row(fields);
+  };
+  auto lookup = [&](IndexInfo *index_info, const Field &field) {
+    std::vector<Field> key_fields{Field(field)};
+    std::vector<RowId> result;
+    index_info->GetIndex()->ScanKey(Row(key_fields), result, &txn);
+    return result;
+  };
+  auto count_rows = [&] {
+    int rows = 0;
+    for (auto it = table_info->GetTableHeap()->Begin(&txn); it != table_info->GetTableHeap()->End(); ++it) rows++;
+    return rows;
+  };
+  // the keys come in random order, the indexes get them sorted
+  const int row_nums = 5000;
+  std::vector<int> ids(row_nums);
+  for (int i = 0; i < row_nums; i++) ids[i] = i;
+  std::random_shuffle(ids.begin(), ids.end());
+  std::vector<Row> rows;
+  for (int id : ids) rows.push_back(make_row(id, id));
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->BulkInsert("table-1", rows, &txn));
+  for (auto &row : rows) {
+    auto result = lookup(id_index, *row.GetField(0));
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(row.GetRowId(), result[0]);
+    result = lookup(name_index, *row.GetField(1));
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(row.GetRowId(), result[0]);
+  }
+  EXPECT_EQ(row_nums, count_rows());
+
+  // Scenario: a key that is already in an index, or twice in the batch, fails the batch and nothing of it stays.
+  std::vector<Row> existing = {make_row(row_nums, row_nums), make_row(0, row_nums + 1)};
+  EXPECT_EQ(DB_FAILED, db_01->catalog_mgr_->BulkInsert("table-1", existing, &txn));
+  std::vector<Row> twice = {make_row(row_nums, row_nums), make_row(row_nums + 1, row_nums)};
+  EXPECT_EQ(DB_FAILED, db_01->catalog_mgr_->BulkInsert("table-1", twice, &txn));
+  EXPECT_TRUE(lookup(id_index, Field(TypeId::kTypeInt, row_nums)).empty());
+  EXPECT_TRUE(lookup(id_index, Field(TypeId::kTypeInt, row_nums + 1)).empty());
+  EXPECT_EQ(row_nums, count_rows());
+
+  // Scenario: the rows of a failed batch leave free space behind that the next batch fills.
+  std::vector<Row> more = {make_row(row_nums, row_nums), make_row(row_nums + 1, row_nums + 1)};
+  ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->BulkInsert("table-1", more, &txn));
+  EXPECT_EQ(1, lookup(name_index, *more[1].GetField(1)).size());
+  EXPECT_EQ(row_nums + 2, count_rows());
+  EXPECT_EQ(DB_TABLE_NOT_EXIST, db_01->catalog_mgr_->BulkInsert("table-2", more, &txn));
+  delete db_01;
+}
+
+TEST(CatalogTest, BulkLoadTest) {
+  const int row_nums = 2000;
+  std::vector<int> ids(row_nums);
+  for (int i = 0; i < row_nums; i++) ids[i] = i;
+  std::random_shuffle(ids.begin(), ids.end());
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  // Scenario: a bulk load leaves the table and its index as inserting the rows one by one does.
+  for (bool bulk : {false, true}) {
+    auto db_01 = new DBStorageEngine(db_file_name, true);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+    Transaction txn;
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", new Schema(columns), &txn, table_info));
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+    std::vector<Row> rows;
+    for (int id : ids) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, name, sizeof(name), true)};
+      if (bulk) {
+        rows.emplace_back(fields);
+        continue;
+      }
+      // what an INSERT statement does for every row
+      Row row(fields);
+      std::vector<Field> key_fields{Field(TypeId::kTypeInt, id)};
+      Row key(key_fields);
+      std::vector<RowId> result;
+      ASSERT_EQ(DB_KEY_NOT_FOUND, index_info->GetIndex()->ScanKey(key, result, &txn));
+      ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key, row.GetRowId(), &txn));
+    }
+    if (bulk) {
+      ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->BulkInsert("table-1", rows, &txn));
+    }
+    for (int id = 0; id < row_nums; id++) {
+      std::vector<Field> key_fields{Field(TypeId::kTypeInt, id)};
+      Row key(key_fields);
+      std::vector<RowId> result;
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(key, result, &txn));
+      Row row(result.at(0));
+      ASSERT_TRUE(table_info->GetTableHeap()->GetTuple(&row, &txn));
+      EXPECT_EQ(std::to_string(id), row.GetField(0)->toString());
+    }
+    delete db_01;
+  }
+}
+
+TEST(CatalogTest, DISABLED_BulkInsertBenchmark) {
+  const int row_nums = 20000;
+  std::vector<int> ids(row_nums);
+  for (int i = 0; i < row_nums; i++) ids[i] = i;
+  std::random_shuffle(ids.begin(), ids.end());
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  printf("%-10s %12s\n", "load", "rows/s");
+  for (bool bulk : {false, true}) {
+    auto db_01 = new DBStorageEngine(db_file_name, true);
+    std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                     new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+    Transaction txn;
+    TableInfo *table_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateTable("table-1", new Schema(columns), &txn, table_info));
+    IndexInfo *index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->CreateIndex("table-1", "index-1", {"id"}, &txn, index_info, "bptree"));
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<Row> rows;
+    for (int id : ids) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, name, sizeof(name), true)};
+      if (bulk) {
+        rows.emplace_back(fields);
+        continue;
+      }
+      // what an INSERT statement does for every row
+      Row row(fields);
+      std::vector<Field> key_fields{Field(TypeId::kTypeInt, id)};
+      Row key(key_fields);
+      std::vector<RowId> result;
+      ASSERT_EQ(DB_KEY_NOT_FOUND, index_info->GetIndex()->ScanKey(key, result, &txn));
+      ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->InsertEntry(key, row.GetRowId(), &txn));
+    }
+    if (bulk) {
+      ASSERT_EQ(DB_SUCCESS, db_01->catalog_mgr_->BulkInsert("table-1", rows, &txn));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    printf("%-10s %12.0f\n", bulk ? "bulk" : "per row", row_nums / elapsed.count());
+    delete db_01;
+  }
+}
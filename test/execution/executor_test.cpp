@@ -8,6 +8,31 @@
 #include "executor/plans/values_plan.h"
 #include "executor_test_util.h"  // NOLINT
 
+extern "C" {
+int yyparse(void);
+#include "parser/minisql_lex.h"
+}
+
+/**
+ * Parse and execute one statement the way the shell does
+ * @param[out] output what the statement printed
+ */
+static dberr_t ExecuteSql(ExecuteEngine *engine, const std::string &sql, std::string *output = nullptr) {
+  YY_BUFFER_STATE bp = yy_scan_string(sql.c_str());
+  yy_switch_to_buffer(bp);
+  MinisqlParserInit();
+  yyparse();
+  EXPECT_FALSE(MinisqlParserGetError()) << sql;
+  testing::internal::CaptureStdout();
+  dberr_t result = engine->Execute(MinisqlGetParserRootNode());
+  std::string printed = testing::internal::GetCapturedStdout();
+  if (output != nullptr) *output = printed;
+  MinisqlParserFinish();
+  yy_delete_buffer(bp);
+  yylex_destroy();
+  return result;
+}
+
 // SELECT id FROM table-1 WHERE id < 500
 TEST_F(ExecutorTest, SimpleSeqScanTest) {
   // Construct query plan
@@ -155,3 +180,84 @@ TEST_F(ExecutorTest, SimpleUpdateTest) {
     ASSERT_TRUE(row.GetField(1)->CompareEquals(Field(kTypeChar, const_cast<char *>("minisql"), 7, false)));
   }
 }
+
+// VACUUM t; and VACUUM; from the parser down to the table heap
+TEST(ExecuteEngineTest, VacuumSqlTest) {
+  ExecuteEngine engine;
+  std::string output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "create database vacuum_sql_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "use vacuum_sql_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "create table t(id int, name char(64), primary key(id));"));
+  // a few pages of rows, few enough keys that the primary index stays a single leaf
+  std::string name(60, 'x');
+  for (int i = 0; i < 150; i++) {
+    ASSERT_EQ(DB_SUCCESS,
+              ExecuteSql(&engine, "insert into t values(" + std::to_string(i) + ", \"" + name + "\");"));
+  }
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "delete from t where id >= 30;", &output));
+
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "vacuum t;", &output));
+  size_t freed_pages = 0;
+  ASSERT_EQ(1, sscanf(output.c_str(), "Table 't' vacuumed, %zu pages freed.", &freed_pages)) << output;
+  EXPECT_GT(freed_pages, 0);
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "vacuum;", &output));
+  ASSERT_EQ(1, sscanf(output.c_str(), "Table 't' vacuumed, %zu pages freed.", &freed_pages)) << output;
+  EXPECT_EQ(0, freed_pages);
+  EXPECT_EQ(DB_TABLE_NOT_EXIST, ExecuteSql(&engine, "vacuum missing;"));
+
+  // vacuum is still usable as a name
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "create table vacuum(vacuum int, primary key(vacuum));"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "insert into vacuum values(1);"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "vacuum vacuum;", &output));
+  EXPECT_NE(std::string::npos, output.find("Table 'vacuum' vacuumed")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select vacuum from vacuum where vacuum = 1;", &output));
+  EXPECT_NE(std::string::npos, output.find("1 row in set")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "drop table vacuum;"));
+
+  // the rows that are left are all still there
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select id from t;", &output));
+  EXPECT_NE(std::string::npos, output.find("30 row in set")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select id from t where id = 29;", &output));
+  EXPECT_NE(std::string::npos, output.find("1 row in set")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "drop database vacuum_sql_test;"));
+}
+
+// LOAD DATA through the parser, load and data are still usable as names
+TEST(ExecuteEngineTest, LoadDataSqlTest) {
+  ExecuteEngine engine;
+  std::string output;
+  const std::string file_name = "load_data_sql_test.csv";
+  auto write_file = [&](const std::string &content) {
+    std::ofstream file(file_name, std::ios::trunc);
+    file << content;
+  };
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "create database load_data_sql_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "use load_data_sql_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "create table data(load int, name char(16), primary key(load));"));
+  write_file("1,a\n2,\"b,c\"\n3,\n");
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "load data \"" + file_name + "\" into data;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select load from data where load >= 2;", &output));
+  EXPECT_NE(std::string::npos, output.find("2 row in set")) << output;
+
+  // a number followed by anything else is rejected, not cut short
+  write_file("4,d\n5x,e\n");
+  EXPECT_EQ(DB_FAILED, ExecuteSql(&engine, "load data \"" + file_name + "\" into data;", &output));
+  EXPECT_NE(std::string::npos, output.find("Line 2: invalid value for column 'load'")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select load from data;", &output));
+  EXPECT_NE(std::string::npos, output.find("3 row in set")) << output;
+
+  // a failure in a later batch also removes the batches loaded before it, one full batch of 65536 rows here
+  std::string content;
+  for (int i = 100; i < 100 + 65536; i++) content += std::to_string(i) + ",x\n";
+  write_file(content + "100,dup\n");
+  EXPECT_EQ(DB_FAILED, ExecuteSql(&engine, "load data \"" + file_name + "\" into data;", &output));
+  EXPECT_NE(std::string::npos, output.find("Rows 65537 to 65537 not loaded")) << output;
+  EXPECT_NE(std::string::npos, output.find("0 rows loaded")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select load from data;", &output));
+  EXPECT_NE(std::string::npos, output.find("3 row in set")) << output;
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "select load from data where load = 100;", &output));
+  EXPECT_NE(std::string::npos, output.find("Empty set")) << output;
+
+  std::remove(file_name.c_str());
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine, "drop database load_data_sql_test;"));
+}
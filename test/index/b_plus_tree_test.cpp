@@ -70,4 +70,81 @@ TEST(BPlusTreeTests, SampleTest) {
     ASSERT_TRUE(tree.GetValue(delete_seq[i], ans));
     ASSERT_EQ(kv_map[delete_seq[i]], ans[ans.size() - 1]);
   }
-}
\ No newline at end of file
+}
+TEST(BPlusTreeTests, BulkLoadTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  BPlusTree tree(0, engine.bpm_, KP);
+  // enough keys for two levels of internal pages
+  const int n = 40000;
+  std::vector<char> keys(n * KP.GetKeySize());
+  vector<RowId> values;
+  auto key_at = [&](int i) { return reinterpret_cast<GenericKey *>(&keys[i * KP.GetKeySize()]); };
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key_at(i), Row(fields), table_schema);
+    values.push_back(RowId(i, 0));
+  }
+  ASSERT_TRUE(tree.BulkLoad(keys.data(), values));
+  ASSERT_FALSE(tree.BulkLoad(keys.data(), values));
+  ASSERT_TRUE(tree.Check());
+  // every key is found, a scan returns them in order
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    ASSERT_TRUE(tree.GetValue(key_at(i), ans));
+    ASSERT_EQ(values[i], ans.back());
+  }
+  int i = 0;
+  for (auto it = tree.Begin(); it != tree.End(); ++it) {
+    ASSERT_EQ(values[i++], (*it).second);
+  }
+  ASSERT_EQ(n, i);
+  // the built tree splits and merges like any other
+  for (i = 0; i < n; i += 2) tree.Remove(key_at(i));
+  for (i = 0; i < n; i += 4) ASSERT_TRUE(tree.Insert(key_at(i), values[i]));
+  ans.clear();
+  for (i = 0; i < n; i++) {
+    ASSERT_EQ(i % 4 != 2, tree.GetValue(key_at(i), ans));
+  }
+  ASSERT_TRUE(tree.Check());
+}
+
+TEST(BPlusTreeTests, RemoveAllTest) {
+  DBStorageEngine engine(db_name);
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  KeyManager KP(table_schema, 16);
+  BPlusTree tree(0, engine.bpm_, KP);
+  // enough keys for two levels of internal pages, removed in random order until the tree is empty
+  const int n = 40000;
+  std::vector<char> keys(n * KP.GetKeySize());
+  vector<RowId> values;
+  auto key_at = [&](int i) { return reinterpret_cast<GenericKey *>(&keys[i * KP.GetKeySize()]); };
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    KP.SerializeFromKey(key_at(i), Row(fields), table_schema);
+    values.push_back(RowId(i, 0));
+  }
+  ASSERT_TRUE(tree.BulkLoad(keys.data(), values));
+  vector<int> delete_seq;
+  for (int i = 0; i < n; i++) delete_seq.push_back(i);
+  ShuffleArray(delete_seq);
+  vector<RowId> ans;
+  for (int i = 0; i < n; i++) {
+    tree.Remove(key_at(delete_seq[i]));
+    // the root shrinks level by level near the end
+    if (n - i <= 200) {
+      ASSERT_TRUE(tree.Check());
+      ASSERT_FALSE(tree.GetValue(key_at(delete_seq[i]), ans));
+      if (i + 1 < n) ASSERT_TRUE(tree.GetValue(key_at(delete_seq[i + 1]), ans));
+    }
+  }
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_TRUE(engine.bpm_->CheckAllUnpinned());
+}
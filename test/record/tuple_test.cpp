@@ -1,10 +1,15 @@
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "page/table_page.h"
 #include "record/field.h"
 #include "record/row.h"
+#include "record/row_view.h"
 #include "record/schema.h"
 
 char *chars[] = {const_cast<char *>(""), const_cast<char *>("hello"), const_cast<char *>("world!"),
@@ -100,4 +105,242 @@ TEST(TupleTest, RowTest) {
   }
   ASSERT_TRUE(table_page.MarkDelete(row.GetRowId(), nullptr, nullptr, nullptr));
   table_page.ApplyDelete(row.GetRowId(), nullptr, nullptr);
-}
\ No newline at end of file
+}
+TEST(TupleTest, RowViewTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false),
+                                   new Column("note", TypeId::kTypeChar, 16, 3, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeFloat), Field(TypeId::kTypeChar, chars[2], strlen(chars[2]), false)};
+  Row row(fields);
+  char buffer[PAGE_SIZE];
+  uint32_t size = row.SerializeTo(buffer, schema.get());
+  RowView view(buffer, schema.get(), RowId(3, 7));
+  ASSERT_EQ(4, view.GetFieldCount());
+  EXPECT_EQ(RowId(3, 7), view.GetRowId());
+  // fields are decoded in any order, the null one takes no bytes
+  EXPECT_EQ(CmpBool::kTrue, view.GetField(3).CompareEquals(fields[3]));
+  EXPECT_TRUE(view.IsNull(2));
+  EXPECT_TRUE(view.GetField(2).IsNull());
+  EXPECT_EQ(CmpBool::kTrue, view.GetField(0).CompareEquals(fields[0]));
+  // CHAR data is not copied
+  Field name = view.GetField(1);
+  EXPECT_EQ(CmpBool::kTrue, name.CompareEquals(fields[1]));
+  EXPECT_TRUE(name.GetData() > buffer && name.GetData() < buffer + size);
+
+  // Scenario: materialized rows own their data, they do not change with the bytes.
+  Row copy, projected;
+  view.ToRow(&copy);
+  view.ToRow(&projected, {3, 0});
+  memset(buffer, 0, sizeof(buffer));
+  ASSERT_EQ(4, copy.GetFieldCount());
+  EXPECT_EQ(RowId(3, 7), copy.GetRowId());
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (fields[i].IsNull()) {
+      EXPECT_TRUE(copy.GetField(i)->IsNull());
+    } else {
+      EXPECT_EQ(CmpBool::kTrue, copy.GetField(i)->CompareEquals(fields[i]));
+    }
+  }
+  ASSERT_EQ(2, projected.GetFieldCount());
+  EXPECT_EQ(CmpBool::kTrue, projected.GetField(0)->CompareEquals(fields[3]));
+  EXPECT_EQ(CmpBool::kTrue, projected.GetField(1)->CompareEquals(fields[0]));
+}
+
+TEST(TupleTest, RowFormatTest) {
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 64, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, false),
+                                   new Column("empty", TypeId::kTypeChar, 16, 2, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 3, true, false),
+                                   new Column("note", TypeId::kTypeChar, 16, 4, true, false),
+                                   new Column("score", TypeId::kTypeInt, 5, true, false),
+                                   new Column("tag", TypeId::kTypeChar, 16, 6, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  EXPECT_EQ(12, schema->GetFixedSize());
+  EXPECT_EQ(4, schema->GetCharCount());
+  EXPECT_EQ(4, schema->GetFieldSlot(3));
+  EXPECT_EQ(3, schema->GetFieldSlot(6));
+  std::vector<Field> fields = {Field(TypeId::kTypeChar, const_cast<char *>("minisql"), strlen("minisql"), false),
+                               Field(TypeId::kTypeInt, -65537),
+                               Field(TypeId::kTypeChar, chars[0], 0, false),
+                               Field(TypeId::kTypeFloat, 19.99f),
+                               Field(TypeId::kTypeChar),
+                               Field(TypeId::kTypeInt),
+                               Field(TypeId::kTypeChar, chars[2], strlen(chars[2]), false)};
+  Row row(fields);
+  char fixed[PAGE_SIZE], legacy[PAGE_SIZE];
+  uint32_t fixed_size = row.SerializeTo(fixed, schema.get());
+  uint32_t legacy_size = row.SerializeTo(legacy, schema.get(), kRowFormatLegacy);
+  ASSERT_EQ(row.GetSerializedSize(schema.get()), fixed_size);
+  ASSERT_EQ(row.GetSerializedSize(schema.get(), kRowFormatLegacy), legacy_size);
+  EXPECT_EQ(kRowFormatFixed, Row::GetFormat(fixed));
+  EXPECT_EQ(kRowFormatLegacy, Row::GetFormat(legacy));
+  EXPECT_EQ(7, Row::GetFieldCount(fixed));
+
+  // Scenario: both formats read back the same fields, as rows and as views.
+  for (char *buf : {fixed, legacy}) {
+    Row copy;
+    ASSERT_EQ(buf == fixed ? fixed_size : legacy_size, copy.DeserializeFrom(buf, schema.get()));
+    RowView view(buf, schema.get());
+    for (uint32_t i = fields.size(); i-- > 0;) {
+      if (fields[i].IsNull()) {
+        EXPECT_TRUE(copy.GetField(i)->IsNull());
+        EXPECT_TRUE(view.GetField(i).IsNull());
+      } else {
+        EXPECT_EQ(CmpBool::kTrue, copy.GetField(i)->CompareEquals(fields[i]));
+        EXPECT_EQ(CmpBool::kTrue, view.GetField(i).CompareEquals(fields[i]));
+        if (fields[i].GetTypeId() == TypeId::kTypeChar) {
+          EXPECT_EQ(fields[i].GetLength(), view.GetField(i).GetLength());
+        }
+      }
+    }
+  }
+}
+
+TEST(TupleTest, UpgradeTuplesTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  // A page written before the row format had versions, laid out by hand as the header of table_page.h describes.
+  TablePage table_page;
+  table_page.Init(0, INVALID_PAGE_ID, nullptr, nullptr);
+  char *data = table_page.GetData();
+  auto slot = [&](uint32_t i, uint32_t field) { return reinterpret_cast<uint32_t *>(data + 24 + 8 * i + field); };
+  const uint32_t tuple_count = 40;
+  std::vector<Row> rows;
+  uint32_t free_space_pointer = PAGE_SIZE;
+  for (uint32_t i = 0; i < tuple_count; i++) {
+    std::string name(i % 7, 'a' + i % 26);
+    std::vector<Field> fields = {
+        Field(TypeId::kTypeInt, static_cast<int32_t>(i)),
+        Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), static_cast<uint32_t>(name.size()), true),
+        i % 3 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, 0.5f * i)};
+    rows.emplace_back(fields);
+    rows.back().SetRowId(RowId(0, i));
+    uint32_t size = rows.back().GetSerializedSize(schema.get(), kRowFormatLegacy);
+    free_space_pointer -= size;
+    rows.back().SerializeTo(data + free_space_pointer, schema.get(), kRowFormatLegacy);
+    *slot(i, 0) = free_space_pointer;
+    *slot(i, 4) = size;
+  }
+  memcpy(data + 16, &free_space_pointer, sizeof(uint32_t));
+  memcpy(data + 20, &tuple_count, sizeof(uint32_t));
+  auto check = [&](uint32_t i) {
+    Row row(rows[i].GetRowId());
+    ASSERT_TRUE(table_page.GetTuple(&row, schema.get(), nullptr, nullptr));
+    for (uint32_t j = 0; j < 3; j++) {
+      if (rows[i].GetField(j)->IsNull()) {
+        EXPECT_TRUE(row.GetField(j)->IsNull());
+      } else {
+        EXPECT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(*rows[i].GetField(j)));
+      }
+    }
+  };
+
+  // Scenario: legacy tuples are read as they are, a marked delete keeps its bytes.
+  ASSERT_TRUE(table_page.MarkDelete(rows[5].GetRowId(), nullptr, nullptr, nullptr));
+  table_page.ApplyDelete(rows[9].GetRowId(), nullptr, nullptr);
+  for (uint32_t i = 0; i < tuple_count; i++) {
+    if (i != 5 && i != 9) check(i);
+  }
+  EXPECT_EQ(kRowFormatLegacy, Row::GetFormat(data + *slot(0, 0)));
+  EXPECT_EQ(kRowFormatLegacy, *reinterpret_cast<uint16_t *>(data + 18));
+
+  // Scenario: the first write upgrades the whole page, the new tuple takes the free slot.
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 99), Field(TypeId::kTypeChar, chars[1], 5, false),
+                               Field(TypeId::kTypeFloat, 1.5f)};
+  Row row(fields);
+  ASSERT_TRUE(table_page.InsertTuple(row, schema.get(), nullptr, nullptr, nullptr));
+  EXPECT_EQ(RowId(0, 9), row.GetRowId());
+  rows[9] = row;
+  uint32_t used = 24 + 8 * tuple_count + 8;
+  for (auto &tuple : rows) used += tuple.GetSerializedSize(schema.get());
+  EXPECT_EQ(PAGE_SIZE - used, table_page.GetFreeSpaceForInsert());
+  for (uint32_t i = 0; i < tuple_count; i++) {
+    EXPECT_EQ(kRowFormatFixed, Row::GetFormat(data + *slot(i, 0)));
+    if (i != 5) check(i);
+  }
+  table_page.RollbackDelete(rows[5].GetRowId(), nullptr, nullptr);
+  check(5);
+  EXPECT_TRUE(table_page.UpgradeTuples(schema.get()));
+
+  // Scenario: the page header records the upgrade, later writes do not look at the tuples again.
+  EXPECT_EQ(kRowFormatFixed, *reinterpret_cast<uint16_t *>(data + 18));
+  data[*slot(0, 0) + 3] = kRowFormatLegacy;  // the version is the top byte of the first word of a row
+  EXPECT_TRUE(table_page.UpgradeTuples(schema.get()));
+  EXPECT_EQ(kRowFormatLegacy, Row::GetFormat(data + *slot(0, 0)));
+
+  // Scenario: a new page starts out in the current format.
+  TablePage new_page;
+  new_page.Init(1, INVALID_PAGE_ID, nullptr, nullptr);
+  EXPECT_EQ(kRowFormatFixed, *reinterpret_cast<uint16_t *>(new_page.GetData() + 18));
+  EXPECT_EQ(PAGE_SIZE - 24 - 8, new_page.GetFreeSpaceForInsert());
+}
+
+TEST(TupleTest, ColumnAccessTest) {
+  // the column a predicate reads is the last of 16, after 8 CHAR columns
+  std::vector<Column *> columns;
+  std::vector<Field> fields;
+  char name[24];
+  memset(name, 'x', sizeof(name));
+  for (uint32_t i = 0; i < 16; i++) {
+    bool is_char = i % 2 == 0;
+    columns.push_back(is_char ? new Column("c" + std::to_string(i), TypeId::kTypeChar, 24, i, true, false)
+                              : new Column("c" + std::to_string(i), TypeId::kTypeInt, i, true, false));
+    fields.push_back(is_char ? Field(TypeId::kTypeChar, name, sizeof(name), false)
+                             : Field(TypeId::kTypeInt, static_cast<int32_t>(i)));
+  }
+  auto schema = std::make_shared<Schema>(columns);
+  Row row(fields);
+  // Scenario: every column reads back from either format, in any order and on a freshly reset view.
+  for (auto format : {kRowFormatLegacy, kRowFormatFixed}) {
+    char buf[PAGE_SIZE];
+    row.SerializeTo(buf, schema.get(), format);
+    RowView view;
+    for (int idx = 15; idx >= 0; idx--) {
+      view.Reset(buf, schema.get());
+      EXPECT_EQ(CmpBool::kTrue, view.GetField(idx).CompareEquals(fields[idx]));
+    }
+    view.Reset(buf, schema.get());
+    for (uint32_t idx = 0; idx < 16; idx++) {
+      EXPECT_EQ(CmpBool::kTrue, view.GetField(idx).CompareEquals(fields[idx]));
+    }
+  }
+}
+
+TEST(TupleTest, DISABLED_ColumnAccessBenchmark) {
+  // the column a predicate reads is the last of 16, after 8 CHAR columns
+  std::vector<Column *> columns;
+  std::vector<Field> fields;
+  char name[24];
+  memset(name, 'x', sizeof(name));
+  for (uint32_t i = 0; i < 16; i++) {
+    bool is_char = i % 2 == 0;
+    columns.push_back(is_char ? new Column("c" + std::to_string(i), TypeId::kTypeChar, 24, i, true, false)
+                              : new Column("c" + std::to_string(i), TypeId::kTypeInt, i, true, false));
+    fields.push_back(is_char ? Field(TypeId::kTypeChar, name, sizeof(name), false)
+                             : Field(TypeId::kTypeInt, static_cast<int32_t>(i)));
+  }
+  auto schema = std::make_shared<Schema>(columns);
+  Row row(fields);
+  const int rounds = 200000;
+  printf("%-12s %12s\n", "format", "ns/access");
+  for (auto format : {kRowFormatLegacy, kRowFormatFixed}) {
+    char buf[PAGE_SIZE];
+    row.SerializeTo(buf, schema.get(), format);
+    RowView view;
+    int matched = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      view.Reset(buf, schema.get());  // as if every access were to another tuple
+      matched += view.GetField(15).CompareEquals(fields[15]) == CmpBool::kTrue;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    ASSERT_EQ(rounds, matched);
+    printf("%-12s %12.1f\n", format == kRowFormatLegacy ? "legacy" : "fixed", elapsed.count() * 1e9 / rounds);
+  }
+}
@@ -0,0 +1,167 @@
+#include "storage/async_io.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+/**
+ * Write num_pages pages with one batch, read them back in reverse order with another, then read past the end.
+ */
+static void CheckEngine(AsyncIO *engine, const std::string &file_name) {
+  const size_t num_pages = 200;  // more than the queue depth, so the batch is fed in several rounds
+  remove(file_name.c_str());
+  int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  std::vector<char> out(num_pages * PAGE_SIZE);
+  std::vector<IORequest> writes;
+  for (size_t i = 0; i < num_pages; i++) {
+    memset(out.data() + i * PAGE_SIZE, static_cast<char>('a' + i % 26), PAGE_SIZE);
+    writes.push_back({fd, out.data() + i * PAGE_SIZE, PAGE_SIZE, i * PAGE_SIZE, true});
+  }
+  engine->Execute(&writes);
+  for (auto &request : writes) {
+    ASSERT_EQ(PAGE_SIZE, request.result_);
+  }
+
+  std::vector<char> in(num_pages * PAGE_SIZE);
+  std::vector<IORequest> reads;
+  for (size_t i = 0; i < num_pages; i++) {
+    size_t page = num_pages - 1 - i;
+    reads.push_back({fd, in.data() + i * PAGE_SIZE, PAGE_SIZE, page * PAGE_SIZE, false});
+  }
+  // Scenario: a read at the end of the file completes with 0 bytes instead of failing the batch.
+  char tail[PAGE_SIZE];
+  reads.push_back({fd, tail, PAGE_SIZE, num_pages * PAGE_SIZE, false});
+  engine->Execute(&reads);
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(PAGE_SIZE, reads[i].result_);
+    ASSERT_EQ(0, memcmp(in.data() + i * PAGE_SIZE, out.data() + (num_pages - 1 - i) * PAGE_SIZE, PAGE_SIZE));
+  }
+  EXPECT_EQ(0, reads.back().result_);
+
+  // Scenario: a vectored write gathers pages from scattered buffers, a vectored read scatters them back.
+  iovec gather[3] = {{out.data() + 5 * PAGE_SIZE, PAGE_SIZE},
+                     {out.data() + 2 * PAGE_SIZE, PAGE_SIZE},
+                     {out.data() + 7 * PAGE_SIZE, PAGE_SIZE}};
+  std::vector<IORequest> vectored = {{fd, nullptr, 3 * PAGE_SIZE, 0, true, 0, gather, 3}};
+  engine->Execute(&vectored);
+  ASSERT_EQ(3 * PAGE_SIZE, vectored[0].result_);
+  iovec scatter[3] = {{in.data() + 2 * PAGE_SIZE, PAGE_SIZE},
+                      {in.data(), PAGE_SIZE},
+                      {in.data() + PAGE_SIZE, PAGE_SIZE}};
+  vectored = {{fd, nullptr, 3 * PAGE_SIZE, 0, false, 0, scatter, 3}};
+  engine->Execute(&vectored);
+  ASSERT_EQ(3 * PAGE_SIZE, vectored[0].result_);
+  EXPECT_EQ(0, memcmp(in.data() + 2 * PAGE_SIZE, out.data() + 5 * PAGE_SIZE, PAGE_SIZE));
+  EXPECT_EQ(0, memcmp(in.data(), out.data() + 2 * PAGE_SIZE, PAGE_SIZE));
+  EXPECT_EQ(0, memcmp(in.data() + PAGE_SIZE, out.data() + 7 * PAGE_SIZE, PAGE_SIZE));
+
+  // Scenario: an empty batch returns at once.
+  std::vector<IORequest> empty;
+  engine->Execute(&empty);
+  close(fd);
+  remove(file_name.c_str());
+}
+
+TEST(AsyncIOTest, DefaultEngineTest) {
+  auto engine = AsyncIO::Create();
+  CheckEngine(engine.get(), "async_io_test.db");
+}
+
+TEST(AsyncIOTest, ThreadPoolEngineTest) {
+  auto engine = AsyncIO::Create(ASYNC_IO_QUEUE_DEPTH, false);
+  EXPECT_STREQ("thread pool", engine->Name());
+  CheckEngine(engine.get(), "async_io_pool_test.db");
+}
+
+TEST(AsyncIOTest, BatchReadTest) {
+  const std::string file_name = "async_io_batch_test.db";
+  const size_t num_pages = 512;
+  const size_t batch_size = 128;
+  remove(file_name.c_str());
+  int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  std::vector<char> data(num_pages * PAGE_SIZE);
+  for (size_t i = 0; i < num_pages; i++) {
+    memset(data.data() + i * PAGE_SIZE, static_cast<char>('a' + i % 26), PAGE_SIZE);
+  }
+  ASSERT_EQ(static_cast<ssize_t>(data.size()), pwrite(fd, data.data(), data.size(), 0));
+
+  // Scenario: batches of random reads return the same pages from every engine as serial reads do.
+  auto io_uring = AsyncIO::Create();
+  auto thread_pool = AsyncIO::Create(ASYNC_IO_QUEUE_DEPTH, false);
+  std::mt19937 rng(0);
+  std::vector<char> in(batch_size * PAGE_SIZE);
+  for (AsyncIO *engine : {static_cast<AsyncIO *>(nullptr), io_uring.get(), thread_pool.get()}) {
+    for (size_t done = 0; done < num_pages; done += batch_size) {
+      std::vector<IORequest> batch;
+      std::vector<size_t> pages;
+      for (size_t i = 0; i < batch_size; i++) {
+        pages.push_back(rng() % num_pages);
+        batch.push_back({fd, in.data() + i * PAGE_SIZE, PAGE_SIZE, pages.back() * PAGE_SIZE, false});
+      }
+      if (engine != nullptr) {
+        engine->Execute(&batch);
+      } else {
+        for (auto &request : batch) {
+          request.result_ = pread(fd, request.buf_, request.size_, request.offset_);
+        }
+      }
+      for (size_t i = 0; i < batch_size; i++) {
+        ASSERT_EQ(PAGE_SIZE, batch[i].result_);
+        ASSERT_EQ(0, memcmp(in.data() + i * PAGE_SIZE, data.data() + pages[i] * PAGE_SIZE, PAGE_SIZE));
+      }
+    }
+  }
+  close(fd);
+  remove(file_name.c_str());
+}
+
+TEST(AsyncIOTest, DISABLED_BatchReadBenchmark) {
+  const std::string file_name = "async_io_bench.db";
+  const size_t num_pages = 4096;
+  const size_t batch_size = 256;
+  remove(file_name.c_str());
+  int fd = open(file_name.c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  std::vector<char> data(batch_size * PAGE_SIZE, 'x');
+  for (size_t i = 0; i < num_pages; i += batch_size) {
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), pwrite(fd, data.data(), data.size(), i * PAGE_SIZE));
+  }
+
+  auto io_uring = AsyncIO::Create();
+  auto thread_pool = AsyncIO::Create(ASYNC_IO_QUEUE_DEPTH, false);
+  std::mt19937 rng(0);
+  printf("%-12s %12s\n", "engine", "pages/s");
+  for (AsyncIO *engine : {static_cast<AsyncIO *>(nullptr), io_uring.get(), thread_pool.get()}) {
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < num_pages; done += batch_size) {
+      std::vector<IORequest> batch;
+      for (size_t i = 0; i < batch_size; i++) {
+        batch.push_back({fd, data.data() + i * PAGE_SIZE, PAGE_SIZE, (rng() % num_pages) * PAGE_SIZE, false});
+      }
+      if (engine != nullptr) {
+        engine->Execute(&batch);
+      } else {
+        for (auto &request : batch) {
+          request.result_ = pread(fd, request.buf_, request.size_, request.offset_);
+        }
+      }
+      for (auto &request : batch) {
+        ASSERT_EQ(PAGE_SIZE, request.result_);
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    printf("%-12s %12.0f\n", engine == nullptr ? "serial" : engine->Name(), num_pages / elapsed.count());
+  }
+  close(fd);
+  remove(file_name.c_str());
+}
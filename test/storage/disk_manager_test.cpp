@@ -1,6 +1,15 @@
 #include "storage/disk_manager.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <thread>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -56,4 +65,454 @@ TEST(DiskManagerTest, FreePageAllocationTest) {
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 2, meta_page->GetExtentUsedPage(0));
   EXPECT_EQ(DiskManager::BITMAP_SIZE - 3, meta_page->GetExtentUsedPage(1));
   remove(db_name.c_str());
-}
\ No newline at end of file
+}
+
+TEST(DiskManagerTest, AllocationOrderTest) {
+  std::string db_name = "disk_alloc_order_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const size_t num_pages = DiskManager::BITMAP_SIZE + 1000;
+
+  // Scenario: allocating pages over two extents hands them out in order.
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+
+  // Scenario: freed pages are reused lowest first, even after a restart.
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 5);
+  disk_mgr->DeAllocatePage(70);
+  disk_mgr->DeAllocatePage(7);
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_TRUE(disk_mgr->IsPageFree(7));
+  EXPECT_TRUE(disk_mgr->IsPageFree(70));
+  EXPECT_FALSE(disk_mgr->IsPageFree(71));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 5));
+  EXPECT_TRUE(disk_mgr->IsPageFree(num_pages));
+  EXPECT_EQ(7, disk_mgr->AllocatePage());
+  EXPECT_EQ(70, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 5, disk_mgr->AllocatePage());
+  EXPECT_EQ(num_pages, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, DISABLED_AllocationBenchmark) {
+  std::string db_name = "disk_alloc_bench.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const size_t num_pages = DiskManager::BITMAP_SIZE + 1000;
+
+  // Scenario: allocating pages over two extents hands them out in order.
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  printf("%-20s %12.0f pages/s\n", "allocate", num_pages / elapsed.count());
+
+  // Scenario: freed pages are reused lowest first, even after a restart.
+  disk_mgr->DeAllocatePage(DiskManager::BITMAP_SIZE + 5);
+  disk_mgr->DeAllocatePage(70);
+  disk_mgr->DeAllocatePage(7);
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_TRUE(disk_mgr->IsPageFree(7));
+  EXPECT_TRUE(disk_mgr->IsPageFree(70));
+  EXPECT_FALSE(disk_mgr->IsPageFree(71));
+  EXPECT_TRUE(disk_mgr->IsPageFree(DiskManager::BITMAP_SIZE + 5));
+  EXPECT_TRUE(disk_mgr->IsPageFree(num_pages));
+  EXPECT_EQ(7, disk_mgr->AllocatePage());
+  EXPECT_EQ(70, disk_mgr->AllocatePage());
+  EXPECT_EQ(DiskManager::BITMAP_SIZE + 5, disk_mgr->AllocatePage());
+  EXPECT_EQ(num_pages, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, AllocationHintTest) {
+  std::string db_name = "disk_alloc_hint_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const size_t pages_per_object = 300;
+
+  // Scenario: two objects growing at the same time each get runs of adjacent pages.
+  std::vector<page_id_t> objects[2];
+  objects[0].push_back(disk_mgr->AllocatePage());
+  objects[1].push_back(disk_mgr->AllocatePage());
+  page_id_t unrelated = disk_mgr->AllocatePage();
+  for (size_t i = 1; i < pages_per_object; i++) {
+    for (auto &pages : objects) {
+      page_id_t page_id = disk_mgr->AllocatePage(pages.back());
+      ASSERT_NE(INVALID_PAGE_ID, page_id);
+      ASSERT_NE(unrelated, page_id);
+      pages.push_back(page_id);
+    }
+  }
+  for (auto &pages : objects) {
+    size_t adjacent = 0;
+    for (size_t i = 1; i < pages.size(); i++) {
+      if (pages[i] == pages[i - 1] + 1) adjacent++;
+    }
+    // one jump into the first run, then one jump per run of PAGE_RUN_SIZE pages
+    EXPECT_GE(adjacent, pages.size() - 2 - pages.size() / PAGE_RUN_SIZE);
+  }
+
+  // Scenario: the reserved pages nobody took are given back by Sync.
+  auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+  EXPECT_LT(2 * pages_per_object + 1, meta_page->GetAllocatedPages());
+  disk_mgr->Sync();
+  EXPECT_EQ(2 * pages_per_object + 1, meta_page->GetAllocatedPages());
+  page_id_t last = std::max(objects[0].back(), objects[1].back());
+  for (page_id_t page_id = 0; page_id < last; page_id++) {
+    bool used = page_id == unrelated || std::count(objects[0].begin(), objects[0].end(), page_id) > 0 ||
+                std::count(objects[1].begin(), objects[1].end(), page_id) > 0;
+    ASSERT_EQ(!used, disk_mgr->IsPageFree(page_id));
+  }
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, ShrinkTest) {
+  std::string db_name = "disk_shrink_test.db";
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  const page_id_t num_pages = 200;
+  char data[PAGE_SIZE] = "page";
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    disk_mgr->WritePage(i, data);
+  }
+  disk_mgr->Sync();
+  // meta page, bitmap page, data pages
+  EXPECT_EQ((num_pages + 2) * PAGE_SIZE, std::filesystem::file_size(db_name));
+
+  // Scenario: freeing pages in the middle keeps the file size, freeing the tail cuts it at the next sync.
+  for (page_id_t i = 10; i < 20; i++) disk_mgr->DeAllocatePage(i);
+  disk_mgr->Sync();
+  EXPECT_EQ((num_pages + 2) * PAGE_SIZE, std::filesystem::file_size(db_name));
+  for (page_id_t i = 50; i < num_pages; i++) disk_mgr->DeAllocatePage(i);
+  disk_mgr->Sync();
+  EXPECT_EQ((50 + 2) * PAGE_SIZE, std::filesystem::file_size(db_name));
+  disk_mgr->ReadPage(num_pages - 1, data);
+  EXPECT_EQ(0, data[0]);
+
+  // Scenario: an empty extent is dropped, only the meta page is left, and allocation starts over after a restart.
+  for (page_id_t i = 0; i < 50; i++) {
+    if (i < 10 || i >= 20) disk_mgr->DeAllocatePage(i);
+  }
+  EXPECT_EQ(0, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetExtentNums());
+  delete disk_mgr;
+  EXPECT_EQ(PAGE_SIZE, std::filesystem::file_size(db_name));
+  disk_mgr = new DiskManager(db_name);
+  EXPECT_EQ(0, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, FileHeaderTest) {
+  std::string db_name = "disk_header_test.db";
+  remove(db_name.c_str());
+
+  // Scenario: a new file records the page size of the build.
+  auto *disk_mgr = new DiskManager(db_name);
+  EXPECT_EQ(0, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  uint32_t header[4];
+  FILE *file = fopen(db_name.c_str(), "rb");
+  ASSERT_EQ(4, fread(header, sizeof(uint32_t), 4, file));
+  fclose(file);
+  EXPECT_EQ(DiskFileMetaPage::MAGIC, header[0]);
+  EXPECT_EQ(PAGE_SIZE, header[1]);
+  EXPECT_EQ(1, header[2]);
+  EXPECT_EQ(1, header[3]);
+
+  // Scenario: a file with another page size is refused.
+  header[1] = PAGE_SIZE * 2;
+  file = fopen(db_name.c_str(), "r+b");
+  fwrite(header, sizeof(uint32_t), 4, file);
+  fclose(file);
+  EXPECT_THROW(DiskManager other(db_name), std::runtime_error);
+  remove(db_name.c_str());
+
+  // Scenario: a file written before the header existed is converted, if this build uses 4 KB pages.
+  std::vector<char> legacy(3 * PAGE_SIZE, 0);
+  uint32_t legacy_meta[3] = {3, 1, 3};  // 3 pages allocated, 1 extent using 3 pages
+  memcpy(legacy.data(), legacy_meta, sizeof(legacy_meta));
+  legacy[PAGE_SIZE + 2 * sizeof(uint32_t)] = static_cast<char>(0xe0);  // bitmap of the extent, pages 0 to 2 used
+  snprintf(legacy.data() + 2 * PAGE_SIZE, PAGE_SIZE, "legacy page");
+  file = fopen(db_name.c_str(), "wb");
+  fwrite(legacy.data(), 1, legacy.size(), file);
+  fclose(file);
+  if (PAGE_SIZE == 4096) {
+    disk_mgr = new DiskManager(db_name);
+    auto *meta_page = reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData());
+    EXPECT_EQ(3, meta_page->GetAllocatedPages());
+    EXPECT_EQ(1, meta_page->GetExtentNums());
+    EXPECT_EQ(3, meta_page->GetExtentUsedPage(0));
+    char data[PAGE_SIZE];
+    disk_mgr->ReadPage(0, data);
+    EXPECT_STREQ("legacy page", data);
+    EXPECT_EQ(3, disk_mgr->AllocatePage());
+    delete disk_mgr;
+    disk_mgr = new DiskManager(db_name);
+    EXPECT_EQ(4, reinterpret_cast<DiskFileMetaPage *>(disk_mgr->GetMetaData())->GetAllocatedPages());
+    delete disk_mgr;
+  } else {
+    EXPECT_THROW(DiskManager other(db_name), std::runtime_error);
+  }
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, CompressionTest) {
+  std::string db_name = "disk_compression_test.db";
+  remove(db_name.c_str());
+  const page_id_t num_pages = 300;
+  // rows of padded CHAR columns, like most of our tables
+  auto fill = [](page_id_t page_id, char *data) {
+    memset(data, 0, PAGE_SIZE);
+    for (size_t ofs = 0; ofs + 64 <= PAGE_SIZE; ofs += 64) {
+      snprintf(data + ofs, 64, "name-%d-%zu", page_id, ofs);
+    }
+  };
+  auto *disk_mgr = new DiskManager(db_name, false, false, true);
+  char data[PAGE_SIZE];
+  char expected[PAGE_SIZE];
+  for (page_id_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+    fill(i, data);
+    disk_mgr->WritePage(i, data);
+  }
+  delete disk_mgr;
+  EXPECT_LT(std::filesystem::file_size(db_name), num_pages * PAGE_SIZE / 3);
+
+  // Scenario: the file is recognized as compressed without asking for it, and the pages survive.
+  disk_mgr = new DiskManager(db_name);
+  for (page_id_t i = 0; i < num_pages; i++) {
+    fill(i, expected);
+    disk_mgr->ReadPage(i, data);
+    ASSERT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+  }
+  // Scenario: incompressible pages are stored as they are.
+  std::mt19937 rng(0);
+  for (page_id_t i = 0; i < num_pages; i += 2) {
+    for (auto &c : data) c = static_cast<char>(rng());
+    disk_mgr->WritePage(i, data);
+    disk_mgr->ReadPage(i, expected);
+    ASSERT_EQ(0, memcmp(expected, data, PAGE_SIZE));
+  }
+  delete disk_mgr;
+
+  // Scenario: a read-only disk manager maps the decompressed pages.
+  disk_mgr = new DiskManager(db_name, false, true);
+  fill(1, expected);
+  EXPECT_EQ(0, memcmp(expected, disk_mgr->GetMappedPage(1), PAGE_SIZE));
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, DirectIOTest) {
+  std::string db_name = "disk_direct_io_test.db";
+  remove(db_name.c_str());
+  // falls back to buffered I/O on file systems without O_DIRECT, both paths must behave the same
+  auto *disk_mgr = new DiskManager(db_name, true);
+  alignas(DiskManager::DIRECT_IO_ALIGNMENT) char aligned[PAGE_SIZE];
+  char unaligned_storage[PAGE_SIZE + 1];
+  char *unaligned = unaligned_storage + 1;
+
+  // Scenario: pages written from aligned and unaligned buffers read back intact into either kind of buffer.
+  page_id_t page0 = disk_mgr->AllocatePage();
+  page_id_t page1 = disk_mgr->AllocatePage();
+  memset(aligned, 'a', PAGE_SIZE);
+  memset(unaligned, 'u', PAGE_SIZE);
+  disk_mgr->WritePage(page0, aligned);
+  disk_mgr->WritePage(page1, unaligned);
+  disk_mgr->ReadPage(page1, aligned);
+  disk_mgr->ReadPage(page0, unaligned);
+  for (int i = 0; i < PAGE_SIZE; i++) {
+    ASSERT_EQ('u', aligned[i]);
+    ASSERT_EQ('a', unaligned[i]);
+  }
+
+  // Scenario: a page that was never written reads as zeros.
+  disk_mgr->ReadPage(page1 + 100, aligned);
+  for (int i = 0; i < PAGE_SIZE; i++) {
+    ASSERT_EQ(0, aligned[i]);
+  }
+
+  // Scenario: the meta page survives a restart.
+  delete disk_mgr;
+  disk_mgr = new DiskManager(db_name, true);
+  EXPECT_FALSE(disk_mgr->IsPageFree(page0));
+  EXPECT_FALSE(disk_mgr->IsPageFree(page1));
+  EXPECT_EQ(page1 + 1, disk_mgr->AllocatePage());
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, PageBatchTest) {
+  for (bool direct_io : {false, true}) {
+    std::string db_name = "disk_batch_test.db";
+    remove(db_name.c_str());
+    auto *disk_mgr = new DiskManager(db_name, direct_io);
+    const size_t num_pages = 100;
+    // one byte off the alignment, so the direct I/O path has to bounce every page
+    std::vector<char> storage((num_pages + 1) * PAGE_SIZE + 1);
+    char *pages = storage.data() + 1;
+
+    // Scenario: a batch of writes reads back intact, page by page and as a batch.
+    std::vector<std::pair<page_id_t, const char *>> writes;
+    for (size_t i = 0; i < num_pages; i++) {
+      ASSERT_EQ(i, disk_mgr->AllocatePage());
+      snprintf(pages + i * PAGE_SIZE, PAGE_SIZE, "page-%zu", i);
+      writes.emplace_back(i, pages + i * PAGE_SIZE);
+    }
+    disk_mgr->WritePageBatch(writes);
+    char data[PAGE_SIZE];
+    disk_mgr->ReadPage(num_pages / 2, data);
+    EXPECT_STREQ(pages + num_pages / 2 * PAGE_SIZE, data);
+    std::vector<char> read_back((num_pages + 1) * PAGE_SIZE, 'x');
+    std::vector<std::pair<page_id_t, char *>> reads;
+    for (size_t i = 0; i <= num_pages; i++) {
+      reads.emplace_back(num_pages - i, read_back.data() + i * PAGE_SIZE);
+    }
+    disk_mgr->ReadPageBatch(reads);
+    for (size_t i = 1; i <= num_pages; i++) {
+      EXPECT_STREQ(pages + (num_pages - i) * PAGE_SIZE, read_back.data() + i * PAGE_SIZE);
+    }
+
+    // Scenario: the page past the end of the file reads as zeros.
+    for (int i = 0; i < PAGE_SIZE; i++) {
+      ASSERT_EQ(0, read_back[i]);
+    }
+
+    // Scenario: a shuffled batch with gaps and a page written twice is merged into runs, the last write wins.
+    std::mt19937 rng(0);
+    std::shuffle(writes.begin(), writes.end(), rng);
+    writes.erase(writes.begin(), writes.begin() + num_pages / 4);
+    char twice[PAGE_SIZE] = "written twice";
+    writes.emplace_back(writes.front().first, twice);
+    for (auto &write : writes) {
+      memcpy(const_cast<char *>(write.second), "new", 3);
+    }
+    disk_mgr->WritePageBatch(writes);
+    for (size_t i = 1; i + 1 < writes.size(); i++) {
+      disk_mgr->ReadPage(writes[i].first, data);
+      EXPECT_STREQ(writes[i].second, data);
+    }
+    disk_mgr->ReadPage(writes.front().first, data);
+    EXPECT_STREQ("newtten twice", data);
+    delete disk_mgr;
+    remove(db_name.c_str());
+  }
+}
+
+/**
+ * Random page reads spread over num_threads threads, in pages per second.
+ */
+static double MeasureReadThroughput(DiskManager *disk_mgr, size_t num_pages, int num_threads, int reads_per_thread) {
+  std::vector<std::thread> threads;
+  auto begin = std::chrono::steady_clock::now();
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([=] {
+      std::mt19937 rng(t);
+      char data[PAGE_SIZE];
+      for (int i = 0; i < reads_per_thread; i++) {
+        disk_mgr->ReadPage(rng() % num_pages, data);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  return num_threads * reads_per_thread / elapsed.count();
+}
+
+/**
+ * Random page reads spread over num_threads threads, every page must hold "page-<page id>".
+ */
+static void CheckConcurrentReads(DiskManager *disk_mgr, size_t num_pages, int num_threads, int reads_per_thread) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([=] {
+      std::mt19937 rng(t);
+      char data[PAGE_SIZE];
+      char expected[PAGE_SIZE];
+      for (int i = 0; i < reads_per_thread; i++) {
+        size_t page_id = rng() % num_pages;
+        disk_mgr->ReadPage(page_id, data);
+        snprintf(expected, PAGE_SIZE, "page-%zu", page_id);
+        EXPECT_STREQ(expected, data);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(DiskManagerTest, PageIOTest) {
+  std::string db_name = "disk_io_test.db";
+  const size_t num_pages = 1024;
+  const int reads_per_thread = 500;
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+
+  // Scenario: pages written in order read back from one thread and from several at once.
+  char data[PAGE_SIZE];
+  for (size_t i = 0; i < num_pages; i++) {
+    snprintf(data, PAGE_SIZE, "page-%zu", i);
+    disk_mgr->WritePage(i, data);
+  }
+  for (int num_threads : {1, 4}) {
+    CheckConcurrentReads(disk_mgr, num_pages, num_threads, reads_per_thread);
+  }
+
+  // the content must survive either way
+  for (size_t i = 0; i < num_pages; i += 127) {
+    char expected[PAGE_SIZE];
+    snprintf(expected, PAGE_SIZE, "page-%zu", i);
+    disk_mgr->ReadPage(i, data);
+    EXPECT_STREQ(expected, data);
+  }
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
+
+TEST(DiskManagerTest, DISABLED_PageIOBenchmark) {
+  std::string db_name = "disk_io_bench.db";
+  const size_t num_pages = 4096;
+  const int reads_per_thread = 20000;
+  remove(db_name.c_str());
+  auto *disk_mgr = new DiskManager(db_name);
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+
+  char data[PAGE_SIZE];
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < num_pages; i++) {
+    snprintf(data, PAGE_SIZE, "page-%zu", i);
+    disk_mgr->WritePage(i, data);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+  printf("%-20s %12.0f pages/s\n", "sequential write", num_pages / elapsed.count());
+  for (int num_threads : {1, 4}) {
+    double pages_per_second = MeasureReadThroughput(disk_mgr, num_pages, num_threads, reads_per_thread);
+    printf("random read x%-7d %12.0f pages/s\n", num_threads, pages_per_second);
+  }
+
+  // the content must survive either way
+  for (size_t i = 0; i < num_pages; i += 511) {
+    char expected[PAGE_SIZE];
+    snprintf(expected, PAGE_SIZE, "page-%zu", i);
+    disk_mgr->ReadPage(i, data);
+    EXPECT_STREQ(expected, data);
+  }
+  delete disk_mgr;
+  remove(db_name.c_str());
+}
@@ -0,0 +1,262 @@
+#include "storage/storage_backend.h"
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager_instance.h"
+#include "gtest/gtest.h"
+#include "storage/disk_manager.h"
+
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+TEST(StorageBackendTest, MemoryBackendTest) {
+  MemoryBackend backend;
+  char buf[64];
+  EXPECT_EQ(0, backend.Size());
+  EXPECT_EQ(0, backend.Read(buf, sizeof(buf), 0));
+
+  // writes beyond the end grow the storage, the gap reads as zeros
+  ASSERT_TRUE(backend.Write("hello", 6, 100));
+  EXPECT_EQ(106, backend.Size());
+  EXPECT_EQ(6, backend.Read(buf, sizeof(buf), 100));
+  EXPECT_STREQ("hello", buf);
+  EXPECT_EQ(sizeof(buf), backend.Read(buf, sizeof(buf), 0));
+  EXPECT_EQ(std::vector<char>(sizeof(buf), 0), std::vector<char>(buf, buf + sizeof(buf)));
+
+  // a batch with a vectored write and a short read
+  char part1[] = "abc", part2[] = "def";
+  iovec iov[2] = {{part1, 3}, {part2, 3}};
+  char out[16];
+  std::vector<IORequest> batch = {{-1, nullptr, 6, 10, true, 0, iov, 2}, {-1, out, sizeof(out), 100, false}};
+  backend.Execute(&batch);
+  EXPECT_EQ(6, batch[0].result_);
+  EXPECT_EQ(6, batch[1].result_);
+  EXPECT_EQ(6, backend.Read(buf, 6, 10));
+  EXPECT_EQ(0, memcmp("abcdef", buf, 6));
+
+  ASSERT_TRUE(backend.Truncate(8));
+  EXPECT_EQ(8, backend.Size());
+  EXPECT_EQ(0, backend.Read(buf, sizeof(buf), 10));
+}
+
+TEST(StorageBackendTest, MemoryDiskManagerTest) {
+  const size_t num_pages = 100;
+  auto *disk_mgr = new DiskManager(std::make_unique<MemoryBackend>());
+  EXPECT_FALSE(disk_mgr->IsDirectIO());
+  for (size_t i = 0; i < num_pages; i++) {
+    ASSERT_EQ(i, disk_mgr->AllocatePage());
+  }
+  char data[PAGE_SIZE];
+  std::vector<std::vector<char>> pages(num_pages, std::vector<char>(PAGE_SIZE));
+  std::vector<std::pair<page_id_t, const char *>> writes;
+  for (size_t i = 0; i < num_pages; i++) {
+    snprintf(pages[i].data(), PAGE_SIZE, "page-%zu", i);
+    if (i % 2 == 0) {
+      disk_mgr->WritePage(i, pages[i].data());
+    } else {
+      writes.emplace_back(i, pages[i].data());
+    }
+  }
+  disk_mgr->WritePageBatch(writes);
+  disk_mgr->Sync();
+  for (size_t i = 0; i < num_pages; i++) {
+    disk_mgr->ReadPage(i, data);
+    ASSERT_STREQ(pages[i].data(), data);
+  }
+  // a page that was never written reads as zeros
+  page_id_t fresh = disk_mgr->AllocatePage();
+  disk_mgr->ReadPage(fresh, data);
+  EXPECT_EQ(0, data[0]);
+  delete disk_mgr;
+}
+
+TEST(StorageBackendTest, CompressedBackendTest) {
+  auto memory = std::make_unique<MemoryBackend>();
+  auto *storage = memory.get();
+  auto backend = std::make_unique<CompressedBackend>(std::move(memory));
+  const size_t num_pages = 64;
+  std::vector<char> pages(num_pages * PAGE_SIZE, 0);
+  for (size_t i = 0; i < num_pages; i++) {
+    snprintf(&pages[i * PAGE_SIZE], PAGE_SIZE, "page-%zu", i);
+  }
+  ASSERT_TRUE(backend->Write(pages.data(), pages.size(), 0));
+  EXPECT_EQ(pages.size(), backend->Size());
+  // a short string per page compresses into a single slot
+  EXPECT_LE(storage->Size(), (num_pages + 1) * CompressedBackend::SLOT_SIZE);
+
+  // Scenario: pages grow, shrink, become zeros and are written partially.
+  std::vector<char> page(PAGE_SIZE);
+  for (size_t i = 0; i < PAGE_SIZE; i++) page[i] = static_cast<char>(i * 7919 % 251);
+  ASSERT_TRUE(backend->Write(page.data(), PAGE_SIZE, 3 * PAGE_SIZE));
+  memcpy(&pages[3 * PAGE_SIZE], page.data(), PAGE_SIZE);
+  memset(&pages[5 * PAGE_SIZE], 0, PAGE_SIZE);
+  ASSERT_TRUE(backend->Write(&pages[5 * PAGE_SIZE], PAGE_SIZE, 5 * PAGE_SIZE));
+  ASSERT_TRUE(backend->Write("patched", 7, 7 * PAGE_SIZE + 100));
+  memcpy(&pages[7 * PAGE_SIZE + 100], "patched", 7);
+  std::vector<char> out(pages.size());
+  ASSERT_EQ(pages.size(), backend->Read(out.data(), out.size(), 0));
+  EXPECT_EQ(pages, out);
+  EXPECT_EQ(100, backend->Read(out.data(), 200, pages.size() - 100));
+
+  // Scenario: truncated pages give their slots back at the next Sync.
+  ASSERT_TRUE(backend->Truncate(num_pages / 2 * PAGE_SIZE));
+  ASSERT_TRUE(backend->Sync());
+  size_t stored = storage->Size();
+  ASSERT_TRUE(backend->Write(&pages[num_pages / 2 * PAGE_SIZE], num_pages / 2 * PAGE_SIZE, num_pages / 2 * PAGE_SIZE));
+  EXPECT_EQ(stored, storage->Size());
+  ASSERT_TRUE(backend->Truncate(num_pages / 2 * PAGE_SIZE));
+  ASSERT_TRUE(backend->Sync());
+
+  // Scenario: after Sync another backend opens the storage.
+  auto copy = std::make_unique<MemoryBackend>();
+  std::vector<char> raw(storage->Size());
+  storage->Read(raw.data(), raw.size(), 0);
+  copy->Write(raw.data(), raw.size(), 0);
+  EXPECT_TRUE(CompressedBackend::IsCompressed(copy.get()));
+  CompressedBackend reopened(std::move(copy));
+  ASSERT_EQ(num_pages / 2 * PAGE_SIZE, reopened.Size());
+  ASSERT_EQ(reopened.Size(), reopened.Read(out.data(), reopened.Size(), 0));
+  EXPECT_EQ(0, memcmp(pages.data(), out.data(), reopened.Size()));
+
+  // Scenario: a crash after writes that were not synced yet leaves the storage as of the last Sync, whether the
+  // pages grew, shrank or kept their size.
+  ASSERT_TRUE(backend->Write(page.data(), PAGE_SIZE, 0));
+  ASSERT_TRUE(backend->Write("short", 6, 3 * PAGE_SIZE));
+  ASSERT_TRUE(backend->Write("PAGE-1", 6, PAGE_SIZE));
+  ASSERT_TRUE(backend->Write("again", 5, PAGE_SIZE));
+  auto crashed = std::make_unique<MemoryBackend>();
+  raw.resize(storage->Size());
+  storage->Read(raw.data(), raw.size(), 0);
+  crashed->Write(raw.data(), raw.size(), 0);
+  CompressedBackend recovered(std::move(crashed));
+  ASSERT_EQ(num_pages / 2 * PAGE_SIZE, recovered.Read(out.data(), num_pages / 2 * PAGE_SIZE, 0));
+  EXPECT_EQ(0, memcmp(pages.data(), out.data(), num_pages / 2 * PAGE_SIZE));
+
+  // Scenario: storage that holds something else is refused.
+  auto plain = std::make_unique<MemoryBackend>();
+  plain->Write("MSQL", 4, 0);
+  EXPECT_FALSE(CompressedBackend::IsCompressed(plain.get()));
+  EXPECT_THROW(CompressedBackend(std::move(plain)), std::runtime_error);
+}
+
+TEST(StorageBackendTest, ThrottledBackendTest) {
+  ThrottleOptions options;
+  options.read_latency_ = microseconds(2000);
+  options.write_latency_ = microseconds(1000);
+  options.write_bandwidth_ = 16 << 20;
+  options.queue_depth_ = 8;
+  ThrottledBackend backend(std::make_unique<MemoryBackend>(), options);
+  std::vector<char> buf(1 << 20, 'x');
+
+  // a megabyte at 16MB/s takes a 16th of a second plus the latency
+  auto begin = steady_clock::now();
+  ASSERT_TRUE(backend.Write(buf.data(), buf.size(), 0));
+  EXPECT_GE(steady_clock::now() - begin, microseconds(62500 + 1000));
+
+  begin = steady_clock::now();
+  EXPECT_EQ(PAGE_SIZE, backend.Read(buf.data(), PAGE_SIZE, 0));
+  EXPECT_GE(steady_clock::now() - begin, options.read_latency_);
+
+  // 16 reads at queue depth 8 wait two latencies instead of 16
+  std::vector<IORequest> batch;
+  for (size_t i = 0; i < 16; i++) {
+    batch.push_back({-1, buf.data() + i * PAGE_SIZE, PAGE_SIZE, i * PAGE_SIZE, false});
+  }
+  begin = steady_clock::now();
+  backend.Execute(&batch);
+  auto elapsed = steady_clock::now() - begin;
+  EXPECT_GE(elapsed, 2 * options.read_latency_);
+  EXPECT_LT(elapsed, 16 * options.read_latency_);
+  for (auto &request : batch) {
+    EXPECT_EQ(PAGE_SIZE, request.result_);
+  }
+}
+
+TEST(StorageBackendTest, ThrottledFetchTest) {
+  const size_t num_pages = 64;
+  ThrottleOptions options;
+  options.read_latency_ = microseconds(100);
+  options.write_latency_ = microseconds(100);
+  options.queue_depth_ = 32;
+  auto *disk_mgr =
+      new DiskManager(std::make_unique<ThrottledBackend>(std::make_unique<MemoryBackend>(), options));
+  std::vector<page_id_t> page_ids;
+  char data[PAGE_SIZE];
+  for (size_t i = 0; i < num_pages; i++) {
+    page_ids.push_back(disk_mgr->AllocatePage());
+    snprintf(data, PAGE_SIZE, "page-%d", page_ids.back());
+    disk_mgr->WritePage(page_ids.back(), data);
+  }
+
+  // Scenario: a batched fetch keeps the queue full, so it waits for far fewer latencies than fetching one by one.
+  steady_clock::duration elapsed[2];
+  for (bool batched : {false, true}) {
+    auto *bpm = new BufferPoolManagerInstance(num_pages, disk_mgr);
+    auto begin = steady_clock::now();
+    std::vector<Page *> pages;
+    if (batched) {
+      pages = bpm->FetchPages(page_ids);
+    } else {
+      for (auto page_id : page_ids) {
+        pages.push_back(bpm->FetchPage(page_id));
+      }
+    }
+    elapsed[batched] = steady_clock::now() - begin;
+    for (size_t i = 0; i < num_pages; i++) {
+      ASSERT_NE(nullptr, pages[i]);
+      snprintf(data, PAGE_SIZE, "page-%d", page_ids[i]);
+      EXPECT_STREQ(data, pages[i]->GetData());
+      bpm->UnpinPage(page_ids[i], false);
+    }
+    delete bpm;
+  }
+  EXPECT_GE(elapsed[false], num_pages * options.read_latency_);
+  EXPECT_LT(elapsed[true], elapsed[false]);
+  delete disk_mgr;
+}
+
+TEST(StorageBackendTest, DISABLED_ThrottledFetchBenchmark) {
+  const size_t num_pages = 256;
+  ThrottleOptions options;
+  options.read_latency_ = microseconds(100);
+  options.write_latency_ = microseconds(100);
+  options.queue_depth_ = 32;
+  auto *disk_mgr =
+      new DiskManager(std::make_unique<ThrottledBackend>(std::make_unique<MemoryBackend>(), options));
+  std::vector<page_id_t> page_ids;
+  char data[PAGE_SIZE];
+  for (size_t i = 0; i < num_pages; i++) {
+    page_ids.push_back(disk_mgr->AllocatePage());
+    snprintf(data, PAGE_SIZE, "page-%d", page_ids.back());
+    disk_mgr->WritePage(page_ids.back(), data);
+  }
+
+  printf("%-12s %12s\n", "fetch", "pages/s");
+  for (bool batched : {false, true}) {
+    auto *bpm = new BufferPoolManagerInstance(num_pages, disk_mgr);
+    auto begin = steady_clock::now();
+    std::vector<Page *> pages;
+    if (batched) {
+      pages = bpm->FetchPages(page_ids);
+    } else {
+      for (auto page_id : page_ids) {
+        pages.push_back(bpm->FetchPage(page_id));
+      }
+    }
+    std::chrono::duration<double> elapsed = steady_clock::now() - begin;
+    printf("%-12s %12.0f\n", batched ? "batched" : "one by one", num_pages / elapsed.count());
+    for (size_t i = 0; i < num_pages; i++) {
+      ASSERT_NE(nullptr, pages[i]);
+      snprintf(data, PAGE_SIZE, "page-%d", page_ids[i]);
+      EXPECT_STREQ(data, pages[i]->GetData());
+      bpm->UnpinPage(page_ids[i], false);
+    }
+    delete bpm;
+  }
+  delete disk_mgr;
+}
@@ -1,12 +1,19 @@
 #include "storage/table_heap.h"
 
+#include <algorithm>
+#include <chrono>
 #include <unordered_map>
 #include <vector>
 
+#include "buffer/buffer_pool_manager_instance.h"
 #include "common/instance.h"
 #include "gtest/gtest.h"
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
 #include "record/field.h"
 #include "record/schema.h"
+#include "storage/storage_backend.h"
 #include "utils/utils.h"
 
 static string db_file_name = "table_heap_test.db";
@@ -15,7 +22,7 @@ using Fields = std::vector<Field>;
 TEST(TableHeapTest, TableHeapSampleTest) {
   // init testing instance
   auto disk_mgr_ = new DiskManager(db_file_name);
-  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
   const int row_nums = 10000;
   // create schema
   std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
@@ -60,3 +67,616 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   }
   ASSERT_EQ(size, 0);
 }
+
+TEST(TableHeapTest, ContiguousLayoutTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 256, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heaps[2] = {TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr),
+                         TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr)};
+
+  // Scenario: two tables filled at the same time do not interleave their pages.
+  char name[256];
+  memset(name, 'x', sizeof(name));
+  for (int i = 0; i < PAGE_SIZE; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    Row row(fields);
+    ASSERT_TRUE(heaps[i % 2]->InsertTuple(row, nullptr));
+  }
+  for (auto heap : heaps) {
+    size_t pages = 0;
+    size_t adjacent = 0;
+    page_id_t page_id = heap->GetFirstPageId();
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(page_id));
+      page_id_t next_page_id = page->GetNextPageId();
+      bpm_->UnpinPage(page_id, false);
+      if (next_page_id == page_id + 1) adjacent++;
+      pages++;
+      page_id = next_page_id;
+    }
+    EXPECT_LT(100, pages);
+    EXPECT_GE(adjacent, pages - 2 - pages / PAGE_RUN_SIZE);
+    delete heap;
+  }
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+/** @return the page ids of the chain of a heap */
+static std::vector<page_id_t> GetPageIds(BufferPoolManager *bpm, TableHeap *heap) {
+  std::vector<page_id_t> page_ids;
+  for (page_id_t page_id = heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    auto page = reinterpret_cast<TablePage *>(bpm->FetchPage(page_id));
+    page_ids.push_back(page_id);
+    page_id = page->GetNextPageId();
+    bpm->UnpinPage(page_ids.back(), false);
+  }
+  return page_ids;
+}
+
+TEST(TableHeapTest, FreeSpaceMapTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  auto insert = [&](TableHeap *table_heap, int id) {
+    Fields fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    Row row(fields);
+    EXPECT_TRUE(table_heap->InsertTuple(row, nullptr));
+    return row.GetRowId();
+  };
+  const int row_nums = 2 * FreeSpaceMapPage::CAPACITY * (PAGE_SIZE / 128);
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) rids.push_back(insert(heap, i));
+  auto page_ids = GetPageIds(bpm_, heap);
+  // the map spans more than one page
+  ASSERT_LT(FreeSpaceMapPage::CAPACITY, page_ids.size());
+
+  // Scenario: rows deleted from the first pages make room for the next inserts, no page is appended.
+  std::vector<page_id_t> freed_pages = {page_ids[0], page_ids[1], page_ids[page_ids.size() / 2]};
+  size_t freed_rows = 0;
+  for (auto &rid : rids) {
+    if (std::find(freed_pages.begin(), freed_pages.end(), rid.GetPageId()) == freed_pages.end()) continue;
+    heap->ApplyDelete(rid, nullptr);
+    freed_rows++;
+  }
+  // the map rounds free space down, so the last rows of a page may not be placed there
+  for (size_t i = 0; i < freed_rows / 2; i++) {
+    RowId rid = insert(heap, row_nums + i);
+    EXPECT_NE(freed_pages.end(), std::find(freed_pages.begin(), freed_pages.end(), rid.GetPageId()));
+  }
+  EXPECT_EQ(page_ids.size(), GetPageIds(bpm_, heap).size());
+
+  // Scenario: the map persists, a reopened heap finds freed space through it.
+  page_id_t fsm_page_id = heap->GetFreeSpaceMapPageId();
+  ASSERT_NE(INVALID_PAGE_ID, fsm_page_id);
+  heap->ApplyDelete(rids[0], nullptr);
+  delete heap;
+  heap = TableHeap::Create(bpm_, page_ids[0], schema.get(), nullptr, nullptr, fsm_page_id);
+  EXPECT_EQ(page_ids[0], insert(heap, -2).GetPageId());
+  EXPECT_EQ(fsm_page_id, heap->GetFreeSpaceMapPageId());
+  delete heap;
+
+  // Scenario: a page linked to the chain after the map was last written, as after a crash, is found on reopening.
+  // Later pages are appended after it instead of cutting it off the chain.
+  page_id_t tail_page_id;
+  auto tail_page = reinterpret_cast<TablePage *>(bpm_->NewPage(tail_page_id));
+  tail_page->Init(tail_page_id, page_ids.back(), nullptr, nullptr);
+  bpm_->UnpinPage(tail_page_id, true);
+  auto last_page = reinterpret_cast<TablePage *>(bpm_->FetchPage(page_ids.back()));
+  last_page->SetNextPageId(tail_page_id);
+  bpm_->UnpinPage(page_ids.back(), true);
+  heap = TableHeap::Create(bpm_, page_ids[0], schema.get(), nullptr, nullptr, fsm_page_id);
+  for (size_t i = 0; i < freed_rows + 2 * PAGE_SIZE / 128; i++) insert(heap, -4);
+  auto chain = GetPageIds(bpm_, heap);
+  ASSERT_LT(page_ids.size() + 1, chain.size());
+  EXPECT_EQ(tail_page_id, chain[page_ids.size()]);
+  delete heap;
+  page_ids = chain;
+
+  // Scenario: a heap without a map builds one from its pages.
+  heap = TableHeap::Create(bpm_, page_ids[0], schema.get(), nullptr, nullptr);
+  heap->ApplyDelete(rids[1], nullptr);
+  EXPECT_EQ(page_ids[0], insert(heap, -3).GetPageId());
+  EXPECT_NE(fsm_page_id, heap->GetFreeSpaceMapPageId());
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, BulkInsertTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  auto make_row = [&](int id) {
+    Fields fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    return Row(fields);
+  };
+  const int row_nums = 5000;
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  TableHeap *reference = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    rows.push_back(make_row(i));
+    Row row = make_row(i);
+    ASSERT_TRUE(reference->InsertTuple(row, nullptr));
+  }
+  ASSERT_EQ(row_nums, heap->BulkInsert(rows, nullptr));
+
+  // Scenario: the rows fill the first page and then as few pages as one insert after another would.
+  auto page_ids = GetPageIds(bpm_, heap);
+  EXPECT_EQ(heap->GetFirstPageId(), rows[0].GetRowId().GetPageId());
+  EXPECT_EQ(GetPageIds(bpm_, reference).size(), page_ids.size());
+  for (int i = 0; i < row_nums; i++) {
+    Row row(rows[i].GetRowId());
+    ASSERT_TRUE(heap->GetTuple(&row, nullptr));
+    EXPECT_EQ(std::to_string(i), row.GetField(0)->toString());
+  }
+
+  // Scenario: the new pages are in the free space map, space freed there is found by the next insert.
+  RowId freed = rows[row_nums / 2].GetRowId();
+  heap->ApplyDelete(freed, nullptr);
+  heap->ApplyDelete(rows[row_nums / 2 + 1].GetRowId(), nullptr);
+  Row row = make_row(row_nums);
+  ASSERT_TRUE(heap->InsertTuple(row, nullptr));
+  EXPECT_EQ(freed.GetPageId(), row.GetRowId().GetPageId());
+  EXPECT_EQ(page_ids.size(), GetPageIds(bpm_, heap).size());
+
+  // Scenario: a row too large for a page ends the batch.
+  std::vector<char> large(PAGE_SIZE);
+  Fields large_fields{Field(TypeId::kTypeInt, -1), Field(TypeId::kTypeChar, large.data(), PAGE_SIZE, false)};
+  std::vector<Row> batch = {make_row(-2), Row(large_fields), make_row(-3)};
+  EXPECT_EQ(1, heap->BulkInsert(batch, nullptr));
+  delete reference;
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, InsertTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  const int row_nums = 5000;
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+
+  // Scenario: rows inserted one by one fill the pages in order.
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    Row row(fields);
+    ASSERT_TRUE(heap->InsertTuple(row, nullptr));
+  }
+  int scanned = 0;
+  for (auto it = heap->Begin(nullptr); it != heap->End(); ++it) {
+    ASSERT_EQ(std::to_string(scanned++), it->GetField(0)->toString());
+  }
+  EXPECT_EQ(row_nums, scanned);
+  EXPECT_TRUE(bpm_->CheckAllUnpinned());
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, DISABLED_InsertBenchmark) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  // an insert must cost the same no matter how large the table is
+  printf("%-10s %12s\n", "rows", "rows/s");
+  for (int row_nums : {50000, 200000}) {
+    remove(db_file_name.c_str());
+    auto disk_mgr_ = new DiskManager(db_file_name);
+    auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+    TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < row_nums; i++) {
+      Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+      Row row(fields);
+      ASSERT_TRUE(heap->InsertTuple(row, nullptr));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    printf("%-10d %12.0f\n", row_nums, row_nums / elapsed.count());
+    delete heap;
+    delete bpm_;
+    delete disk_mgr_;
+  }
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, IteratorTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[64];
+  memset(name, 'x', sizeof(name));
+  const int row_nums = 2000;
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    rows.emplace_back(fields);
+  }
+  ASSERT_EQ(row_nums, heap->BulkInsert(rows, nullptr));
+  auto scan = [&] {
+    std::vector<int> ids;
+    for (auto it = heap->Begin(nullptr); it != heap->End(); ++it) {
+      ids.push_back(std::stoi(it->GetField(0)->toString()));
+      EXPECT_EQ(rows[ids.back()].GetRowId(), it->GetRowId());
+    }
+    return ids;
+  };
+  std::vector<int> ids = scan();
+  ASSERT_EQ(row_nums, ids.size());
+  EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end()));
+
+  // Scenario: deleted tuples and pages that became empty, the first one too, are skipped.
+  auto page_ids = GetPageIds(bpm_, heap);
+  ASSERT_LT(3, page_ids.size());
+  std::vector<int> expected;
+  for (int i = 0; i < row_nums; i++) {
+    page_id_t page_id = rows[i].GetRowId().GetPageId();
+    if (page_id == page_ids[0] || page_id == page_ids[2] || i % 3 == 0) {
+      heap->ApplyDelete(rows[i].GetRowId(), nullptr);
+    } else {
+      expected.push_back(i);
+    }
+  }
+  EXPECT_EQ(expected, scan());
+
+  // Scenario: a copy goes on from where the original was, postfix ++ returns the old position.
+  auto it = heap->Begin(nullptr);
+  auto old = it++;
+  EXPECT_EQ(expected[0], std::stoi(old->GetField(0)->toString()));
+  TableIterator copy(it);
+  ++copy;
+  EXPECT_EQ(expected[1], std::stoi(it->GetField(0)->toString()));
+  EXPECT_EQ(expected[2], std::stoi(copy->GetField(0)->toString()));
+
+  // Scenario: a heap without live tuples is empty.
+  for (int i : expected) heap->ApplyDelete(rows[i].GetRowId(), nullptr);
+  EXPECT_TRUE(heap->Begin(nullptr) == heap->End());
+  EXPECT_TRUE(bpm_->CheckAllUnpinned());
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, ScanTest) {
+  const int row_nums = 20000;
+  auto disk_mgr_ = new DiskManager(std::make_unique<MemoryBackend>());
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[16];
+  memset(name, 'x', sizeof(name));
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    rows.emplace_back(fields);
+    if (rows.size() == 65536 || i == row_nums - 1) {
+      ASSERT_EQ(rows.size(), heap->BulkInsert(rows, nullptr));
+      rows.clear();
+    }
+  }
+  // Scenario: the page batch scan sees the same tuples as a scan that fetches the page for every rid.
+  for (bool by_page : {false, true}) {
+    BufferRing ring;
+    int64_t sum = 0;
+    int scanned = 0;
+    if (by_page) {
+      for (auto it = heap->Begin(nullptr, &ring); it != heap->End(); ++it) {
+        sum += it->GetField(0)->GetSerializedSize();
+        scanned++;
+      }
+    } else {
+      // how a scan used to advance: fetch the page for the next rid, then read the tuple into a new row
+      RowId rid;
+      auto first = reinterpret_cast<TablePage *>(bpm_->FetchPage(heap->GetFirstPageId(), &ring));
+      first->GetFirstTupleRid(&rid);
+      bpm_->UnpinPage(heap->GetFirstPageId(), false);
+      while (rid.GetPageId() != INVALID_PAGE_ID) {
+        auto row = new Row(rid);
+        heap->GetTuple(row, nullptr, &ring);
+        sum += row->GetField(0)->GetSerializedSize();
+        scanned++;
+        delete row;
+        auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rid.GetPageId(), &ring));
+        page->RLatch();
+        RowId next;
+        if (!page->GetNextTupleRid(rid, &next)) {
+          page_id_t next_page_id = page->GetNextPageId();
+          next = INVALID_ROWID;
+          if (next_page_id != INVALID_PAGE_ID) {
+            auto next_page = reinterpret_cast<TablePage *>(bpm_->FetchPage(next_page_id, &ring));
+            next_page->GetFirstTupleRid(&next);
+            bpm_->UnpinPage(next_page_id, false);
+          }
+        }
+        page->RUnlatch();
+        bpm_->UnpinPage(rid.GetPageId(), false);
+        rid = next;
+      }
+    }
+    ASSERT_EQ(row_nums, scanned);
+    ASSERT_EQ(4LL * row_nums, sum);
+    EXPECT_TRUE(bpm_->CheckAllUnpinned());
+  }
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, DISABLED_ScanBenchmark) {
+  const int row_nums = 300000;
+  auto disk_mgr_ = new DiskManager(std::make_unique<MemoryBackend>());
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[16];
+  memset(name, 'x', sizeof(name));
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false)};
+    rows.emplace_back(fields);
+    if (rows.size() == 65536 || i == row_nums - 1) {
+      ASSERT_EQ(rows.size(), heap->BulkInsert(rows, nullptr));
+      rows.clear();
+    }
+  }
+  printf("%-12s %12s %12s\n", "scan", "rows/s", "ns/row");
+  for (bool by_page : {false, true}) {
+    BufferRing ring;
+    int64_t sum = 0;
+    int scanned = 0;
+    auto begin = std::chrono::steady_clock::now();
+    if (by_page) {
+      for (auto it = heap->Begin(nullptr, &ring); it != heap->End(); ++it) {
+        sum += it->GetField(0)->GetSerializedSize();
+        scanned++;
+      }
+    } else {
+      // how a scan used to advance: fetch the page for the next rid, then read the tuple into a new row
+      RowId rid;
+      auto first = reinterpret_cast<TablePage *>(bpm_->FetchPage(heap->GetFirstPageId(), &ring));
+      first->GetFirstTupleRid(&rid);
+      bpm_->UnpinPage(heap->GetFirstPageId(), false);
+      while (rid.GetPageId() != INVALID_PAGE_ID) {
+        auto row = new Row(rid);
+        heap->GetTuple(row, nullptr, &ring);
+        sum += row->GetField(0)->GetSerializedSize();
+        scanned++;
+        delete row;
+        auto page = reinterpret_cast<TablePage *>(bpm_->FetchPage(rid.GetPageId(), &ring));
+        page->RLatch();
+        RowId next;
+        if (!page->GetNextTupleRid(rid, &next)) {
+          page_id_t next_page_id = page->GetNextPageId();
+          next = INVALID_ROWID;
+          if (next_page_id != INVALID_PAGE_ID) {
+            auto next_page = reinterpret_cast<TablePage *>(bpm_->FetchPage(next_page_id, &ring));
+            next_page->GetFirstTupleRid(&next);
+            bpm_->UnpinPage(next_page_id, false);
+          }
+        }
+        page->RUnlatch();
+        bpm_->UnpinPage(rid.GetPageId(), false);
+        rid = next;
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    ASSERT_EQ(row_nums, scanned);
+    ASSERT_EQ(4LL * row_nums, sum);
+    printf("%-12s %12.0f %12.1f\n", by_page ? "page batch" : "per tuple", scanned / elapsed.count(),
+           elapsed.count() * 1e9 / scanned);
+  }
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, ScanPageTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  const int row_nums = 2000;
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    std::string name = "name-" + std::to_string(i);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()),
+                                                    static_cast<uint32_t>(name.size()), true)};
+    rows.emplace_back(fields);
+  }
+  ASSERT_EQ(row_nums, heap->BulkInsert(rows, nullptr));
+  for (int i = 0; i < row_nums; i += 3) {
+    heap->ApplyDelete(rows[i].GetRowId(), nullptr);
+  }
+
+  // Scenario: a predicate is evaluated on the views, only the matching tuples are materialized.
+  auto predicate = std::make_shared<ComparisonExpression>(
+      std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt),
+      std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt, row_nums / 2)), "<");
+  std::vector<Row> matched;
+  int visited = 0;
+  ReadAheadTracker read_ahead;
+  for (page_id_t page_id = heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    page_id = heap->ScanPage(
+        page_id,
+        [&](const RowView &view) {
+          visited++;
+          if (predicate->Evaluate(&view).CompareEquals(Field(TypeId::kTypeInt, 1)) == CmpBool::kTrue) {
+            matched.emplace_back();
+            view.ToRow(&matched.back());
+          }
+        },
+        nullptr, &read_ahead);
+  }
+  EXPECT_EQ(row_nums - (row_nums + 2) / 3, visited);
+  std::vector<int> expected;
+  for (int i = 0; i < row_nums / 2; i++) {
+    if (i % 3 != 0) expected.push_back(i);
+  }
+  ASSERT_EQ(expected.size(), matched.size());
+  for (size_t i = 0; i < matched.size(); i++) {
+    EXPECT_EQ(rows[expected[i]].GetRowId(), matched[i].GetRowId());
+    EXPECT_EQ("name-" + std::to_string(expected[i]), matched[i].GetField(1)->toString());
+  }
+  EXPECT_TRUE(bpm_->CheckAllUnpinned());
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+  remove(db_file_name.c_str());
+}
+
+TEST(TableHeapTest, FilterTest) {
+  const int row_nums = 20000;
+  auto disk_mgr_ = new DiskManager(std::make_unique<MemoryBackend>());
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[32];
+  memset(name, 'x', sizeof(name));
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false),
+                  Field(TypeId::kTypeFloat, 1.0f * i)};
+    rows.emplace_back(fields);
+    if (rows.size() == 65536 || i == row_nums - 1) {
+      ASSERT_EQ(rows.size(), heap->BulkInsert(rows, nullptr));
+      rows.clear();
+    }
+  }
+  // select * from t where id < 1%
+  auto predicate = std::make_shared<ComparisonExpression>(
+      std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt),
+      std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt, row_nums / 100)), "<");
+  auto match = [&](Field result) { return result.CompareEquals(Field(TypeId::kTypeInt, 1)) == CmpBool::kTrue; };
+  // Scenario: filtering on the views matches the same rows as filtering materialized rows.
+  for (bool by_view : {false, true}) {
+    BufferRing ring;
+    std::vector<Row> matched;
+    if (by_view) {
+      ReadAheadTracker read_ahead;
+      for (page_id_t page_id = heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+        page_id = heap->ScanPage(
+            page_id,
+            [&](const RowView &view) {
+              if (match(predicate->Evaluate(&view))) {
+                matched.emplace_back();
+                view.ToRow(&matched.back());
+              }
+            },
+            &ring, &read_ahead);
+      }
+    } else {
+      for (auto it = heap->Begin(nullptr, &ring); it != heap->End(); ++it) {
+        if (match(predicate->Evaluate(&*it))) matched.push_back(*it);
+      }
+    }
+    ASSERT_EQ(row_nums / 100, matched.size());
+    for (int i = 0; i < row_nums / 100; i++) {
+      EXPECT_EQ(std::to_string(i), matched[i].GetField(0)->toString());
+    }
+  }
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, DISABLED_FilterBenchmark) {
+  const int row_nums = 300000;
+  auto disk_mgr_ = new DiskManager(std::make_unique<MemoryBackend>());
+  auto bpm_ = new BufferPoolManagerInstance(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char name[32];
+  memset(name, 'x', sizeof(name));
+  std::vector<Row> rows;
+  for (int i = 0; i < row_nums; i++) {
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, name, sizeof(name), false),
+                  Field(TypeId::kTypeFloat, 1.0f * i)};
+    rows.emplace_back(fields);
+    if (rows.size() == 65536 || i == row_nums - 1) {
+      ASSERT_EQ(rows.size(), heap->BulkInsert(rows, nullptr));
+      rows.clear();
+    }
+  }
+  // select * from t where id < 1%
+  auto predicate = std::make_shared<ComparisonExpression>(
+      std::make_shared<ColumnValueExpression>(0, 0, TypeId::kTypeInt),
+      std::make_shared<ConstantValueExpression>(Field(TypeId::kTypeInt, row_nums / 100)), "<");
+  auto match = [&](Field result) { return result.CompareEquals(Field(TypeId::kTypeInt, 1)) == CmpBool::kTrue; };
+  printf("%-12s %12s %12s\n", "filter", "rows/s", "ns/row");
+  for (bool by_view : {false, true}) {
+    BufferRing ring;
+    std::vector<Row> matched;
+    auto begin = std::chrono::steady_clock::now();
+    if (by_view) {
+      ReadAheadTracker read_ahead;
+      for (page_id_t page_id = heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+        page_id = heap->ScanPage(
+            page_id,
+            [&](const RowView &view) {
+              if (match(predicate->Evaluate(&view))) {
+                matched.emplace_back();
+                view.ToRow(&matched.back());
+              }
+            },
+            &ring, &read_ahead);
+      }
+    } else {
+      for (auto it = heap->Begin(nullptr, &ring); it != heap->End(); ++it) {
+        if (match(predicate->Evaluate(&*it))) matched.push_back(*it);
+      }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    ASSERT_EQ(row_nums / 100, matched.size());
+    printf("%-12s %12.0f %12.1f\n", by_view ? "row view" : "row", row_nums / elapsed.count(),
+           elapsed.count() * 1e9 / row_nums);
+  }
+  delete heap;
+  delete bpm_;
+  delete disk_mgr_;
+}